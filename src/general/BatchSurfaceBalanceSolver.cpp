@@ -0,0 +1,229 @@
+/**
+ * @file BatchSurfaceBalanceSolver.cpp
+ *
+ * @brief Implementation of the BatchSurfaceBalanceSolver class.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "BatchSurfaceBalanceSolver.h"
+#include "Mixture.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <thread>
+
+using namespace std;
+
+namespace Mutation {
+
+// Wall states are always exchanged as partial densities and temperatures
+static const int set_state_with_rhoi_T = 1;
+
+//==============================================================================
+
+BatchSurfaceBalanceSolver::BatchSurfaceBalanceSolver(
+    const MixtureOptions& options, int nthreads)
+{
+    if (nthreads < 1)
+        nthreads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Loading the mixture is not thread-safe, so build one Mixture object per
+    // thread here, serially
+    m_mixtures.reserve(nthreads);
+    try {
+        for (int i = 0; i < nthreads; ++i)
+            m_mixtures.push_back(new Mixture(options));
+    } catch (...) {
+        for (size_t i = 0; i < m_mixtures.size(); ++i)
+            delete m_mixtures[i];
+        throw;
+    }
+}
+
+//==============================================================================
+
+BatchSurfaceBalanceSolver::~BatchSurfaceBalanceSolver()
+{
+    for (size_t i = 0; i < m_mixtures.size(); ++i)
+        delete m_mixtures[i];
+}
+
+//==============================================================================
+
+int BatchSurfaceBalanceSolver::nSpecies() const
+{
+    return m_mixtures[0]->nSpecies();
+}
+
+//==============================================================================
+
+int BatchSurfaceBalanceSolver::nEnergyEqns() const
+{
+    return m_mixtures[0]->nEnergyEqns();
+}
+
+//==============================================================================
+
+void BatchSurfaceBalanceSolver::setIterationsSurfaceBalance(const int& iter)
+{
+    for (size_t i = 0; i < m_mixtures.size(); ++i)
+        m_mixtures[i]->setIterationsSurfaceBalance(iter);
+}
+
+//==============================================================================
+
+BatchSurfaceBalanceStats BatchSurfaceBalanceSolver::solveSurfaceBalance(
+    int nfaces, const double* const p_xi_edge, const double* const p_T_edge,
+    const double* const p_dx, double* const p_rhoi_wall,
+    double* const p_T_wall, double* const p_mdot, bool seed)
+{
+    const int ns = nSpecies();
+    const int nT = nEnergyEqns();
+    const int nthreads = std::min(nThreads(), std::max(nfaces, 1));
+
+    // Use a few chunks per thread so that the load is balanced when some faces
+    // are much harder to converge than others.  Each chunk is a contiguous
+    // range of faces so that most faces have their neighbour in the same chunk.
+    const int nchunks = std::min(nfaces, 4*nthreads);
+    std::atomic<int> next_chunk(0);
+
+    // When only the mass balance is solved, the wall temperatures are inputs
+    // of each face, which are never seeded, and there is no gas heat flux
+    const bool energy = m_mixtures[0]->solvesSurfaceEnergyBalance();
+
+    vector<BatchSurfaceBalanceStats> stats(nthreads);
+    vector<exception_ptr> errors(nthreads);
+
+    auto worker = [&](int t) {
+        Mixture& mix = *m_mixtures[t];
+        BatchSurfaceBalanceStats& s = stats[t];
+        s.n_faces = s.n_failed = s.n_seeded = 0;
+        s.failed.clear();
+
+        vector<double> rhoi(ns), T(nT);
+
+        try {
+            int c;
+            while ((c = next_chunk++) < nchunks) {
+                const int begin = static_cast<int>(
+                    static_cast<long>(c)*nfaces/nchunks);
+                const int end = static_cast<int>(
+                    static_cast<long>(c+1)*nfaces/nchunks);
+
+                // Whether rhoi and T hold the solution of the previous face
+                bool have_prev = false;
+
+                for (int k = begin; k < end; ++k) {
+                    double* const p_rhoi = p_rhoi_wall + k*ns;
+                    double* const p_T = p_T_wall + k*nT;
+                    s.n_faces++;
+
+                    // The given wall state sets the pressure of the face
+                    mix.setState(p_rhoi, p_T, set_state_with_rhoi_T);
+                    const double P = mix.P();
+
+                    if (seed && have_prev) {
+                        if (!energy)
+                            std::copy(p_T, p_T+nT, T.begin());
+
+                        // The pressure is linear in the partial densities at
+                        // fixed temperatures, so the previous solution only
+                        // needs to be rescaled
+                        mix.setState(
+                            rhoi.data(), T.data(), set_state_with_rhoi_T);
+                        const double scale = P / mix.P();
+                        for (int i = 0; i < ns; ++i)
+                            rhoi[i] *= scale;
+                        s.n_seeded++;
+                    } else {
+                        std::copy(p_rhoi, p_rhoi+ns, rhoi.begin());
+                        std::copy(p_T, p_T+nT, T.begin());
+                    }
+
+                    mix.setDiffusionModel(p_xi_edge + k*ns, p_dx[k]);
+                    if (energy)
+                        mix.setGasFourierHeatFluxModel(
+                            p_T_edge + k*nT, p_dx[k]);
+                    mix.setSurfaceState(
+                        rhoi.data(), T.data(), set_state_with_rhoi_T);
+                    mix.solveSurfaceBalance();
+                    mix.getSurfaceState(
+                        rhoi.data(), T.data(), set_state_with_rhoi_T);
+                    mix.getMassBlowingRate(p_mdot[k]);
+
+                    bool solved = mix.surfaceBalanceConverged() &&
+                        std::isfinite(p_mdot[k]);
+                    for (int i = 0; i < ns; ++i)
+                        solved = solved && std::isfinite(rhoi[i]);
+                    for (int i = 0; i < nT; ++i)
+                        solved = solved && std::isfinite(T[i]);
+
+                    // A failed face keeps its given state and does not seed
+                    // the next one
+                    have_prev = solved;
+                    if (solved) {
+                        std::copy(rhoi.begin(), rhoi.end(), p_rhoi);
+                        std::copy(T.begin(), T.end(), p_T);
+                    } else {
+                        p_mdot[k] = std::numeric_limits<double>::quiet_NaN();
+                        s.n_failed++;
+                        s.failed.push_back(k);
+                    }
+                }
+            }
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    // The calling thread does its share of the work as well
+    vector<std::thread> threads;
+    threads.reserve(nthreads-1);
+    for (int t = 1; t < nthreads; ++t)
+        threads.push_back(std::thread(worker, t));
+    worker(0);
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    for (int t = 0; t < nthreads; ++t)
+        if (errors[t]) std::rethrow_exception(errors[t]);
+
+    BatchSurfaceBalanceStats total = { 0, 0, 0 };
+    for (int t = 0; t < nthreads; ++t) {
+        total.n_faces  += stats[t].n_faces;
+        total.n_failed += stats[t].n_failed;
+        total.n_seeded += stats[t].n_seeded;
+        total.failed.insert(
+            total.failed.end(), stats[t].failed.begin(), stats[t].failed.end());
+    }
+    std::sort(total.failed.begin(), total.failed.end());
+
+    return total;
+}
+
+//==============================================================================
+
+} // namespace Mutation
@@ -0,0 +1,147 @@
+/**
+ * @file BatchSurfaceBalanceSolver.h
+ *
+ * @brief Provides the BatchSurfaceBalanceSolver class which solves the surface
+ * balances of many wall faces concurrently.
+ * @see Mutation::BatchSurfaceBalanceSolver
+ */
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MUTATION_BATCH_SURFACE_BALANCE_SOLVER_H
+#define MUTATION_BATCH_SURFACE_BALANCE_SOLVER_H
+
+#include <vector>
+
+namespace Mutation {
+
+class Mixture;
+class MixtureOptions;
+
+/**
+ * Statistics of a batch of surface balance solutions.
+ */
+struct BatchSurfaceBalanceStats
+{
+    int n_faces;  ///< number of faces in the batch
+    int n_failed; ///< number of faces for which the solver failed
+    int n_seeded; ///< number of faces started from their neighbour's solution
+    std::vector<int> failed; ///< indices of the failed faces, in order
+};
+
+/**
+ * @class BatchSurfaceBalanceSolver
+ * @brief Solves the gas-surface interaction balances of arrays of wall faces
+ * using several threads.
+ *
+ * Each thread owns its own Mixture object, and therefore its own
+ * GasSurfaceInteraction and surface balance solver, so that no state is shared
+ * between threads.  The faces are split into contiguous chunks in the order
+ * they are given, which the threads process in turn.  Faces which are
+ * neighbours in the arrays are usually neighbours on the wall as well, so
+ * every face of a chunk after the first one can be started from the solution
+ * of the previous face, rescaled to its own pressure.  When only the mass
+ * balance is solved, the wall temperatures of each face are kept.
+ *
+ * <b>Example usage:</b>
+ * @code
+ * BatchSurfaceBalanceSolver batch("seb_catalysis_NASA9_ChemNonEq1T");
+ * batch.solveSurfaceBalance(
+ *     nfaces, xi_edge, T_edge, dx, rhoi_wall, T_wall, mdot);
+ * @endcode
+ */
+class BatchSurfaceBalanceSolver
+{
+public:
+
+    /**
+     * Constructs the batch solver for the given mixture.  If nthreads is less
+     * than 1, the number of hardware threads is used.
+     */
+    BatchSurfaceBalanceSolver(const MixtureOptions& options, int nthreads = 0);
+
+    /**
+     * Destructor.
+     */
+    ~BatchSurfaceBalanceSolver();
+
+    /**
+     * Returns the number of threads (and Mixture instances) in use.
+     */
+    int nThreads() const { return static_cast<int>(m_mixtures.size()); }
+
+    /**
+     * Returns the number of species in each wall state.
+     */
+    int nSpecies() const;
+
+    /**
+     * Returns the number of temperatures in each wall state.
+     */
+    int nEnergyEqns() const;
+
+    /**
+     * Sets the maximum number of iterations of the surface balance solver of
+     * every thread.
+     * @see GasSurfaceInteraction::setIterationsSurfaceBalance()
+     */
+    void setIterationsSurfaceBalance(const int& iter);
+
+    /**
+     * Solves the surface balances of nfaces wall faces.  The wall states are
+     * given as partial densities and temperatures and set the pressure of each
+     * face, which the solution keeps.  Unless seeding is turned off, they are
+     * only used as initial guesses for the first face of each chunk, apart
+     * from the temperatures when they are not solved for.  A face for which
+     * the solver does not converge or returns a non-finite state keeps its
+     * given wall state, gets a NaN mass blowing rate, and is listed in the
+     * returned statistics; the next face then starts from its own given
+     * state.  Errors thrown by the solver are rethrown once all the threads
+     * have finished.
+     *
+     * @param nfaces      number of wall faces
+     * @param p_xi_edge   mole fractions away from the wall (nfaces x nSpecies)
+     * @param p_T_edge    temperatures away from the wall (nfaces x nEnergyEqns)
+     * @param p_dx        distances from the wall in m (nfaces)
+     * @param p_rhoi_wall wall partial densities in kg/m^3 (nfaces x nSpecies),
+     *                    on return the solution of the converged faces
+     * @param p_T_wall    wall temperatures in K (nfaces x nEnergyEqns), on
+     *                    return the solution of the converged faces
+     * @param p_mdot      on return, mass blowing rates in kg/(m^2-s) (nfaces)
+     * @param seed        if true, neighbouring faces seed each other's initial
+     *                    guesses
+     *
+     * @see GasSurfaceInteraction::solveSurfaceBalance()
+     */
+    BatchSurfaceBalanceStats solveSurfaceBalance(
+        int nfaces, const double* const p_xi_edge, const double* const p_T_edge,
+        const double* const p_dx, double* const p_rhoi_wall,
+        double* const p_T_wall, double* const p_mdot, bool seed = true);
+
+private:
+
+    std::vector<Mixture*> m_mixtures;
+};
+
+} // namespace Mutation
+
+#endif // MUTATION_BATCH_SURFACE_BALANCE_SOLVER_H
@@ -0,0 +1,361 @@
+/**
+ * @file EquilTransportTable.cpp
+ *
+ * @brief EquilTransportTable class implementation.
+ * @see Mutation::EquilTransportTable
+ */
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "EquilTransportTable.h"
+#include "Errors.h"
+#include "Mixture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+using namespace std;
+
+namespace Mutation {
+
+// Identifies (and versions) the binary table files
+static const char TABLE_MAGIC[8] = { 'M','P','P','E','Q','T','T','\0' };
+static const int TABLE_VERSION = 1;
+
+//==============================================================================
+
+/**
+ * Computes the derivative of f along the nodes x, at the given stride, with
+ * the three point formula for non-uniform spacing in the interior and the
+ * secants at the ends.
+ */
+static void nodeSlopes(
+    const vector<double>& x, const double* const f, double* const df,
+    const int stride)
+{
+    const int n = x.size();
+    df[0] = (f[stride] - f[0]) / (x[1] - x[0]);
+    df[(n-1)*stride] =
+        (f[(n-1)*stride] - f[(n-2)*stride]) / (x[n-1] - x[n-2]);
+
+    for (int i = 1; i < n-1; ++i) {
+        const double h0 = x[i] - x[i-1];
+        const double h1 = x[i+1] - x[i];
+        df[i*stride] =
+            h0 / (h1*(h0+h1)) * (f[(i+1)*stride] - f[i*stride]) +
+            h1 / (h0*(h0+h1)) * (f[i*stride] - f[(i-1)*stride]);
+    }
+}
+
+//==============================================================================
+
+/**
+ * Finds the interval i of the nodes x containing v, clipped to the table, and
+ * the normalized position t in [0, 1] of v in that interval.
+ */
+static void locate(const vector<double>& x, double v, int& i, double& t)
+{
+    const int n = x.size();
+    v = std::min(std::max(v, x[0]), x[n-1]);
+    i = std::upper_bound(x.begin(), x.end(), v) - x.begin() - 1;
+    i = std::min(i, n-2);
+    t = (v - x[i]) / (x[i+1] - x[i]);
+}
+
+//==============================================================================
+
+EquilTransportTable::EquilTransportTable(
+    Mixture& mix, double T1, double T2, double P1, double P2, double tol,
+    int nT, int nP, int passes, const double* const p_Xe)
+    : m_ne(mix.nElements()),
+      m_nprops(FLUX_FACTORS + (m_ne+1)*(m_ne+2)),
+      m_max_error(0.0)
+{
+    if (!(T1 > 0.0 && T2 > T1))
+        throw InvalidInputError("temperature range", T1) << " to " << T2;
+    if (!(P1 > 0.0 && P2 > P1))
+        throw InvalidInputError("pressure range", P1) << " to " << P2;
+    if (nT < 2) throw InvalidInputError("nT", nT);
+    if (nP < 2) throw InvalidInputError("nP", nP);
+
+    const double* const p_X = (p_Xe == NULL ? mix.getDefaultComposition() : p_Xe);
+    m_Xe.assign(p_X, p_X+m_ne);
+
+    for (int i = 0; i < nT; ++i)
+        m_T.push_back(T1 + (T2 - T1)*i/(nT-1));
+    for (int j = 0; j < nP; ++j)
+        m_lnP.push_back(std::log(P1) + std::log(P2/P1)*j/(nP-1));
+
+    // Every state is evaluated only once, the midpoints checked during one pass
+    // become the nodes of the next pass when their interval is split
+    map<pair<double, double>, vector<double> > states;
+    vector<double> Xe(m_Xe);
+    auto exact = [&](double T, double lnP) -> const vector<double>& {
+        vector<double>& f = states[make_pair(T, lnP)];
+        if (f.empty()) {
+            f.resize(m_nprops);
+            mix.equilibrate(T, std::exp(lnP), Xe.data());
+            f[VISCOSITY] = mix.viscosity();
+            f[THERMAL_CONDUCTIVITY] = mix.equilibriumThermalConductivity();
+            f[ELECTRIC_CONDUCTIVITY] = mix.electricConductivity();
+            mix.equilDiffFluxFacsP(&f[FLUX_FACTORS]);
+            mix.equilDiffFluxFacsT(&f[FLUX_FACTORS+m_ne+1]);
+            mix.equilDiffFluxFacsZ(&f[FLUX_FACTORS+2*(m_ne+1)]);
+        }
+        return f;
+    };
+
+    vector<double> scale(m_nprops), interp(m_nprops);
+    for (int pass = 0; ; ++pass) {
+        nT = m_T.size();
+        nP = m_lnP.size();
+        resize();
+
+        std::fill(scale.begin(), scale.end(), 0.0);
+        for (int i = 0; i < nT; ++i) {
+            for (int j = 0; j < nP; ++j) {
+                const vector<double>& f = exact(m_T[i], m_lnP[j]);
+                std::copy(f.begin(), f.end(), &m_f[(i*nP+j)*m_nprops]);
+                for (int k = 0; k < m_nprops; ++k)
+                    scale[k] = std::max(scale[k], 1.0e-3*std::abs(f[k]));
+            }
+        }
+        computeSlopes();
+
+        // Relative error of the interpolation at a midpoint
+        auto error = [&](double T, double lnP) {
+            const vector<double>& f = exact(T, lnP);
+            interpolateLog(T, lnP, 0, m_nprops, interp.data());
+            double err = 0.0;
+            for (int k = 0; k < m_nprops; ++k)
+                if (scale[k] > 0.0)
+                    err = std::max(err,
+                        std::abs(interp[k] - f[k]) / (std::abs(f[k]) + scale[k]));
+            m_max_error = std::max(m_max_error, err);
+            return err;
+        };
+
+        m_max_error = 0.0;
+        vector<bool> split_T(nT-1, false), split_P(nP-1, false);
+
+        // Midpoints of the edges along each axis
+        for (int i = 0; i < nT-1; ++i) {
+            const double Tm = 0.5*(m_T[i] + m_T[i+1]);
+            for (int j = 0; j < nP; ++j)
+                if (error(Tm, m_lnP[j]) > tol) split_T[i] = true;
+        }
+
+        for (int j = 0; j < nP-1; ++j) {
+            const double lnPm = 0.5*(m_lnP[j] + m_lnP[j+1]);
+            for (int i = 0; i < nT; ++i)
+                if (error(m_T[i], lnPm) > tol) split_P[j] = true;
+        }
+
+        // Cell centres, where the bicubic error is usually the largest, split
+        // the cell along both axes
+        for (int i = 0; i < nT-1; ++i) {
+            const double Tm = 0.5*(m_T[i] + m_T[i+1]);
+            for (int j = 0; j < nP-1; ++j) {
+                const double lnPm = 0.5*(m_lnP[j] + m_lnP[j+1]);
+                if (error(Tm, lnPm) > tol) split_T[i] = split_P[j] = true;
+            }
+        }
+
+        vector<double> T(1, m_T[0]), lnP(1, m_lnP[0]);
+        for (int i = 0; i < nT-1; ++i) {
+            if (split_T[i]) T.push_back(0.5*(m_T[i] + m_T[i+1]));
+            T.push_back(m_T[i+1]);
+        }
+        for (int j = 0; j < nP-1; ++j) {
+            if (split_P[j]) lnP.push_back(0.5*(m_lnP[j] + m_lnP[j+1]));
+            lnP.push_back(m_lnP[j+1]);
+        }
+
+        if (pass == passes ||
+            (T.size() == m_T.size() && lnP.size() == m_lnP.size()))
+            break;
+
+        m_T.swap(T);
+        m_lnP.swap(lnP);
+    }
+}
+
+//==============================================================================
+
+EquilTransportTable::EquilTransportTable(const string& file)
+{
+    ifstream in(file.c_str(), ios::in | ios::binary);
+    if (!in) throw FileNotFoundError(file);
+
+    char magic[8];
+    int version, nT, nP;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(int));
+
+    if (!in || std::memcmp(magic, TABLE_MAGIC, sizeof(magic)) != 0 ||
+        version != TABLE_VERSION)
+        throw FileParseError(file, 0)
+            << "Not an equilibrium transport table (version "
+            << TABLE_VERSION << ").";
+
+    in.read(reinterpret_cast<char*>(&nT), sizeof(int));
+    in.read(reinterpret_cast<char*>(&nP), sizeof(int));
+    in.read(reinterpret_cast<char*>(&m_ne), sizeof(int));
+    in.read(reinterpret_cast<char*>(&m_nprops), sizeof(int));
+    in.read(reinterpret_cast<char*>(&m_max_error), sizeof(double));
+
+    if (!in || nT < 2 || nP < 2 || m_ne < 1 ||
+        m_nprops != FLUX_FACTORS + (m_ne+1)*(m_ne+2))
+        throw FileParseError(file, 0) << "Invalid table dimensions.";
+
+    m_Xe.resize(m_ne);
+    m_T.resize(nT);
+    m_lnP.resize(nP);
+    resize();
+
+    in.read(reinterpret_cast<char*>(m_Xe.data()), m_ne*sizeof(double));
+    in.read(reinterpret_cast<char*>(m_T.data()), nT*sizeof(double));
+    in.read(reinterpret_cast<char*>(m_lnP.data()), nP*sizeof(double));
+    in.read(reinterpret_cast<char*>(m_f.data()), m_f.size()*sizeof(double));
+
+    if (!in) throw FileParseError(file, 0) << "Truncated table.";
+
+    computeSlopes();
+}
+
+//==============================================================================
+
+void EquilTransportTable::save(const string& file) const
+{
+    ofstream out(file.c_str(), ios::out | ios::binary);
+    if (!out) throw FileNotFoundError(file);
+
+    const int nT = m_T.size();
+    const int nP = m_lnP.size();
+
+    out.write(TABLE_MAGIC, sizeof(TABLE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&TABLE_VERSION), sizeof(int));
+    out.write(reinterpret_cast<const char*>(&nT), sizeof(int));
+    out.write(reinterpret_cast<const char*>(&nP), sizeof(int));
+    out.write(reinterpret_cast<const char*>(&m_ne), sizeof(int));
+    out.write(reinterpret_cast<const char*>(&m_nprops), sizeof(int));
+    out.write(reinterpret_cast<const char*>(&m_max_error), sizeof(double));
+    out.write(reinterpret_cast<const char*>(m_Xe.data()), m_ne*sizeof(double));
+    out.write(reinterpret_cast<const char*>(m_T.data()), nT*sizeof(double));
+    out.write(reinterpret_cast<const char*>(m_lnP.data()), nP*sizeof(double));
+    out.write(
+        reinterpret_cast<const char*>(m_f.data()), m_f.size()*sizeof(double));
+}
+
+//==============================================================================
+
+double EquilTransportTable::interpolate(double T, double P, int k) const
+{
+    double value;
+    interpolateLog(T, std::log(P), k, k+1, &value);
+    return value;
+}
+
+//==============================================================================
+
+void EquilTransportTable::interpolate(
+    double T, double P, int start, int end, double* const p_values) const
+{
+    interpolateLog(T, std::log(P), start, end, p_values);
+}
+
+//==============================================================================
+
+void EquilTransportTable::interpolateLog(
+    double T, double lnP, int start, int end, double* const p_values) const
+{
+    const int nP = m_lnP.size();
+
+    int i, j;
+    double t, u;
+    locate(m_T, T, i, t);
+    locate(m_lnP, lnP, j, u);
+
+    const double hT = m_T[i+1] - m_T[i];
+    const double hP = m_lnP[j+1] - m_lnP[j];
+
+    // Cubic Hermite basis functions for the values and the scaled slopes
+    const double ht[2] = { (1.0+2.0*t)*(1.0-t)*(1.0-t), t*t*(3.0-2.0*t) };
+    const double gt[2] = { t*(1.0-t)*(1.0-t)*hT, t*t*(t-1.0)*hT };
+    const double hu[2] = { (1.0+2.0*u)*(1.0-u)*(1.0-u), u*u*(3.0-2.0*u) };
+    const double gu[2] = { u*(1.0-u)*(1.0-u)*hP, u*u*(u-1.0)*hP };
+
+    for (int k = start; k < end; ++k)
+        p_values[k-start] = 0.0;
+
+    for (int a = 0; a < 2; ++a) {
+        for (int b = 0; b < 2; ++b) {
+            const int n = ((i+a)*nP + j+b)*m_nprops;
+            const double c0 = ht[a]*hu[b], c1 = gt[a]*hu[b];
+            const double c2 = ht[a]*gu[b], c3 = gt[a]*gu[b];
+            for (int k = start; k < end; ++k)
+                p_values[k-start] += c0*m_f[n+k] + c1*m_fT[n+k] +
+                    c2*m_fP[n+k] + c3*m_fTP[n+k];
+        }
+    }
+}
+
+//==============================================================================
+
+void EquilTransportTable::computeSlopes()
+{
+    const int nT = m_T.size();
+    const int nP = m_lnP.size();
+
+    // Temperature slopes along each column of constant pressure
+    for (int j = 0; j < nP; ++j)
+        for (int k = 0; k < m_nprops; ++k)
+            nodeSlopes(m_T, &m_f[j*m_nprops+k], &m_fT[j*m_nprops+k],
+                nP*m_nprops);
+
+    // Pressure slopes and cross derivatives along each row of constant T
+    for (int i = 0; i < nT; ++i) {
+        for (int k = 0; k < m_nprops; ++k) {
+            const int n = i*nP*m_nprops + k;
+            nodeSlopes(m_lnP, &m_f[n], &m_fP[n], m_nprops);
+            nodeSlopes(m_lnP, &m_fT[n], &m_fTP[n], m_nprops);
+        }
+    }
+}
+
+//==============================================================================
+
+void EquilTransportTable::resize()
+{
+    const size_t size = m_T.size()*m_lnP.size()*m_nprops;
+    m_f.resize(size);
+    m_fT.resize(size);
+    m_fP.resize(size);
+    m_fTP.resize(size);
+}
+
+//==============================================================================
+
+} // namespace Mutation
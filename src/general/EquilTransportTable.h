@@ -0,0 +1,223 @@
+/**
+ * @file EquilTransportTable.h
+ *
+ * @brief Provides the EquilTransportTable class which tabulates equilibrium
+ * transport properties in (T, log P). @see Mutation::EquilTransportTable
+ */
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MUTATION_EQUIL_TRANSPORT_TABLE_H
+#define MUTATION_EQUIL_TRANSPORT_TABLE_H
+
+#include <string>
+#include <vector>
+
+namespace Mutation {
+
+class Mixture;
+
+/**
+ * @class EquilTransportTable
+ * @brief Tabulates the transport properties of a mixture in thermochemical
+ * equilibrium at a fixed elemental composition, and interpolates them with a
+ * bicubic Hermite scheme in (T, log P).
+ *
+ * Each table node holds, in order, the viscosity, the equilibrium thermal
+ * conductivity (Transport::equilibriumThermalConductivity()), the electric
+ * conductivity and the elemental diffusion flux factors of
+ * Transport::equilDiffFluxFacsP(), Transport::equilDiffFluxFacsT() and
+ * Transport::equilDiffFluxFacsZ().  The slopes of the Hermite patches are
+ * obtained from finite differences of the tabulated values, so only the values
+ * are stored.
+ *
+ * The generator starts from a uniform grid and checks the interpolation error
+ * at the midpoint of every edge along each axis and at the centre of every
+ * cell.  Any interval in which the error of one of the properties exceeds the
+ * tolerance is split, a failing cell centre splitting the cell along both
+ * axes, and the check is repeated, up to a given number of passes.  The error
+ * of a property is measured relative to its magnitude plus 1e-3 times its
+ * largest magnitude in the table, so that properties which cross or approach
+ * zero, such as the flux factors or the electric conductivity of a weakly
+ * ionized gas, are measured on an absolute scale there.
+ *
+ * <b>Example usage:</b>
+ * @code
+ * // Generate the table once and save it
+ * Mixture mix("air_11");
+ * EquilTransportTable table(mix, 300.0, 15000.0, 100.0, 1.0e6, 1.0e-3);
+ * table.save("air_11.eqtt");
+ *
+ * // Load it in the flow solver
+ * EquilTransportTable lookup("air_11.eqtt");
+ * double mu = lookup.viscosity(T, P);
+ * @endcode
+ *
+ * @note Lookups outside of the tabulated range return the values at the
+ * nearest boundary of the table.
+ */
+class EquilTransportTable
+{
+public:
+
+    /**
+     * Generates the table for the given mixture.
+     *
+     * @param mix     the mixture used to compute the properties (its state is
+     *                changed)
+     * @param T1      lowest temperature in K
+     * @param T2      highest temperature in K
+     * @param P1      lowest pressure in Pa
+     * @param P2      highest pressure in Pa
+     * @param tol     relative interpolation error tolerance
+     * @param nT      initial number of temperatures
+     * @param nP      initial number of pressures
+     * @param passes  maximum number of refinement passes
+     * @param p_Xe    elemental mole fractions (mixture default if NULL)
+     */
+    EquilTransportTable(
+        Mixture& mix, double T1, double T2, double P1, double P2,
+        double tol = 1.0e-3, int nT = 16, int nP = 5, int passes = 8,
+        const double* const p_Xe = NULL);
+
+    /**
+     * Loads a table saved with save().
+     */
+    explicit EquilTransportTable(const std::string& file);
+
+    /**
+     * Saves the table to a binary file in the native byte order.  The file
+     * holds a header with the sizes, the maximum interpolation error, the
+     * elemental composition and the grid, followed by the node values.
+     */
+    void save(const std::string& file) const;
+
+    /// Number of elements of the mixture.
+    int nElements() const { return m_ne; }
+
+    /// Number of properties stored at each node.
+    int nProperties() const { return m_nprops; }
+
+    /// Tabulated temperatures in K.
+    const std::vector<double>& temperatures() const { return m_T; }
+
+    /// Logarithm of the tabulated pressures in Pa.
+    const std::vector<double>& logPressures() const { return m_lnP; }
+
+    /// Elemental mole fractions of the table.
+    const std::vector<double>& elementComposition() const { return m_Xe; }
+
+    /**
+     * Largest interpolation error found at the edge midpoints and cell
+     * centres during the last refinement pass.
+     */
+    double maxError() const { return m_max_error; }
+
+    /// Returns the mixture viscosity in Pa-s.
+    double viscosity(double T, double P) const {
+        return interpolate(T, P, VISCOSITY);
+    }
+
+    /// Returns the equilibrium thermal conductivity in W/m-K.
+    double thermalConductivity(double T, double P) const {
+        return interpolate(T, P, THERMAL_CONDUCTIVITY);
+    }
+
+    /// Returns the electric conductivity in S/m.
+    double electricConductivity(double T, double P) const {
+        return interpolate(T, P, ELECTRIC_CONDUCTIVITY);
+    }
+
+    /**
+     * Returns the pressure gradient flux factors (nElements+1 values).
+     * @see Transport::equilDiffFluxFacsP()
+     */
+    void diffFluxFacsP(double T, double P, double* const p_F) const {
+        interpolate(T, P, FLUX_FACTORS, FLUX_FACTORS+m_ne+1, p_F);
+    }
+
+    /**
+     * Returns the temperature gradient flux factors (nElements+1 values).
+     * @see Transport::equilDiffFluxFacsT()
+     */
+    void diffFluxFacsT(double T, double P, double* const p_F) const {
+        interpolate(T, P, FLUX_FACTORS+m_ne+1, FLUX_FACTORS+2*(m_ne+1), p_F);
+    }
+
+    /**
+     * Returns the elemental fraction gradient flux factors
+     * (nElements*(nElements+1) values).
+     * @see Transport::equilDiffFluxFacsZ()
+     */
+    void diffFluxFacsZ(double T, double P, double* const p_F) const {
+        interpolate(T, P, FLUX_FACTORS+2*(m_ne+1), m_nprops, p_F);
+    }
+
+    /**
+     * Interpolates the properties [start, end) at (T, P) into p_values.
+     */
+    void interpolate(
+        double T, double P, int start, int end, double* const p_values) const;
+
+private:
+
+    /// Position of the properties in a table node.
+    enum {
+        VISCOSITY = 0,
+        THERMAL_CONDUCTIVITY,
+        ELECTRIC_CONDUCTIVITY,
+        FLUX_FACTORS
+    };
+
+    /// Interpolates a single property.
+    double interpolate(double T, double P, int k) const;
+
+    /// Interpolates the properties [start, end) at (T, log P).
+    void interpolateLog(
+        double T, double lnP, int start, int end, double* const p_values) const;
+
+    /// Computes the slopes of the Hermite patches from the node values.
+    void computeSlopes();
+
+    /// Allocates the node arrays for the current grid.
+    void resize();
+
+private:
+
+    int m_ne;
+    int m_nprops;
+    double m_max_error;
+
+    std::vector<double> m_Xe;
+    std::vector<double> m_T;
+    std::vector<double> m_lnP;
+
+    // Values and slopes at each node, stored as [(i*nP + j)*nprops + k]
+    std::vector<double> m_f;
+    std::vector<double> m_fT;
+    std::vector<double> m_fP;
+    std::vector<double> m_fTP;
+};
+
+} // namespace Mutation
+
+#endif // MUTATION_EQUIL_TRANSPORT_TABLE_H
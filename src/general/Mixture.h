@@ -74,10 +74,22 @@ public:
     
     /**
      * Provides energy transfer source terms based on the current state of the
-     * mixture.
+     * mixture.  If the species production rates at the current state are
+     * already known, they can be given in p_wdot to avoid computing them again.
      */
-    void energyTransferSource(double* const p_source) {
-         state()->energyTransferSource(p_source);
+    void energyTransferSource(
+        double* const p_source, const double* const p_wdot = NULL) {
+         state()->energyTransferSource(p_source, p_wdot);
+    }
+
+    /**
+     * Provides the analytic Jacobian of the energy transfer source terms with
+     * respect to the species densities and the temperatures, based on the
+     * current state of the mixture.
+     * @see Thermodynamics::StateModel::energyTransferJacobian()
+     */
+    void energyTransferJacobian(double* const p_jac) {
+         state()->energyTransferJacobian(p_jac);
     }
 
     /**
@@ -44,7 +44,7 @@ using namespace Mutation::Utilities;
  * __Usage__:
  *
  *    bprime -T \f$T_1:\Delta T:T_2\f$ -p
- *    \f$p\f$ -b \f$B'_g\f$ -m mixture -bl BL -py Pyrolysis
+ *    \f$p\f$ -b \f$B'_g\f$ -m mixture -bl BL -py Pyrolysis [-nt N]
  *
  * This program generates a so-called "B-prime" table for a given temperature
  * range and stepsize in K, a fixed pressure in Pa, a value of \f$B'_g\f$
@@ -55,7 +55,9 @@ using namespace Mutation::Utilities;
  * [elemental compositions](@ref compositions) in the mixture file which
  * represent the boundary layer edge and pyrolysis gases respectively. The
  * produced table provides values of \f$B'_c\f$, the wall enthalpy in MJ/kg, and
- * the species mole fractions at the wall versus temperature.
+ * the species mole fractions at the wall versus temperature.  With `-nt N`,
+ * the table rows are computed concurrently on N threads (0 uses all available
+ * hardware threads).
  */
 // Simply stores the command line options
 typedef struct {
@@ -71,6 +73,8 @@ typedef struct {
     std::string pyrolysis_composition;
 
     bool pyrolysis_exist = false;
+
+    int nthreads = 1;
 } Options;
 
 // Checks if an option is present
@@ -113,6 +117,7 @@ void printHelpMessage(const char* const name)
     cout << tab << "-m                  mixture name" << endl;
     cout << tab << "-bl                 boundary layer edge composition name" << endl;
     cout << tab << "-py                 pyrolysis composition name (default = null)" << endl;
+    cout << tab << "-nt                 number of threads, 0 for all available (default = 1)" << endl;
 
 
     cout << endl;
@@ -240,6 +245,15 @@ Options parseOptions(int argc, char** argv)
         opts.pyrolysis_exist= true;
     }
 
+    if (optionExists(argc, argv, "-nt")) {
+        std::string nt = getOption(argc, argv, "-nt");
+        if (!String::isNumeric(nt)) {
+            cout << "Bad format for number of threads!" << endl;
+            printHelpMessage(argv[0]);
+        }
+        opts.nthreads = atoi(nt.c_str());
+    }
+
     return opts;
 }
 
@@ -281,11 +295,39 @@ int main(int argc, char* argv[])
         cout << setw(25) << "\"" + mix.speciesName(i) + "\"";
     cout << endl;
     
+    if (opts.nthreads == 1) {
+        for (double T = T1; T < T2 + 1.0e-6; T += dt) {
+            mix.surfaceMassBalance(Yke.data(), Ykg.data(), T, P, Bg, Bc, hw, Xw.data());
+            cout << setw(10) << T << setw(15) << Bc << setw(15) << hw / 1.0e6;
+            for (int i = 0; i < ns; ++i)
+                cout << setw(25) << Xw[i];
+            cout << endl;
+        }
+        return 0;
+    }
+
+    // Solve all the rows at once, then print them in order
+    std::vector<double> Tw, Pw;
     for (double T = T1; T < T2 + 1.0e-6; T += dt) {
-        mix.surfaceMassBalance(Yke.data(), Ykg.data(), T, P, Bg, Bc, hw, Xw.data());
-        cout << setw(10) << T << setw(15) << Bc << setw(15) << hw / 1.0e6;
+        Tw.push_back(T);
+        Pw.push_back(P);
+    }
+
+    const int nT = Tw.size();
+    std::vector<double> Bcw(nT), hww(nT), Xws(nT*ns);
+
+    MixtureOptions mix_opts(opts.mixture);
+    BatchEquilSolver batch(
+        mix_opts.getSpeciesDescriptor(), mix_opts.getThermodynamicDatabase(),
+        opts.nthreads);
+    batch.surfaceMassBalance(
+        nT, Yke.data(), Ykg.data(), Tw.data(), Pw.data(), Bg, Bcw.data(),
+        hww.data(), Xws.data());
+
+    for (int k = 0; k < nT; ++k) {
+        cout << setw(10) << Tw[k] << setw(15) << Bcw[k] << setw(15) << hww[k] / 1.0e6;
         for (int i = 0; i < ns; ++i)
-            cout << setw(25) << Xw[i];
+            cout << setw(25) << Xws[k*ns+i];
         cout << endl;
     }
 
@@ -29,6 +29,8 @@
 #define GENERAL_MUTATIONPP_H
 
 #include "Mixture.h"
+#include "EquilTransportTable.h"
+#include "BatchSurfaceBalanceSolver.h"
 #include "Kinetics.h"
 #include "RateLaws.h"
 #include "RateManager.h"
@@ -39,6 +41,7 @@
 #include "SpeciesNameFSM.h"
 #include "ThermoDB.h"
 #include "Thermodynamics.h"
+#include "BatchEquilSolver.h"
 #include "CollisionDB.h"
 #include "Constants.h"
 #include "Transport.h"
@@ -90,5 +90,27 @@ void DiffusionVelocityCalculator::computeDiffusionVelocities(
         electric_field);
 }
 
+//==============================================================================
+
+void DiffusionVelocityCalculator::computeDiffusionVelocitiesJacobian(
+    const VectorXd& v_mole_frac,
+    MatrixXd& m_dvdx)
+{
+    if (!m_is_diff_set) {
+    	throw LogicError()
+        << "Calling DiffusionVelocityCalculator::"
+        << "computeDiffusionVelocitiesJacobian() before calling "
+        << "DiffusionVelocityCalculator::setDiffusionCalculator().";
+    }
+    mv_dxidx = (v_mole_frac - mv_mole_frac_edge)/m_dx;
+
+    const int ns = mv_dxidx.size();
+    m_dvdd.resize(ns, ns);
+    m_dvdx.resize(ns, ns);
+    m_transport.stefanMaxwellJacobian(
+        mv_dxidx.data(), m_dvdd.data(), m_dvdx.data());
+    m_dvdx += m_dvdd / m_dx;
+}
+
     } // namespace GasSurfaceInteraction
 } // namespace Mutation
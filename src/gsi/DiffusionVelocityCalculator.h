@@ -84,11 +84,26 @@ public:
         const Eigen::VectorXd& v_mole_frac,
         Eigen::VectorXd& v_diff_velocities);
 
+//==============================================================================
+    /*
+     * Function used to compute the Jacobian of the diffusion velocities with
+     * respect to the mole fractions on the surface, through both the mole
+     * fraction gradients and the Stefan-Maxwell system.  The state of the
+     * mixture should correspond to the given mole fractions.
+     *
+     * @param mole_frac mole fractions of the species on the surface
+     * @param on return the Jacobian in m/s per unit mole fraction
+     */
+    void computeDiffusionVelocitiesJacobian(
+        const Eigen::VectorXd& v_mole_frac,
+        Eigen::MatrixXd& m_dvdx);
+
 private:
     Mutation::Transport::Transport& m_transport;
 
     Eigen::VectorXd mv_mole_frac_edge;
     Eigen::VectorXd mv_dxidx;
+    Eigen::MatrixXd m_dvdd;
 
     double m_dx;
     bool m_is_diff_set;
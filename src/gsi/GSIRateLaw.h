@@ -99,6 +99,22 @@ public:
         const Eigen::VectorXd& v_rhoi,
         const Eigen::VectorXd& v_Twall) const = 0;
 
+    /**
+     * Purely virtual function which computes the derivatives of the value
+     * returned by forwardReactionRateCoefficient() with respect to the
+     * species densities at the wall, at constant wall temperature.
+     *
+     * @param rhoi      species densities at the wall in kg/m^3
+     * @param Twall     wall temperature at the wall according to the
+     *                  state model in K
+     * @param dkdrhoi   on return, the derivatives with respect to each
+     *                  species density
+     */
+    virtual void forwardReactionRateCoefficientJacobian(
+        const Eigen::VectorXd& v_rhoi,
+        const Eigen::VectorXd& v_Twall,
+        Eigen::VectorXd& v_dkdrhoi) const = 0;
+
 protected:
     Mutation::Thermodynamics::Thermodynamics& m_thermo;
     const Mutation::Transport::Transport& m_transport;
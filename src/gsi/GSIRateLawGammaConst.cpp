@@ -114,6 +114,33 @@ public:
         return getLimitingImpingingMassFlux();
     }
 
+//==============================================================================
+
+    void forwardReactionRateCoefficientJacobian(
+        const VectorXd& v_rhoi, const VectorXd& v_Twall,
+        VectorXd& v_dkdrhoi) const
+    {
+        // Only the limiting reactant contributes, linearly in its density
+        forwardReactionRateCoefficient(v_rhoi, v_Twall);
+        const int i_lim = min_element(
+            mv_imp_flux_per_stoich_coef.begin(),
+            mv_imp_flux_per_stoich_coef.end()) -
+            mv_imp_flux_per_stoich_coef.begin();
+
+        int idx_react = 0;
+        for (int i_g = 0; i_g < i_lim; i_g++) {
+            getSpeciesIndexandStoichiometricCoefficient(
+                idx_react, m_idx_sp, m_stoich_coef);
+            idx_react += m_stoich_coef;
+        }
+        getSpeciesIndexandStoichiometricCoefficient(
+            idx_react, m_idx_sp, m_stoich_coef);
+
+        v_dkdrhoi.setZero();
+        v_dkdrhoi(m_idx_sp) = m_transport.speciesThermalSpeed(m_idx_sp) / 4.
+            / m_thermo.speciesMw(m_idx_sp) / m_stoich_coef * mv_gamma[i_lim];
+    }
+
 private:
     mutable int m_idx_react;
     mutable int m_idx_sp;
@@ -83,6 +83,26 @@ public:
                 mv_react[idx_react])*v_rhoi(mv_react[idx_react]);
     }
 
+//==============================================================================
+
+    void forwardReactionRateCoefficientJacobian(
+        const Eigen::VectorXd& v_rhoi, const Eigen::VectorXd& v_Twall,
+        Eigen::VectorXd& v_dkdrhoi) const
+    {
+        double Twall = v_Twall(pos_T_trans);
+
+        const int set_state_with_rhoi_T = 1;
+        m_thermo.setState(
+            v_rhoi.data(), v_Twall.data(), set_state_with_rhoi_T);
+        double m_sp_thermal_speed = m_transport.speciesThermalSpeed(
+                                        mv_react[idx_react]);
+
+        v_dkdrhoi.setZero();
+        v_dkdrhoi(mv_react[idx_react]) = m_sp_thermal_speed/4.
+                * m_pre_exp * std::exp(- m_activ_en/Twall)
+                / m_thermo.speciesMw(mv_react[idx_react]);
+    }
+
 private:
     const size_t pos_T_trans;
     const size_t idx_react;
@@ -89,6 +89,24 @@ public:
                    / m_thermo.speciesMw(mv_prod[idx_gas_prod]);
     }
 
+//==============================================================================
+
+    void forwardReactionRateCoefficientJacobian(
+        const VectorXd& v_rhoi, const VectorXd& v_Twall,
+        VectorXd& v_dkdrhoi) const
+    {
+        m_thermo.setState(
+            v_rhoi.data(), v_Twall.data(), set_state_with_rhoi_T);
+
+        double sp_thermal_speed = m_transport.speciesThermalSpeed(
+                                      mv_prod[idx_gas_prod]);
+
+        // The saturated vapor density only depends on the wall temperature
+        v_dkdrhoi.setZero();
+        v_dkdrhoi(mv_prod[idx_gas_prod]) = -m_vap_coef*sp_thermal_speed/4.
+                   / m_thermo.speciesMw(mv_prod[idx_gas_prod]);
+    }
+
 private:
     const size_t pos_T_trans;
     const size_t idx_gas_prod;
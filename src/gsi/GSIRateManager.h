@@ -107,6 +107,16 @@ public:
      */
     virtual Eigen::VectorXd computeRatesPerReaction() = 0;
 
+//==============================================================================
+    /**
+     * This purely virtual function computes the Jacobian of the surface
+     * reaction rates returned by computeRates() with respect to the species
+     * densities at the wall, at constant wall temperature.
+     *
+     * @param m_jac on return, the ns x ns Jacobian in kg/m^2-s per kg/m^3
+     */
+    virtual void computeRatesJacobian(Eigen::MatrixXd& m_jac) = 0;
+
 //==============================================================================
     /**
      * Purely virtual function which return the number of surface reactions.
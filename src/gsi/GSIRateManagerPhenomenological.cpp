@@ -54,7 +54,9 @@ public:
 		  m_ns(args.s_thermo.nSpecies()),
 		  m_nr(args.s_reactions.size()),
           mv_react_rate_const(m_nr),
-		  mv_work(m_ns)
+		  mv_work(m_ns),
+          mv_dkdrhoi(m_ns),
+          m_dkdrhoi(m_nr, m_ns)
     {
         for (int i_reac = 0; i_reac < m_nr; ++i_reac) {
             m_reactants.addReaction(
@@ -106,6 +108,31 @@ public:
         return mv_react_rate_const;
     }
 
+//=============================================================================
+
+    void computeRatesJacobian(Eigen::MatrixXd& m_jac)
+    {
+        // Derivatives of the rate constants with respect to the densities
+        for (int i_r = 0; i_r < m_nr; ++i_r) {
+            v_reactions[i_r]->getRateLaw()->
+                forwardReactionRateCoefficientJacobian(
+                    m_surf_state.getSurfaceRhoi(),
+                    m_surf_state.getSurfaceT(),
+                    mv_dkdrhoi);
+            m_dkdrhoi.row(i_r) = mv_dkdrhoi.transpose();
+        }
+
+        // Apply the stoichiometry to every column as in computeRates()
+        m_jac.resize(m_ns, m_ns);
+        for (int j = 0; j < m_ns; ++j) {
+            mv_react_rate_const = m_dkdrhoi.col(j);
+            mv_work.setZero();
+            m_reactants.incrSpecies(mv_react_rate_const, mv_work);
+            m_irr_products.decrSpecies(mv_react_rate_const, mv_work);
+            m_jac.col(j) = mv_work.cwiseProduct(m_thermo.speciesMw().matrix());
+        }
+    }
+
 
 //=============================================================================
 
@@ -118,6 +145,8 @@ private:
 
     Eigen::VectorXd mv_react_rate_const;
     Eigen::VectorXd mv_work;
+    Eigen::VectorXd mv_dkdrhoi;
+    Eigen::MatrixXd m_dkdrhoi;
 
     GSIStoichiometryManager m_reactants;
     GSIStoichiometryManager m_irr_products;
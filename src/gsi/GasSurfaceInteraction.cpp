@@ -210,6 +210,31 @@ void GasSurfaceInteraction::setIterationsSurfaceBalance(const int& iter)
 
 //==============================================================================
 
+bool GasSurfaceInteraction::surfaceBalanceConverged() const
+{
+    return mp_surf->surfaceBalanceConverged();
+}
+
+//==============================================================================
+
+void GasSurfaceInteraction::surfaceBalanceJacobian(double* const p_jac)
+{
+    const int neq = m_thermo.nSpecies() +
+        (mp_surf->solvesEnergyBalance() ? 1 : 0);
+    MatrixXd m_jac(neq, neq);
+    mp_surf->surfaceBalanceJacobian(m_jac);
+    Map<MatrixXd>(p_jac, neq, neq) = m_jac;
+}
+
+//==============================================================================
+
+bool GasSurfaceInteraction::solvesSurfaceEnergyBalance() const
+{
+    return mp_surf->solvesEnergyBalance();
+}
+
+//==============================================================================
+
 void GasSurfaceInteraction::getMassBlowingRate(double& mdot){
     mdot = mp_surf->massBlowingRate();
 }
@@ -172,6 +172,30 @@ public:
      */
     void setIterationsSurfaceBalance(const int& iter);
 
+    /**
+     * Returns true if the last call to solveSurfaceBalance() converged within
+     * the allowed number of iterations to a wall state close to the pressure
+     * of the initial surface state.
+     */
+    bool surfaceBalanceConverged() const;
+
+    /**
+     * Computes the Jacobian of the surface balance residuals at the current
+     * surface state, with respect to the wall mole fractions followed by the
+     * wall temperature when the energy balance is solved.  The Jacobian is
+     * returned in column-major order.
+     *
+     * @param p_jac  on return, the Jacobian of size ns x ns, or
+     *               (ns+1) x (ns+1) with the energy balance
+     */
+    void surfaceBalanceJacobian(double* const p_jac);
+
+    /**
+     * Returns true if the surface balance solves for the surface temperatures
+     * as well, false if they are imposed by the surface state.
+     */
+    bool solvesSurfaceEnergyBalance() const;
+
     /**
      * Function which return the total mass blowing flux.
      *
@@ -83,6 +83,14 @@ public:
      */
     virtual double computeBlowingFlux(
         const Eigen::VectorXd& v_chem_rates) = 0;
+
+    /**
+     * Purely virtual function which computes the derivatives of the blowing
+     * flux with respect to the species densities, given the Jacobian of the
+     * chemical production rates with respect to the same densities.
+     */
+    virtual void computeBlowingFluxJacobian(
+        const Eigen::MatrixXd& m_chem_rates_jac, Eigen::VectorXd& v_jac) = 0;
 };
 
     } // namespace GasSurfaceInteraction
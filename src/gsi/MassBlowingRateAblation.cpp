@@ -80,6 +80,16 @@ public:
         return v_chem_rates.sum();
     }
 
+//==============================================================================
+    /**
+     * This function returns the derivatives of the mass blowing flux as the
+     * sum of the derivatives of the heterogeneous reactions production rates.
+     */
+    void computeBlowingFluxJacobian(
+        const Eigen::MatrixXd& m_chem_rates_jac, Eigen::VectorXd& v_jac){
+        v_jac = m_chem_rates_jac.colwise().sum().transpose();
+    }
+
 private:
     const SurfaceChemistry& m_surf_chem;
 
@@ -65,6 +65,15 @@ public:
     double computeBlowingFlux(const Eigen::VectorXd& v_chem_rates){
 		return 0.;
 	}
+
+//==============================================================================
+	/**
+	 * Returns zero derivatives of the mass blowing flux.
+	 */
+    void computeBlowingFluxJacobian(
+        const Eigen::MatrixXd& m_chem_rates_jac, Eigen::VectorXd& v_jac){
+        v_jac.setZero(m_chem_rates_jac.cols());
+    }
 };
 
 ObjectProvider<
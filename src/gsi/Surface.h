@@ -185,6 +185,43 @@ public:
         << "the surface energy balance!";
     }
 
+//==============================================================================
+
+    /**
+     * Virtual function returning true if the last surface balance reached
+     * its tolerance within the allowed iterations with wall mole fractions
+     * still summing to one.
+     */
+    virtual bool surfaceBalanceConverged() const
+    {
+        throw LogicError()
+        << "surfaceBalanceConverged can be called only when solving "
+        << "the surface energy balance!";
+    }
+
+//==============================================================================
+
+    /**
+     * Virtual function which computes the Jacobian of the surface balance
+     * residuals with respect to the wall mole fractions, followed by the wall
+     * temperature when the energy balance is solved, at the current surface
+     * state.
+     */
+    virtual void surfaceBalanceJacobian(Eigen::MatrixXd& m_jac)
+    {
+        throw LogicError()
+        << "surfaceBalanceJacobian can be called only when solving "
+        << "the surface balance!";
+    }
+
+//==============================================================================
+
+    /**
+     * Returns true if the surface temperatures are unknowns of the surface
+     * balance, false if they are imposed by the surface state.
+     */
+    virtual bool solvesEnergyBalance() const { return false; }
+
 //==============================================================================
 
     /**
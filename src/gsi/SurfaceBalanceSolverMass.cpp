@@ -64,11 +64,16 @@ public:
           mv_X(m_ns),
           mv_dX(m_ns),
           mv_f(m_ns),
-          mv_f_unpert(m_ns),
+          mv_Vdiff(m_ns),
           m_jac(m_ns, m_ns),
+          m_jac_lag(5),
+          m_jac_refresh_ratio(1.e-2),
           m_tol(1.e-13),
-          m_pert(1.e-2),
-          mv_X_unpert(m_ns),
+          m_tol_xsum(1.e-3),
+          mv_drhoidx(m_ns),
+          m_dvdx(m_ns, m_ns),
+          m_drates(m_ns, m_ns),
+          mv_dmblow(m_ns),
           pos_T_trans(0),
           set_state_with_rhoi_T(1),
           mv_surf_reac_rates(m_ns)
@@ -95,6 +100,8 @@ public:
 
         // Setup NewtonSolver
         setMaxIterations(5);
+        setJacobianLag(m_jac_lag);
+        setJacobianRefreshRatio(m_jac_refresh_ratio);
         setWriteConvergenceHistory(false);
         setEpsilon(m_tol);
     }
@@ -187,6 +194,36 @@ public:
 
     void setIterationsSurfaceBalance(const int& iter){ setMaxIterations(iter); }
 
+//==============================================================================
+
+    bool surfaceBalanceConverged() const
+    {
+        // The Newton iterations stop on the size of the step, which also
+        // becomes small when they diverge, so a converged solution must
+        // also stay close to the wall pressure
+        return converged() &&
+            std::abs(mv_X.head(m_ns).sum() - 1.) < m_tol_xsum;
+    }
+
+//==============================================================================
+
+    void surfaceBalanceJacobian(Eigen::MatrixXd& m_jac_out)
+    {
+        errorSurfaceStateNotSet();
+
+        // Balance at the surface state and its pressure
+        mv_rhoi = m_surf_state.getSurfaceRhoi();
+        mv_Tsurf = m_surf_state.getSurfaceT();
+        saveUnperturbedPressure(mv_rhoi);
+
+        Eigen::VectorXd v_X(m_ns);
+        computeMoleFracfromPartialDens(mv_rhoi, v_X);
+
+        updateFunction(v_X);
+        updateJacobian(v_X);
+        m_jac_out = m_jac;
+    }
+
 //==============================================================================
 
     double massBlowingRate() {
@@ -208,9 +245,9 @@ public:
             mv_rhoi.data(), mv_Tsurf.data(), set_state_with_rhoi_T);
 
         // Diffusion Fluxes
-        mp_diff_vel_calc->computeDiffusionVelocities(v_mole_frac, mv_f);
-        applyTolerance(mv_f);
-        mv_f = mv_rhoi.cwiseProduct(mv_f);
+        mp_diff_vel_calc->computeDiffusionVelocities(v_mole_frac, mv_Vdiff);
+        applyTolerance(mv_Vdiff);
+        mv_f = mv_rhoi.cwiseProduct(mv_Vdiff);
 
         // Chemical Production Rates
         computeSurfaceReactionRates(mv_surf_reac_rates);
@@ -226,29 +263,45 @@ public:
 
     void updateJacobian(Eigen::VectorXd& v_mole_frac)
     {
-        mv_f_unpert = mv_f;
-        for (int i_ns = 0 ; i_ns < m_ns ; i_ns++){
-            mv_X_unpert = v_mole_frac;
-            double pert = m_pert;
-            v_mole_frac(i_ns) += pert;
+        // The state was set by updateFunction() at the same mole fractions.
+        // The partial densities are proportional to the mole fractions.
+        mv_drhoidx = m_thermo.speciesMw().matrix() *
+            m_Psurf / (mv_Tsurf(pos_T_trans) * RU);
+
+        // Diffusion fluxes
+        mp_diff_vel_calc->computeDiffusionVelocitiesJacobian(
+            v_mole_frac, m_dvdx);
+        m_jac = mv_rhoi.asDiagonal() * m_dvdx;
+        m_jac.diagonal() += mv_drhoidx.cwiseProduct(mv_Vdiff);
+
+        // Chemical production rates and blowing fluxes, with respect to the
+        // partial densities first
+        m_drates.setZero();
+        if (mp_surf_chem != NULL)
+            mp_surf_chem->surfaceReactionRatesJacobian(m_drates);
+        mp_mass_blowing_rate->computeBlowingFluxJacobian(m_drates, mv_dmblow);
 
-            updateFunction(v_mole_frac);
+        const double rho = mv_rhoi.sum();
+        const double mass_blow = mp_mass_blowing_rate->computeBlowingFlux(
+            mv_surf_reac_rates);
 
-            // Update Jacobian column
-            m_jac.col(i_ns) = (mv_f - mv_f_unpert) / pert;
+        m_drates *= -1.;
+        m_drates += (mv_rhoi / rho) *
+            (mv_dmblow.array() - mass_blow / rho).matrix().transpose();
+        m_drates.diagonal().array() += mass_blow / rho;
 
-            // Unperturbed mole fractions
-            v_mole_frac = mv_X_unpert;
-        }
+        m_jac += m_drates * mv_drhoidx.asDiagonal();
+
+        // Factorize once for this and the lagged iterations
+        double a = (m_jac.diagonal()).cwiseAbs().maxCoeff();
+        m_jac_lu.compute(m_jac + a*Eigen::MatrixXd::Ones(m_ns,m_ns));
     }
 
 //==============================================================================
 
     Eigen::VectorXd& systemSolution()
     {
-        double a = (m_jac.diagonal()).cwiseAbs().maxCoeff();
-        mv_dX = (m_jac + a*Eigen::MatrixXd::Ones(m_ns,m_ns)).
-            fullPivLu().solve(mv_f_unpert);
+        mv_dX = m_jac_lu.solve(mv_f);
 
         applyTolerance(mv_dX);
         return mv_dX;
@@ -318,11 +371,17 @@ private:
     Eigen::VectorXd mv_X;
     Eigen::VectorXd mv_dX;
     Eigen::VectorXd mv_f;
+    Eigen::VectorXd mv_Vdiff;
     Eigen::MatrixXd m_jac;
+    Eigen::FullPivLU<Eigen::MatrixXd> m_jac_lu;
+    const int m_jac_lag;
+    const double m_jac_refresh_ratio;
     const double m_tol;
-    double m_pert;
-    Eigen::VectorXd mv_X_unpert;
-    Eigen::VectorXd mv_f_unpert;
+    const double m_tol_xsum;
+    Eigen::VectorXd mv_drhoidx;
+    Eigen::MatrixXd m_dvdx;
+    Eigen::MatrixXd m_drates;
+    Eigen::VectorXd mv_dmblow;
     Eigen::VectorXd mv_surf_reac_rates;
 
 
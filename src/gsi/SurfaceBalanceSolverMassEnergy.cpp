@@ -74,9 +74,17 @@ public:
           mv_f(m_neqns),
           mv_f_unpert(m_neqns),
           m_jac(m_neqns, m_neqns),
+          m_jac_lag(5),
+          m_jac_refresh_ratio(1.e-2),
           m_tol(1.e-12),
-          m_pert_m(1.e-2),
+          m_tol_xsum(1.e-3),
           m_pert_T(1.e0),
+          m_pert_x(1.e-6),
+          mv_drhoidx(m_ns),
+          m_dvdx(m_ns, m_ns),
+          m_drates(m_ns, m_ns),
+          mv_dmblow(m_ns),
+          mv_rhoi_pert(m_ns),
           pos_E(m_ns),
           pos_T_trans(0),
           m_phi(m_surf_state.solidProps().getPhiRatio()),
@@ -121,6 +129,8 @@ public:
 
         // Setup NewtonSolver
         setMaxIterations(5);
+        setJacobianLag(m_jac_lag);
+        setJacobianRefreshRatio(m_jac_refresh_ratio);
         setWriteConvergenceHistory(false);
         setEpsilon(m_tol);
     }
@@ -230,6 +240,45 @@ public:
 
     void setIterationsSurfaceBalance(const int& iter){ setMaxIterations(iter); }
 
+//==============================================================================
+
+    bool surfaceBalanceConverged() const
+    {
+        // The Newton iterations stop on the size of the step, which also
+        // becomes small when they diverge, so a converged solution must
+        // also stay close to the wall pressure
+        return converged() &&
+            std::abs(mv_X.head(m_ns).sum() - 1.) < m_tol_xsum;
+    }
+
+//==============================================================================
+
+    bool solvesEnergyBalance() const { return true; }
+
+//==============================================================================
+
+    void surfaceBalanceJacobian(Eigen::MatrixXd& m_jac_out)
+    {
+        errorSurfaceStateNotSet();
+
+        // Balance at the surface state and its pressure
+        mv_rhoi = m_surf_state.getSurfaceRhoi();
+        Eigen::VectorXd v_X(m_ns_T);
+        v_X.tail(m_nT) = m_surf_state.getSurfaceT();
+        if (is_surf_in_thermal_eq)
+            v_X.tail(m_nT-1).setConstant(v_X(pos_E));
+
+        saveUnperturbedPressure(mv_rhoi, v_X.tail(m_nT));
+        computeMoleFracfromPartialDens(mv_rhoi, v_X.tail(m_nT), v_X);
+
+        updateFunction(v_X);
+        updateJacobian(v_X);
+        m_jac_out = m_jac;
+
+        // The temperature column leaves the perturbed state behind
+        updateFunction(v_X);
+    }
+
 //==============================================================================
 
     double massBlowingRate()
@@ -292,23 +341,59 @@ public:
 
     void updateJacobian(Eigen::VectorXd& v_X)
     {
-        // Perturbing Mass
-        mv_f_unpert = mv_f;
-        for (int i_ns = 0; i_ns < m_ns; i_ns++){
-            double X_unpert = v_X(i_ns);
-            double pert = m_pert_m;
-            v_X(i_ns) += pert;
+        // The state was set by updateFunction() at the same solution vector.
+        // The partial densities are proportional to the mole fractions.
+        mv_drhoidx = m_thermo.speciesMw().matrix() *
+            m_Psurf / (v_X(pos_E) * RU);
+
+        // Diffusion fluxes
+        mp_diff_vel_calc->computeDiffusionVelocitiesJacobian(
+            v_X.head(m_ns), m_dvdx);
+        m_jac.topLeftCorner(m_ns, m_ns) = mv_rhoi.asDiagonal() * m_dvdx;
+        m_jac.topLeftCorner(m_ns, m_ns).diagonal() +=
+            mv_drhoidx.cwiseProduct(mv_Vdiff);
+        m_jac.row(pos_E).head(m_ns) =
+            mv_hi.head(m_ns).transpose() * m_jac.topLeftCorner(m_ns, m_ns);
+
+        // Chemical production rates and blowing fluxes, with respect to the
+        // partial densities first
+        m_drates.setZero();
+        if (mp_surf_chem != NULL)
+            mp_surf_chem->surfaceReactionRatesJacobian(m_drates);
+        mp_mass_blowing_rate->computeBlowingFluxJacobian(m_drates, mv_dmblow);
 
-            updateFunction(v_X);
+        const double rho = mv_rhoi.sum();
+        const double mass_blow = mp_mass_blowing_rate->computeBlowingFlux(
+            mv_surf_reac_rates);
+        const double hmix = mv_hi.head(m_ns).dot(mv_rhoi) / rho;
+
+        m_jac.row(pos_E).head(m_ns) += (
+            hmix*mv_dmblow.transpose() + mass_blow/rho *
+            (mv_hi.head(m_ns).transpose().array() - hmix).matrix()
+            ).cwiseProduct(mv_drhoidx.transpose());
 
-            // Update Jacobian column
-            m_jac.col(i_ns) = (mv_f-mv_f_unpert) / pert;
+        m_drates *= -1.;
+        m_drates += (mv_rhoi / rho) *
+            (mv_dmblow.array() - mass_blow / rho).matrix().transpose();
+        m_drates.diagonal().array() += mass_blow / rho;
 
-            // Unperturb mole fractions
-            v_X(i_ns) = X_unpert;
+        m_jac.topLeftCorner(m_ns, m_ns) += m_drates * mv_drhoidx.asDiagonal();
+
+        // Heat conduction, through the dependence of the thermal conductivity
+        // on the composition
+        const double q_cond =
+            mp_gas_heat_flux_calc->computeGasFourierHeatFlux(v_X.tail(m_nT));
+        for (int i = 0; i < m_ns; ++i) {
+            mv_rhoi_pert = mv_rhoi;
+            mv_rhoi_pert(i) += m_pert_x*mv_drhoidx(i);
+            m_thermo.setState(mv_rhoi_pert.data(), v_X.tail(m_nT).data(),
+                set_state_with_rhoi_T);
+            m_jac(pos_E, i) += (mp_gas_heat_flux_calc->
+                computeGasFourierHeatFlux(v_X.tail(m_nT)) - q_cond) / m_pert_x;
         }
 
         // Perturbing Energy
+        mv_f_unpert = mv_f;
         double T_pert = m_pert_T;
         double X_unpert = v_X(pos_E);
         v_X(pos_E) += T_pert;
@@ -321,15 +406,20 @@ public:
         v_X(pos_E) = X_unpert;
         if (is_surf_in_thermal_eq)
             v_X.tail(m_nT-1).setConstant(v_X(pos_E));
+        mv_f = mv_f_unpert;
+
+        // Factorize once for this and the lagged iterations
+        double a = m_jac.topLeftCorner(m_ns, m_ns).diagonal().maxCoeff();
+        Eigen::MatrixXd m_jac_shift = m_jac;
+        m_jac_shift.topLeftCorner(m_ns, m_ns).array() += a;
+        m_jac_lu.compute(m_jac_shift);
     }
 
 //==============================================================================
 
     Eigen::VectorXd& systemSolution()
     {
-        double a = m_jac.topLeftCorner(m_ns, m_ns).diagonal().maxCoeff();
-        m_jac.topLeftCorner(m_ns, m_ns) += a*Eigen::MatrixXd::Ones(m_ns,m_ns);
-        mv_dX.head(m_neqns) = m_jac.fullPivLu().solve(mv_f_unpert);
+        mv_dX.head(m_neqns) = m_jac_lu.solve(mv_f);
 
         if(!is_surf_in_thermal_eq)
             mv_dX.tail(m_nT-1).setConstant(0.);
@@ -425,11 +515,20 @@ private:
     Eigen::VectorXd mv_dX;
     Eigen::VectorXd mv_f;
     Eigen::MatrixXd m_jac;
+    Eigen::FullPivLU<Eigen::MatrixXd> m_jac_lu;
+    const int m_jac_lag;
+    const double m_jac_refresh_ratio;
     Eigen::VectorXd mv_f_unpert;
     Eigen::VectorXd mv_surf_reac_rates;
-    double m_pert_m;
+    Eigen::VectorXd mv_drhoidx;
+    Eigen::MatrixXd m_dvdx;
+    Eigen::MatrixXd m_drates;
+    Eigen::VectorXd mv_dmblow;
+    Eigen::VectorXd mv_rhoi_pert;
     double m_pert_T;
+    double m_pert_x;
     double m_tol;
+    double m_tol_xsum;
 
     const double m_phi;
     const double m_h_v;
@@ -104,6 +104,12 @@ void SurfaceChemistry::surfaceReactionRatesPerReaction(
 
 //==============================================================================
 
+void SurfaceChemistry::surfaceReactionRatesJacobian(MatrixXd& m_jac) const {
+    mp_rate_manager->computeRatesJacobian(m_jac);
+}
+
+//==============================================================================
+
 int SurfaceChemistry::nSurfaceReactions() {
     return mp_rate_manager->nSurfaceReactions();
 }
@@ -78,6 +78,13 @@ public:
      */
     void surfaceReactionRatesPerReaction(Eigen::VectorXd& v_rate_per_reaction);
 
+//==============================================================================
+    /**
+     * Computes the Jacobian of the chemical source terms with respect to the
+     * species densities at the wall, at constant wall temperature.
+     */
+    void surfaceReactionRatesJacobian(Eigen::MatrixXd& m_jac) const;
+
 //==============================================================================
     /**
      * Returns the number of surface reactions considered.
@@ -104,6 +104,54 @@ void ThirdbodyReactionStoich<Reactants, Products>::contributeToJacobian(
 
 //==============================================================================
 
+template <typename Reactants, typename Products>
+void ReactionStoich<Reactants, Products>::contributeToGradient(
+    const double kf, const double kb, const double* const conc,
+    const double a, double* const work, double* const grad,
+    const size_t ns) const
+{
+    for (int i = 0; i < Products::nSpecies(); ++i)
+        work[m_prods(i)] = 0.0;
+
+    m_reacs.diffRR(kf, conc, work, Equals());
+    m_prods.diffRR(kb, conc, work, MinusEquals());
+
+    // Species may appear on both sides, so clear the work array as it is used
+    for (int i = 0; i < Reactants::nSpecies(); ++i) {
+        grad[m_reacs(i)] += a * work[m_reacs(i)];
+        work[m_reacs(i)] = 0.0;
+    }
+    for (int i = 0; i < Products::nSpecies(); ++i) {
+        grad[m_prods(i)] += a * work[m_prods(i)];
+        work[m_prods(i)] = 0.0;
+    }
+}
+
+//==============================================================================
+
+template <typename Reactants, typename Products>
+void ThirdbodyReactionStoich<Reactants, Products>::contributeToGradient(
+    const double kf, const double kb, const double* const conc,
+    const double a, double* const work, double* const grad,
+    const size_t ns) const
+{
+    const double rr = m_reacs.rr(kf, conc) - m_prods.rr(kb, conc);
+    double tb = 0.0;
+
+    for (int i = 0; i < ns; ++i) {
+        work[i] = mp_alpha[i] * rr;
+        tb += mp_alpha[i] * conc[i];
+    }
+
+    m_reacs.diffRR(kf, conc, work, PlusEqualsTimes(tb));
+    m_prods.diffRR(kb, conc, work, MinusEqualsTimes(tb));
+
+    for (int j = 0; j < ns; ++j)
+        grad[j] += a * work[j];
+}
+
+//==============================================================================
+
 template <typename Reactants>
 void JacobianManager::addReactionStoich(
     JacStoichBase* p_reacs, JacStoichBase* p_prods, const StoichType type, 
@@ -315,6 +363,28 @@ void JacobianManager::computeJacobian(
     }
 }
 
+//==============================================================================
+
+void JacobianManager::computeGradient(
+    const double* const kf, const double* const kb, const double* const conc,
+    const double* const a, double* const grad) const
+{
+    const size_t ns = m_thermo.nSpecies();
+    const size_t nr = m_reactions.size();
+
+    std::fill(grad, grad+ns, 0.0);
+
+    // Only the reactions with a nonzero weight contribute
+    for (int i = 0; i < nr; ++i)
+        if (a[i] != 0.0)
+            m_reactions[i]->contributeToGradient(
+                kf[i], kb[i], conc, a[i], mp_work, grad, ns);
+
+    // Convert from concentrations to densities
+    for (int j = 0; j < ns; ++j)
+        grad[j] /= m_thermo.speciesMw(j);
+}
+
 //==============================================================================
 
     } // namespace Kinetics
@@ -329,6 +329,11 @@ public:
     virtual void contributeToJacobian(
         const double kf, const double kb, const double* const conc, 
         double* const work, double* const sjac, const size_t ns) const = 0;
+
+    virtual void contributeToGradient(
+        const double kf, const double kb, const double* const conc,
+        const double a, double* const work, double* const grad,
+        const size_t ns) const = 0;
 };
 
 /**
@@ -379,6 +384,15 @@ public:
         const double kf, const double kb, const double* const conc, 
         double* const work, double* const sjac, const size_t ns) const;
 
+    /**
+     * Adds a times the derivatives of this reaction's rate of progress with
+     * respect to the species concentrations to the gradient vector.
+     */
+    void contributeToGradient(
+        const double kf, const double kb, const double* const conc,
+        const double a, double* const work, double* const grad,
+        const size_t ns) const;
+
 protected:
     
     Reactants m_reacs;
@@ -463,6 +477,15 @@ public:
     void contributeToJacobian(
         const double kf, const double kb, const double* const conc, 
         double* const work, double* const sjac, const size_t ns) const;
+
+    /**
+     * Adds a times the derivatives of this reaction's rate of progress with
+     * respect to the species concentrations to the gradient vector.
+     */
+    void contributeToGradient(
+        const double kf, const double kb, const double* const conc,
+        const double a, double* const work, double* const grad,
+        const size_t ns) const;
     
     friend void swap<Reactants, Products>(
         ThirdbodyReactionStoich<Reactants, Products>&,
@@ -517,6 +540,15 @@ public:
     void computeJacobian(
         const double* const kf, const double* const kb, 
         const double* const conc, double* const sjac) const;
+
+    /**
+     * Computes the gradient of the weighted sum of the net rates of progress
+     * \f$\sum_r a_r \xi_r\f$ with respect to the species densities.
+     */
+    void computeGradient(
+        const double* const kf, const double* const kb,
+        const double* const conc, const double* const a,
+        double* const grad) const;
     
 private:
     
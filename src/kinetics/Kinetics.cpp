@@ -54,7 +54,8 @@ Kinetics::Kinetics(
       mp_ropf(NULL),
       mp_ropb(NULL),
       mp_rop(NULL),
-      mp_wdot(NULL)
+      mp_wdot(NULL),
+      mp_drop(NULL)
 {
     if (mechanism == "none")
         return;
@@ -104,6 +105,8 @@ Kinetics::~Kinetics()
         delete [] mp_rop;
     if (mp_wdot != NULL)
         delete [] mp_wdot;
+    if (mp_drop != NULL)
+        delete [] mp_drop;
 }
 
 //==============================================================================
@@ -162,6 +165,7 @@ void Kinetics::closeReactions(const bool validate_mechanism)
     mp_ropb  = new double [nReactions()];
     mp_rop   = new double [std::max(m_thermo.nSpecies(), (int) nReactions())];
     mp_wdot  = new double [m_thermo.nSpecies()];
+    mp_drop  = new double [2*nReactions()];
     
 }
 
@@ -387,6 +391,90 @@ void Kinetics::jacobianRho(double* const p_jac)
     m_jacobian.computeJacobian(mp_ropf, mp_ropb, mp_rop, p_jac);
 }
 
+//==============================================================================
+
+void Kinetics::netRatesOfProgressDerivatives(
+    double* const p_drdT, double* const p_drdTv)
+{
+    const int nr = nReactions();
+    if (nr == 0)
+        return;
+
+    // Compute species concentrations (mol/m^3)
+    ArrayXd conc =
+        (m_thermo.numberDensity() / NA) *
+        Map<const ArrayXd>(m_thermo.X(), m_thermo.nSpecies());
+
+    // The concentrations are constant at constant species densities so only
+    // the rate coefficients change with the temperatures
+    forwardRatesOfProgress(conc.data(), mp_ropf);
+    backwardRatesOfProgress(conc.data(), mp_ropb);
+    mp_rates->updateDerivatives(m_thermo);
+
+    Map<const ArrayXd> ropf(mp_ropf, nr);
+    Map<const ArrayXd> ropb(mp_ropb, nr);
+
+    Map<ArrayXd>(p_drdT, nr) =
+        ropf * Map<const ArrayXd>(mp_rates->dlnkfdT(), nr) -
+        ropb * Map<const ArrayXd>(mp_rates->dlnkbdT(), nr);
+    Map<ArrayXd>(p_drdTv, nr) =
+        ropf * Map<const ArrayXd>(mp_rates->dlnkfdTv(), nr) -
+        ropb * Map<const ArrayXd>(mp_rates->dlnkbdTv(), nr);
+}
+
+//==============================================================================
+
+void Kinetics::jacobianT(double* const p_dwdT, double* const p_dwdTv)
+{
+    const int ns = m_thermo.nSpecies();
+    std::fill(p_dwdT, p_dwdT+ns, 0.0);
+    std::fill(p_dwdTv, p_dwdTv+ns, 0.0);
+
+    if (nReactions() == 0)
+        return;
+
+    double* const p_drdT  = mp_drop;
+    double* const p_drdTv = mp_drop + nReactions();
+    netRatesOfProgressDerivatives(p_drdT, p_drdTv);
+
+    // Sum all contributions from every reaction
+    m_reactants.decrSpecies(p_drdT, p_dwdT);
+    m_rev_prods.incrSpecies(p_drdT, p_dwdT);
+    m_irr_prods.incrSpecies(p_drdT, p_dwdT);
+
+    m_reactants.decrSpecies(p_drdTv, p_dwdTv);
+    m_rev_prods.incrSpecies(p_drdTv, p_dwdTv);
+    m_irr_prods.incrSpecies(p_drdTv, p_dwdTv);
+
+    // Multiply by species molecular weights
+    for (int i = 0; i < ns; ++i) {
+        p_dwdT[i]  *= m_thermo.speciesMw(i);
+        p_dwdTv[i] *= m_thermo.speciesMw(i);
+    }
+}
+
+//==============================================================================
+
+void Kinetics::netRatesOfProgressGradientRho(
+    const double* const p_a, double* const p_grad)
+{
+    // Special case of no reactions
+    if (nReactions() == 0) {
+        std::fill(p_grad, p_grad + m_thermo.nSpecies(), 0);
+        return;
+    }
+
+    forwardRateCoefficients(mp_ropf);
+    backwardRateCoefficients(mp_ropb);
+
+    // Compute species concentrations (mol/m^3)
+    Map<ArrayXd>(mp_rop, m_thermo.nSpecies()) =
+        (m_thermo.numberDensity() / NA) *
+        Map<const ArrayXd>(m_thermo.X(), m_thermo.nSpecies());
+
+    m_jacobian.computeGradient(mp_ropf, mp_ropb, mp_rop, p_a, p_grad);
+}
+
 //==============================================================================
 
     } // namespace Kinetics
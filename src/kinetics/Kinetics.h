@@ -194,6 +194,44 @@ public:
      */
     void jacobianRho(double* const p_jac);
 
+    /**
+     * Fills p_drdT and p_drdTv with the derivatives of the net rates of
+     * progress with respect to the translational and vibrational temperatures
+     * at constant species densities, in mol/m^3-s-K.  The electron temperature
+     * is taken equal to the vibrational temperature as in the two-temperature
+     * model.  For a single temperature model, the derivative with respect to T
+     * is the sum of both.
+     *
+     * @param p_drdT  - on return, \f$\partial \xi_j / \partial T\f$
+     * @param p_drdTv - on return, \f$\partial \xi_j / \partial T_v\f$
+     */
+    void netRatesOfProgressDerivatives(
+        double* const p_drdT, double* const p_drdTv);
+
+    /**
+     * Fills p_dwdT and p_dwdTv with the derivatives of the species production
+     * rates with respect to the translational and vibrational temperatures at
+     * constant species densities, in kg/m^3-s-K.
+     * @see netRatesOfProgressDerivatives()
+     *
+     * @param p_dwdT  - on return, \f$\partial \dot{\omega}_i / \partial T\f$
+     * @param p_dwdTv - on return, \f$\partial \dot{\omega}_i / \partial T_v\f$
+     */
+    void jacobianT(double* const p_dwdT, double* const p_dwdTv);
+
+    /**
+     * Fills p_grad with the gradient of a weighted sum of the net rates of
+     * progress with respect to the species densities at constant temperatures
+     * \f[
+     * g_k = \frac{\partial}{\partial \rho_k} \sum_j a_j \xi_j.
+     * \f]
+     *
+     * @param p_a    - weights of each reaction (only nonzero weights are used)
+     * @param p_grad - on return, the gradient \f$g_k\f$
+     */
+    void netRatesOfProgressGradientRho(
+        const double* const p_a, double* const p_grad);
+
     /**
      * Returns the change in some species quantity across each reaction.
      */
@@ -237,6 +275,7 @@ private:
     double* mp_ropb;
     double* mp_rop;
     double* mp_wdot;
+    double* mp_drop;
 };
 
 
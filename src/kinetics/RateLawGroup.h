@@ -59,7 +59,7 @@ public:
     /**
      * Constructor.
      */
-    RateLawGroup() : m_last_t(-1.0) {}
+    RateLawGroup() : m_last_t(-1.0), m_dtdT(0.0), m_dtdTv(0.0) {}
 
     /**
      * Destructor.
@@ -92,6 +92,15 @@ public:
      */
     virtual void lnk(
         const Thermodynamics::StateModel* const p_state, double* const p_lnk) = 0;
+
+    /**
+     * Evaluates the derivatives of the logarithm of all of the rates in the
+     * group with respect to the translational and vibrational temperatures,
+     * taking the electron temperature equal to the vibrational one.
+     */
+    virtual void dlnkdT(
+        const Thermodynamics::StateModel* const p_state,
+        double* const p_dlnk_dT, double* const p_dlnk_dTv) = 0;
         
     /**
      * Computes \Delta G / RT for this rate law group and subtracts these values
@@ -108,6 +117,27 @@ public:
         m_reacs.decrReactions(p_g, p_r);
         m_prods.incrReactions(p_g, p_r);
     }
+
+    /**
+     * Subtracts the derivatives of ln(keq) with respect to T and Tv for each of
+     * the reactions in this group, given the species enthalpies H_i/RT at the
+     * group temperature.  Must be called after dlnkdT().
+     */
+    void subtractDLnKeq(
+        size_t ns, const double* const p_h, double* const p_g,
+        double* const p_dT, double* const p_dTv) const
+    {
+        // d/dt [G_i/RT - ln(Patm/RT)] = (1 - H_i/RT) / t
+        for (int i = 0; i < ns; ++i)
+            p_g[i] = (1.0 - p_h[i]) / m_t * m_dtdT;
+        m_reacs.decrReactions(p_g, p_dT);
+        m_prods.incrReactions(p_g, p_dT);
+
+        for (int i = 0; i < ns; ++i)
+            p_g[i] = (1.0 - p_h[i]) / m_t * m_dtdTv;
+        m_reacs.decrReactions(p_g, p_dTv);
+        m_prods.incrReactions(p_g, p_dTv);
+    }
     
 
 protected:
@@ -116,6 +146,11 @@ protected:
     /// in the lnk() function)
     double m_t;
     double m_last_t;
+
+    /// Derivatives of the group temperature with respect to T and Tv (should
+    /// be set in the dlnkdT() function)
+    double m_dtdT;
+    double m_dtdTv;
     
     /// Stores the reactants for reactions that will use this rate law for the
     /// reverse direction
@@ -172,6 +207,29 @@ public:
         m_last_t = m_t;
     }
 
+    /**
+     * Evaluates the temperature derivatives of the logarithm of all of the
+     * rates in the group.
+     */
+    virtual void dlnkdT(
+        const Thermodynamics::StateModel* const p_state,
+        double* const p_dlnk_dT, double* const p_dlnk_dTv)
+    {
+        const TSelectorType selector;
+        m_t     = selector.getT(p_state);
+        m_dtdT  = selector.getDTDT(p_state);
+        m_dtdTv = selector.getDTDTv(p_state);
+
+        const double invT = 1.0 / m_t;
+
+        for (int i = 0; i < m_rates.size(); ++i) {
+            const std::pair<size_t, RateLawType>& rate = m_rates[i];
+            const double dlnk = rate.second.getDLnRateDT(invT);
+            p_dlnk_dT[rate.first]  = dlnk * m_dtdT;
+            p_dlnk_dTv[rate.first] = dlnk * m_dtdTv;
+        }
+    }
+
 private:
 
     /// vector of rates to evaluate
@@ -259,6 +317,36 @@ public:
             iter->second->lnk(p_state, p_lnk);
     }
     
+    /**
+     * Computes the temperature derivatives of the rate coefficients in this
+     * collection and stores them at the index of their respective reaction.
+     */
+    void dlnkdT(
+        const Thermodynamics::StateModel* const p_state,
+        double* const p_dlnk_dT, double* const p_dlnk_dTv)
+    {
+        GroupMap::iterator iter = m_group_map.begin();
+        for ( ; iter != m_group_map.end(); ++iter)
+            iter->second->dlnkdT(p_state, p_dlnk_dT, p_dlnk_dTv);
+    }
+
+    /**
+     * Subtracts the temperature derivatives of ln(keq) from the provided
+     * rate coefficient derivatives.  p_h and p_g are work arrays of size ns.
+     */
+    void subtractDLnKeq(
+        const Thermodynamics::Thermodynamics& thermo, double* const p_h,
+        double* const p_g, double* const p_dT, double* const p_dTv)
+    {
+        const size_t ns = thermo.nSpecies();
+        GroupMap::iterator iter = m_group_map.begin();
+        for ( ; iter != m_group_map.end(); ++iter) {
+            const RateLawGroup* p_group = iter->second;
+            thermo.speciesHOverRT(p_group->getT(), p_h);
+            p_group->subtractDLnKeq(ns, p_h, p_g, p_dT, p_dTv);
+        }
+    }
+
     /**
      * Subtracts ln(keq) from the provided rate coefficients.
      */
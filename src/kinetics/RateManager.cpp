@@ -37,25 +37,34 @@ namespace Mutation {
 
 //==============================================================================
     
-// Simple macro to create a temperature selector type
-#define TEMPERATURE_SELECTOR(__NAME__,__T__)\
+// Simple macro to create a temperature selector type, given the temperature
+// and its derivatives with respect to T and Tv (taking Te = Tv)
+#define TEMPERATURE_SELECTOR(__NAME__,__T__,__DTDT__,__DTDTV__)\
 class __NAME__\
 {\
 public:\
     inline double getT(const Thermodynamics::StateModel* const state) const {\
         return ( __T__ );\
     }\
+    inline double getDTDT(const Thermodynamics::StateModel* const state) const {\
+        return ( __DTDT__ );\
+    }\
+    inline double getDTDTv(const Thermodynamics::StateModel* const state) const {\
+        return ( __DTDTV__ );\
+    }\
 };
 
 /// Temperature selector which returns the current translational temperature
-TEMPERATURE_SELECTOR(TSelector, state->T())
+TEMPERATURE_SELECTOR(TSelector, state->T(), 1.0, 0.0)
 
 /// Temperature selector which returns the current electron temperature
 //TEMPERATURE_SELECTOR(TeSelector, std::min(state->Te(), 10000.0))
-TEMPERATURE_SELECTOR(TeSelector, state->Te())
+TEMPERATURE_SELECTOR(TeSelector, state->Te(), 0.0, 1.0)
 
 /// Temperature selector which returns the current value of sqrt(T*Tv)
-TEMPERATURE_SELECTOR(ParkSelector, std::sqrt(state->T()*state->Tv()))
+TEMPERATURE_SELECTOR(ParkSelector, std::sqrt(state->T()*state->Tv()),
+    0.5*std::sqrt(state->Tv()/state->T()),
+    0.5*std::sqrt(state->T()/state->Tv()))
 
 #undef TEMPERATURE_SELECTOR
 
@@ -114,19 +123,25 @@ SELECT_RATE_LAWS(EXCITATION_E,               ArrheniusTe,   ArrheniusTe)
 
 RateManager::RateManager(size_t ns, const std::vector<Reaction>& reactions)
     : m_ns(ns), m_nr(reactions.size()), mp_lnkf(NULL), mp_lnkb(NULL),
-      mp_gibbs(NULL)
+      mp_dlnkf_dT(NULL), mp_dlnkb_dT(NULL), mp_dlnkf_dTv(NULL),
+      mp_dlnkb_dTv(NULL), mp_gibbs(NULL), mp_h(NULL)
 {
     // Add all of the reactions' rate coefficients to the manager
     const size_t nr = reactions.size();
     for (size_t i = 0; i < m_nr; ++i)
         addReaction(i, reactions[i]);
     
-    // Allocate storage in one block for both rate coefficient arrays and
-    // species gibbs free energies 
-    const size_t block_size = 2*m_nr + ns;
+    // Allocate storage in one block for both rate coefficient arrays, their
+    // temperature derivatives, and species gibbs free energies and enthalpies
+    const size_t block_size = 6*m_nr + 2*ns;
     mp_lnkf  = new double [block_size];
     mp_lnkb  = mp_lnkf + m_nr;
-    mp_gibbs = mp_lnkb + m_nr;
+    mp_dlnkf_dT  = mp_lnkb + m_nr;
+    mp_dlnkb_dT  = mp_dlnkf_dT + m_nr;
+    mp_dlnkf_dTv = mp_dlnkb_dT + m_nr;
+    mp_dlnkb_dTv = mp_dlnkf_dTv + m_nr;
+    mp_gibbs = mp_dlnkb_dTv + m_nr;
+    mp_h     = mp_gibbs + ns;
     
     // Initialize the arrays to zero
     std::fill(mp_lnkf, mp_lnkf+block_size, 0.0);
@@ -237,6 +252,27 @@ void RateManager::update(const Thermodynamics::Thermodynamics& thermo)
     m_rate_groups.subtractLnKeq(thermo, mp_gibbs, mp_lnkb);
 }
 
+//==============================================================================
+
+void RateManager::updateDerivatives(
+    const Thermodynamics::Thermodynamics& thermo)
+{
+    // Derivatives of the rate laws at the forward and backward temperatures
+    // (note: mp_dlnkf_dT+(rxn+m_nr) = mp_dlnkb_dT+rxn)
+    m_rate_groups.dlnkdT(thermo.state(), mp_dlnkf_dT, mp_dlnkf_dTv);
+
+    std::vector<size_t>::const_iterator iter = m_to_copy.begin();
+    for ( ; iter != m_to_copy.end(); ++iter) {
+        const size_t index = *iter;
+        mp_dlnkb_dT[index]  = mp_dlnkf_dT[index];
+        mp_dlnkb_dTv[index] = mp_dlnkf_dTv[index];
+    }
+
+    // Subtract dlnkeq(Tb) from dlnkf(Tb) to get dlnkb(Tb)
+    m_rate_groups.subtractDLnKeq(
+        thermo, mp_h, mp_gibbs, mp_dlnkb_dT, mp_dlnkb_dTv);
+}
+
 //==============================================================================
 
     } // namespace Kinetics
@@ -60,6 +60,12 @@ public:
      */
     void update(const Thermodynamics::Thermodynamics& thermo);
     
+    /**
+     * Updates the derivatives of the logarithm of the rate coefficients with
+     * respect to T and Tv, taking the electron temperature equal to Tv.
+     */
+    void updateDerivatives(const Thermodynamics::Thermodynamics& thermo);
+
     /**
      * Returns a pointer to the forward rate coefficients evaluated at the 
      * forward temperature.
@@ -72,6 +78,30 @@ public:
      */
     const double* const lnkb() { return mp_lnkb; }
     
+    /**
+     * Returns the derivatives of ln(kf) with respect to T after a call to
+     * updateDerivatives().
+     */
+    const double* const dlnkfdT() { return mp_dlnkf_dT; }
+
+    /**
+     * Returns the derivatives of ln(kb) with respect to T after a call to
+     * updateDerivatives().  These are zero for irreversible reactions.
+     */
+    const double* const dlnkbdT() { return mp_dlnkb_dT; }
+
+    /**
+     * Returns the derivatives of ln(kf) with respect to Tv after a call to
+     * updateDerivatives().
+     */
+    const double* const dlnkfdTv() { return mp_dlnkf_dTv; }
+
+    /**
+     * Returns the derivatives of ln(kb) with respect to Tv after a call to
+     * updateDerivatives().  These are zero for irreversible reactions.
+     */
+    const double* const dlnkbdTv() { return mp_dlnkb_dTv; }
+
     /**
      * Returns the indices of irreversible reactions.
      */
@@ -119,8 +149,18 @@ private:
     /// Storage for forward rate coefficient at backward temperature
     double* mp_lnkb;
     
+    /// Storage for the derivatives of the forward and backward rate
+    /// coefficients with respect to T and Tv
+    double* mp_dlnkf_dT;
+    double* mp_dlnkb_dT;
+    double* mp_dlnkf_dTv;
+    double* mp_dlnkb_dTv;
+
     /// Storage for species Gibbs free energies
     double* mp_gibbs;
+
+    /// Storage for species enthalpies
+    double* mp_h;
     
     /// Stores the indices for which the forward and reverse temperature
     /// evaluations are equal
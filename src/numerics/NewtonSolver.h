@@ -87,6 +87,17 @@ public:
         m_jacobian_lag = lag;
     }
 
+    /**
+     * Set the contraction ratio required to keep a lagged Jacobian.  If an
+     * iteration reduces the residual norm by less than this ratio, the
+     * Jacobian is updated on the next iteration regardless of the lag.  The
+     * default of 1 only updates it early when the residual norm grows.
+     */
+    void setJacobianRefreshRatio(const double ratio) {
+        assert(ratio > 0.0);
+        m_refresh_ratio = ratio;
+    }
+
     /**
      * Sets whether or not to write convergence history to the standard out.
      */
@@ -94,11 +105,24 @@ public:
         m_conv_hist = hist;
     }
 
+    /**
+     * Returns the relative residual norm reached by the last call to solve().
+     */
+    double residualNorm() const { return m_resnorm; }
+
+    /**
+     * Returns true if the last call to solve() reached the residual norm
+     * tolerance within the maximum number of iterations.
+     */
+    bool converged() const { return m_resnorm <= m_epsilon; }
+
 private:
 
     unsigned int m_max_iter;
     unsigned int m_jacobian_lag;
+    double       m_refresh_ratio;
     double       m_epsilon;
+    double       m_resnorm;
     bool         m_conv_hist;
 
 };
@@ -109,7 +133,9 @@ template <typename T, typename Solver>
 NewtonSolver<T, Solver>::NewtonSolver()
     : m_max_iter(20),
       m_jacobian_lag(1),
+      m_refresh_ratio(1.0),
       m_epsilon(1.0e-8),
+      m_resnorm(0.0),
       m_conv_hist(false)
 { }
 
@@ -153,12 +179,18 @@ T& NewtonSolver<T, Solver>::solve(T& x)
 
         // Recompute f and norm(f)
         static_cast<Solver&>(*this).updateFunction(x);
+        const double last_resnorm = resnorm;
         resnorm = static_cast<Solver&>(*this).norm() / f0_norm;
 
+        // Do not keep a Jacobian which no longer converges fast enough
+        if (resnorm > m_refresh_ratio*last_resnorm)
+            jac = m_jacobian_lag;
+
         if (m_conv_hist)
             cout << ", relative residual = " << resnorm << endl;
     }
 
+    m_resnorm = resnorm;
     if (resnorm > m_epsilon && m_conv_hist) {
         cout << "Newton failed to converge after " << m_max_iter
              << " iterations with a relative residual of " << resnorm << endl;
@@ -0,0 +1,292 @@
+/**
+ * @file BatchEquilSolver.cpp
+ *
+ * @brief Implementation of the BatchEquilSolver class.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "BatchEquilSolver.h"
+#include "Thermodynamics.h"
+#include "Errors.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <thread>
+
+using namespace std;
+using namespace Mutation;
+
+namespace Mutation {
+    namespace Thermodynamics {
+
+//==============================================================================
+
+BatchEquilSolver::BatchEquilSolver(
+    const string& species_descriptor, const string& database, int nthreads)
+{
+    if (nthreads < 1)
+        nthreads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Loading the databases is not thread-safe, so build one Thermodynamics
+    // object per thread here, serially
+    m_thermo.reserve(nthreads);
+    try {
+        for (int i = 0; i < nthreads; ++i)
+            m_thermo.push_back(
+                new Thermodynamics(species_descriptor, database, "ChemNonEq1T"));
+    } catch (...) {
+        for (size_t i = 0; i < m_thermo.size(); ++i)
+            delete m_thermo[i];
+        throw;
+    }
+
+    const double* const p_Xe = m_thermo[0]->getDefaultComposition();
+    m_default_composition.assign(p_Xe, p_Xe+nElements());
+}
+
+//==============================================================================
+
+BatchEquilSolver::~BatchEquilSolver()
+{
+    for (size_t i = 0; i < m_thermo.size(); ++i)
+        delete m_thermo[i];
+}
+
+//==============================================================================
+
+int BatchEquilSolver::nSpecies() const
+{
+    return m_thermo[0]->nSpecies();
+}
+
+//==============================================================================
+
+int BatchEquilSolver::nElements() const
+{
+    return m_thermo[0]->nElements();
+}
+
+//==============================================================================
+
+void BatchEquilSolver::setDefaultComposition(const double* const p_Xe)
+{
+    std::copy(p_Xe, p_Xe+nElements(), m_default_composition.begin());
+}
+
+//==============================================================================
+
+BatchEquilStats BatchEquilSolver::equilibrate(
+    int npts, const double* const p_T, const double* const p_P,
+    double* const p_X, MoleFracDef mfd, int* const p_iters)
+{
+    const int ns = nSpecies();
+    const double* const p_Xe = m_default_composition.data();
+
+    vector<int> order;
+    orderStates(npts, p_T, p_P, p_Xe, 0, order);
+
+    return run(order, [=](Thermodynamics& thermo, int i) {
+        pair<int, int> iters;
+        try {
+            iters = thermo.equilibriumComposition(
+                p_T[i], p_P[i], p_Xe, p_X+i*ns, mfd);
+        } catch (...) {
+            std::fill(p_X+i*ns, p_X+(i+1)*ns,
+                std::numeric_limits<double>::quiet_NaN());
+            iters = make_pair(-1, -1);
+        }
+        if (p_iters != NULL) {
+            p_iters[2*i]   = iters.first;
+            p_iters[2*i+1] = iters.second;
+        }
+        return iters;
+    });
+}
+
+//==============================================================================
+
+BatchEquilStats BatchEquilSolver::equilibrate(
+    int npts, const double* const p_T, const double* const p_P,
+    const double* const p_Xe, double* const p_X, MoleFracDef mfd,
+    int* const p_iters)
+{
+    const int ne = nElements();
+    const int ns = nSpecies();
+
+    vector<int> order;
+    orderStates(npts, p_T, p_P, p_Xe, ne, order);
+
+    return run(order, [=](Thermodynamics& thermo, int i) {
+        pair<int, int> iters;
+        try {
+            iters = thermo.equilibriumComposition(
+                p_T[i], p_P[i], p_Xe+i*ne, p_X+i*ns, mfd);
+        } catch (...) {
+            std::fill(p_X+i*ns, p_X+(i+1)*ns,
+                std::numeric_limits<double>::quiet_NaN());
+            iters = make_pair(-1, -1);
+        }
+        if (p_iters != NULL) {
+            p_iters[2*i]   = iters.first;
+            p_iters[2*i+1] = iters.second;
+        }
+        return iters;
+    });
+}
+
+//==============================================================================
+
+BatchEquilStats BatchEquilSolver::surfaceMassBalance(
+    int npts, const double* const p_Yke, const double* const p_Ykg,
+    const double* const p_T, const double* const p_P, const double Bg,
+    double* const p_Bc, double* const p_hw, double* const p_Xs)
+{
+    const int ns = nSpecies();
+
+    // The wall composition is the same for every state
+    vector<int> order;
+    orderStates(npts, p_T, p_P, NULL, 0, order);
+
+    return run(order, [=](Thermodynamics& thermo, int i) {
+        try {
+            thermo.surfaceMassBalance(
+                p_Yke, p_Ykg, p_T[i], p_P[i], Bg, p_Bc[i], p_hw[i],
+                (p_Xs == NULL ? NULL : p_Xs+i*ns));
+        } catch (...) {
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            p_Bc[i] = p_hw[i] = nan;
+            if (p_Xs != NULL)
+                std::fill(p_Xs+i*ns, p_Xs+(i+1)*ns, nan);
+            return make_pair(-1, -1);
+        }
+        const MultiPhaseEquilSolver& equil = *thermo.equilSolver();
+        return make_pair(equil.nSteps(), equil.nNewtons());
+    });
+}
+
+//==============================================================================
+
+void BatchEquilSolver::orderStates(
+    int npts, const double* const p_T, const double* const p_P,
+    const double* const p_Xe, int xe_stride, vector<int>& order) const
+{
+    const int ne = (p_Xe == NULL || xe_stride == 0 ? 0 : nElements());
+
+    order.resize(npts);
+    for (int i = 0; i < npts; ++i)
+        order[i] = i;
+
+    // Lexicographic ordering on (Xe, P, T) keeps states which are close in
+    // composition and pressure together, while T varies fastest
+    std::stable_sort(order.begin(), order.end(), [=](int a, int b) {
+        for (int k = 0; k < ne; ++k) {
+            const double xa = p_Xe[a*xe_stride+k];
+            const double xb = p_Xe[b*xe_stride+k];
+            if (xa != xb) return xa < xb;
+        }
+        if (p_P[a] != p_P[b]) return p_P[a] < p_P[b];
+        return p_T[a] < p_T[b];
+    });
+}
+
+//==============================================================================
+
+template <typename Task>
+BatchEquilStats BatchEquilSolver::run(const vector<int>& order, Task task)
+{
+    const int npts = static_cast<int>(order.size());
+    const int nthreads = std::min(nThreads(), std::max(npts, 1));
+
+    // Use a few chunks per thread so that the load is balanced when some
+    // states are much harder to converge than others
+    const int nchunks = std::min(npts, 4*nthreads);
+    std::atomic<int> next_chunk(0);
+
+    vector<BatchEquilStats> stats(nthreads);
+    vector<exception_ptr> errors(nthreads);
+
+    auto worker = [&](int t) {
+        BatchEquilStats& s = stats[t];
+        s.n_points = s.n_failed = s.n_steps = s.n_newtons = 0;
+        s.max_steps = s.max_newtons = 0;
+
+        try {
+            int c;
+            while ((c = next_chunk++) < nchunks) {
+                const int begin = static_cast<int>(
+                    static_cast<long>(c)*npts/nchunks);
+                const int end = static_cast<int>(
+                    static_cast<long>(c+1)*npts/nchunks);
+
+                // The first state of a chunk is never warm started
+                m_thermo[t]->equilSolver()->setWarmStart(true);
+
+                for (int k = begin; k < end; ++k) {
+                    pair<int, int> iters = task(*m_thermo[t], order[k]);
+                    s.n_points++;
+                    if (iters.first < 0) {
+                        s.n_failed++;
+                        continue;
+                    }
+                    s.n_steps   += iters.first;
+                    s.n_newtons += iters.second;
+                    s.max_steps   = std::max(s.max_steps, iters.first);
+                    s.max_newtons = std::max(s.max_newtons, iters.second);
+                }
+            }
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    // The calling thread does its share of the work as well
+    vector<std::thread> threads;
+    threads.reserve(nthreads-1);
+    for (int t = 1; t < nthreads; ++t)
+        threads.push_back(std::thread(worker, t));
+    worker(0);
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    for (int t = 0; t < nthreads; ++t)
+        if (errors[t]) std::rethrow_exception(errors[t]);
+
+    BatchEquilStats total = { 0, 0, 0, 0, 0, 0 };
+    for (int t = 0; t < nthreads; ++t) {
+        total.n_points    += stats[t].n_points;
+        total.n_failed    += stats[t].n_failed;
+        total.n_steps     += stats[t].n_steps;
+        total.n_newtons   += stats[t].n_newtons;
+        total.max_steps   = std::max(total.max_steps, stats[t].max_steps);
+        total.max_newtons = std::max(total.max_newtons, stats[t].max_newtons);
+    }
+
+    return total;
+}
+
+//==============================================================================
+
+    } // namespace Thermodynamics
+} // namespace Mutation
@@ -0,0 +1,175 @@
+/**
+ * @file BatchEquilSolver.h
+ *
+ * @brief Defines the BatchEquilSolver class which computes equilibrium
+ * solutions over many states concurrently.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THERMO_BATCH_EQUIL_SOLVER_H
+#define THERMO_BATCH_EQUIL_SOLVER_H
+
+#include "MultiPhaseEquilSolver.h"
+
+#include <string>
+#include <vector>
+
+namespace Mutation {
+    namespace Thermodynamics {
+
+class Thermodynamics;
+
+/**
+ * Convergence statistics of a batch of equilibrium solutions.
+ */
+struct BatchEquilStats
+{
+    int n_points;    ///< number of states in the batch
+    int n_failed;    ///< number of states for which the solver failed
+    int n_steps;     ///< total number of continuation steps
+    int n_newtons;   ///< total number of Newton iterations
+    int max_steps;   ///< largest number of continuation steps for one state
+    int max_newtons; ///< largest number of Newton iterations for one state
+};
+
+/**
+ * @class BatchEquilSolver
+ * @brief Computes equilibrium solutions for arrays of states using several
+ * threads.
+ *
+ * Each thread owns its own Thermodynamics object (and therefore its own
+ * thermodynamic database and MultiPhaseEquilSolver) so that no state is shared
+ * between threads.  The states are ordered by elemental composition, pressure,
+ * and temperature and then split into contiguous chunks which the threads
+ * process in turn.  Neighbouring states in a chunk usually share the same
+ * phase and constraint ordering, which each solver instance then reuses.
+ * Single phase states with the same elemental composition as the previous
+ * state of their chunk are also warm started from its solution, unless that
+ * state failed.
+ */
+class BatchEquilSolver
+{
+public:
+
+    /**
+     * Constructs the batch solver for the given species list and
+     * thermodynamic database.  If nthreads is less than 1, the number of
+     * hardware threads is used.
+     */
+    BatchEquilSolver(
+        const std::string& species_descriptor, const std::string& database,
+        int nthreads = 0);
+
+    /**
+     * Destructor.
+     */
+    ~BatchEquilSolver();
+
+    /**
+     * Returns the number of threads (and solver instances) in use.
+     */
+    int nThreads() const { return static_cast<int>(m_thermo.size()); }
+
+    /**
+     * Returns the number of species in each solution.
+     */
+    int nSpecies() const;
+
+    /**
+     * Returns the number of elements in each composition.
+     */
+    int nElements() const;
+
+    /**
+     * Sets the elemental mole fractions used when no composition is given.
+     */
+    void setDefaultComposition(const double* const p_Xe);
+
+    /**
+     * Computes the equilibrium mole fractions at npts (T,P) states with the
+     * default elemental composition.
+     * @see equilibrate()
+     */
+    BatchEquilStats equilibrate(
+        int npts, const double* const p_T, const double* const p_P,
+        double* const p_X, MoleFracDef mfd = GLOBAL, int* const p_iters = NULL);
+
+    /**
+     * Computes the equilibrium mole fractions at npts (T,P,Xe) states.
+     *
+     * @param npts    number of states
+     * @param p_T     temperatures in K (npts)
+     * @param p_P     pressures in Pa (npts)
+     * @param p_Xe    elemental mole fractions (npts x nElements, row major)
+     * @param p_X     on return, species mole fractions (npts x nSpecies)
+     * @param mfd     mole fraction definition
+     * @param p_iters (optional) on return, continuation steps and Newton
+     *                iterations of each state (npts x 2)
+     */
+    BatchEquilStats equilibrate(
+        int npts, const double* const p_T, const double* const p_P,
+        const double* const p_Xe, double* const p_X, MoleFracDef mfd = GLOBAL,
+        int* const p_iters = NULL);
+
+    /**
+     * Solves the surface mass balance at npts (T,P) wall states for the same
+     * boundary layer edge and pyrolysis gas compositions.
+     * @see Thermodynamics::surfaceMassBalance()
+     *
+     * @param p_Bc On return, char blowing rates (npts).
+     * @param p_hw On return, wall enthalpies in J/kg (npts).
+     * @param p_Xs (optional) On return, wall mole fractions (npts x nSpecies).
+     */
+    BatchEquilStats surfaceMassBalance(
+        int npts, const double* const p_Yke, const double* const p_Ykg,
+        const double* const p_T, const double* const p_P, const double Bg,
+        double* const p_Bc, double* const p_hw, double* const p_Xs = NULL);
+
+private:
+
+    /**
+     * Fills the order vector with the state indices sorted such that
+     * consecutive states are as close as possible.
+     */
+    void orderStates(
+        int npts, const double* const p_T, const double* const p_P,
+        const double* const p_Xe, int xe_stride, std::vector<int>& order) const;
+
+    /**
+     * Runs task(thermo, i) for every state i in the given order, distributing
+     * contiguous chunks of the order among the threads.  The task returns the
+     * (steps, newtons) pair of each solution.
+     */
+    template <typename Task>
+    BatchEquilStats run(const std::vector<int>& order, Task task);
+
+private:
+
+    std::vector<Thermodynamics*> m_thermo;
+    std::vector<double> m_default_composition;
+};
+
+    } // namespace Thermodynamics
+} // namespace Mutation
+
+#endif // THERMO_BATCH_EQUIL_SOLVER_H
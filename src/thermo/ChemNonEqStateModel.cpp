@@ -46,11 +46,13 @@ public:
         : StateModel(thermo, 1, thermo.nSpecies())
     {
         mp_work = new double [thermo.nSpecies()];
+        mp_work2 = new double [thermo.nSpecies()];
     }
 
     ~ChemNonEqStateModel()
     {
         delete [] mp_work;
+        delete [] mp_work2;
     }
 
     /**
@@ -84,7 +86,7 @@ public:
         case 0:
             // Solve energy equation for temperature
             getTFromRhoE(
-                Cp(m_thermo), H(m_thermo), p_energy[0], m_T, mp_work, -conc);
+                CpH(m_thermo), p_energy[0], m_T, mp_work, mp_work2, -conc);
             m_P = RU * m_T * conc;
             break;
 
@@ -124,6 +126,10 @@ public:
         p_T[0] = m_T;
     }
 
+    void setInitialTemperatures(const double* const p_T) {
+        m_T = p_T[0];
+    }
+
     void getEnergiesMass(double* const p_e)
 	{
 		const int ns = m_thermo.nSpecies();
@@ -164,28 +170,13 @@ private:
 
     /**
      * Small helper class which provides wrapper to
-     * Thermodynamics::speciesCpOverR() to be used with getTFromRhoE().
-     */
-    class Cp {
-    public:
-        Cp(const Thermodynamics& t) : thermo(t) {}
-        void operator () (double T, double* const cp) const {
-            thermo.speciesCpOverR(T, cp);
-        }
-    private:
-        const Thermodynamics& thermo;
-    };
-
-
-    /**
-     * Small helper class which provides wrapper to
-     * Thermodynamics::speciesHOverRT() to be used with getTFromRhoE().
+     * Thermodynamics::speciesCpAndHOverRT() to be used with getTFromRhoE().
      */
-    class H {
+    class CpH {
     public:
-        H(const Thermodynamics& t) : thermo(t) {}
-        void operator () (double T, double* const h) const {
-            thermo.speciesHOverRT(T, h);
+        CpH(const Thermodynamics& t) : thermo(t) {}
+        void operator () (double T, double* const cp, double* const h) const {
+            thermo.speciesCpAndHOverRT(T, cp, h);
         }
     private:
         const Thermodynamics& thermo;
@@ -194,6 +185,7 @@ private:
 private:
 
     double* mp_work;
+    double* mp_work2;
 
 }; // class ChemNonEqStateModel
 
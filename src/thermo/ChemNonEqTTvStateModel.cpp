@@ -59,6 +59,7 @@ public:
         mp_work2 = new double [thermo.nSpecies()];
         mp_work3 = new double [thermo.nSpecies()];
         mp_work4 = new double [thermo.nSpecies()];
+        mp_weights = new double [thermo.nSpecies()];
     }
 
     ~ChemNonEqTTvStateModel()
@@ -67,6 +68,7 @@ public:
         delete [] mp_work2;
         delete [] mp_work3;
         delete [] mp_work4;
+        delete [] mp_weights;
     }
 
     /**
@@ -158,6 +160,11 @@ public:
         p_T[1] = Tv();
     }
 
+    void setInitialTemperatures(const double* const p_T) {
+        m_T  = p_T[0];
+        m_Tv = p_T[1];
+    }
+
     void getEnergiesMass(double* const p_e)
     {
         int ns = m_thermo.nSpecies();
@@ -232,64 +239,112 @@ public:
      	p_tag[3] = 0; p_tag[8] = 1; // Vibration excitation
      	p_tag[4] = 0; p_tag[9] = 1; // Electronic excitation
     }
-  /**
-  * @brief Get temperatures from total energy by solving a non-linear system
-  *
-  * @param p_rhoi - "vector of the partial densities
-  * @param p_rhoe - total and internal mass energy
-  */
+private:
 
+    /**
+     * Solves the total and vibrational-electronic energy equations for T and
+     * Tv with Newton's method, starting from the current temperatures.  Only
+     * the heavy particle translational and rotational energies depend on T,
+     * so that the Jacobian
+     * \f[ J = \begin{bmatrix} c_{v,tr} & c_{v,ve} \\ 0 & c_{v,ve}
+     *     \end{bmatrix} \f]
+     * is upper triangular, where \f$c_{v,tr}\f$ is built from the heavy
+     * particle translational and rotational specific heats and
+     * \f$c_{v,ve}\f$ from the vibrational, electronic and free electron
+     * translational ones.  Each iteration evaluates the species enthalpies
+     * and, if not converged, the specific heats at the same temperatures.
+     * The convergence information is stored in m_energy_stats, which is the
+     * only report of a failure.
+     *
+     * @param p_rhoi - "vector of the partial densities
+     * @param p_rhoe - total and internal mass energy
+     */
     void solveEnergies(const double* const p_rhoi, const double* const p_rhoe)
     {
-        // This line is required to have perfect numerical jacobians...
-        //m_T = m_Tv = 500.0;
-
         const double atol = 1.0e-12;
         const double rtol = 1.0e-12;
         const int    imax = 100;
 
-        Map<const VectorXd> rhoi(p_rhoi, m_thermo.nSpecies());
-        const double density = rhoi.sum();
+        const int ns = m_thermo.nSpecies();
+        const int offset = (m_thermo.hasElectrons() ? 1 : 0);
+
+        // Species weights R_u y_i / M_i which turn the unitless species
+        // values into mixture values per unit mass
+        double density = 0.0;
+        for (int i = 0; i < ns; ++i)
+            density += p_rhoi[i];
+        for (int i = 0; i < ns; ++i)
+            mp_weights[i] = RU * p_rhoi[i] / (density * m_thermo.speciesMw(i));
+
+        const double emix0 = p_rhoe[0] / density;
+        const double emix1 = p_rhoe[1] / density;
+        const double tol =
+            rtol*std::sqrt(emix0*emix0 + emix1*emix1) + atol;
+
+        double* const h   = mp_work1;
+        double* const ht  = mp_work2;
+        double* const hv  = mp_work3;
+        double* const hel = mp_work4;
+
+        double e0, e1, f0, f1, cvtr, cvve, norm;
+        int iter;
+
+        for (iter = 0; ; ++iter) {
+            // Mixture total and vibrational-electronic energies
+            m_thermo.speciesHOverRT(
+                m_T, m_Tv, m_T, m_Tv, m_Tv, h, ht, NULL, hv, hel, NULL);
+
+            e0 = e1 = 0.0;
+            for (int i = offset; i < ns; ++i) {
+                e0 += mp_weights[i] * (h[i] - 1.0);
+                e1 += mp_weights[i] * (hv[i] + hel[i]);
+            }
+            e0 *= m_T;
+            e1 *= m_T;
 
-        static VectorXd yi; yi = rhoi / density;
-        const Vector2d emix = Map<const Vector2d>(p_rhoe) / density;
+            if (offset > 0) {
+                e0 += mp_weights[0] * (h[0]*m_T - m_Tv);
+                e1 += mp_weights[0] * (ht[0]*m_T - m_Tv);
+            }
 
-        static Matrix<double, Dynamic, Dynamic, RowMajor> ei;
-        static Matrix<double, Dynamic, Dynamic, RowMajor> ci;
-        ei.resize(2, m_thermo.nSpecies());
-        ci.resize(2, m_thermo.nSpecies());
+            f0 = e0 - emix0;
+            f1 = e1 - emix1;
+            norm = std::sqrt(f0*f0 + f1*f1);
 
-        getEnergiesMass(ei.data());
+            if (norm <= tol || iter == imax)
+                break;
 
-        Vector2d f, e, cv;
-        e = ei*yi;
-        f = e - emix;
+            // Specific heats of the two energy equations, reusing the work
+            // arrays for the translational, rotational, vibrational and
+            // electronic partitions
+            m_thermo.speciesCpOverR(
+                m_T, m_Tv, m_T, m_Tv, m_Tv, NULL, ht, h, hv, hel);
 
-        int i;
-        for (i = 0; (f.norm() > rtol*emix.norm() + atol) && (i < imax); ++i) {
-            // Update temperatures
-            getCvsMass(ci.data());
-            cv = ci*yi;
+            cvtr = cvve = 0.0;
+            for (int i = offset; i < ns; ++i) {
+                cvtr += mp_weights[i] * (ht[i] + h[i] - 1.0);
+                cvve += mp_weights[i] * (hv[i] + hel[i]);
+            }
 
-            m_Tv = std::max(m_Tv - f[1]/cv[1], 0.1*m_Tv);
-            m_T  = std::max(m_T + (f[1]-f[0])/cv[0], 0.1*m_T);
+            if (offset > 0)
+                cvve += mp_weights[0] * (ht[0] - 1.0);
 
-            // Update function evaluation
-            getEnergiesMass(ei.data());
-            e = ei*yi;
-            f = e - emix;
+            // Newton update with the triangular Jacobian
+            m_Tv = std::max(m_Tv - f1/cvve, 0.1*m_Tv);
+            m_T  = std::max(m_T + (f1-f0)/cvtr, 0.1*m_T);
         }
 
-        if (i == imax)
-            std::cout << "Warning, didn't converge temperatures: f = " << f.norm() << std::endl;
+        m_energy_stats.iterations = iter;
+        m_energy_stats.residual = norm;
+        m_energy_stats.converged = (norm <= tol);
     }
 
-
 private:
     double* mp_work1;
     double* mp_work2;
     double* mp_work3;
     double* mp_work4;
+    double* mp_weights;
 
 }; // class ChemNonEqStateModel
 
@@ -73,6 +73,13 @@ public:
      *   0: conserved variables (mixture density, static energy density)
      *   1: primitive set 1 (pressure, temperature)
      *   2: primitive set 2 (elemental mole fractions,  {P, T} array)
+     *   3: (pressure, mixture enthalpy in J/kg)
+     *   4: (pressure, mixture entropy in J/kg-K)
+     *   5: conserved variables solved directly by the equilibrium solver
+     *      (mixture density, static energy density)
+     *
+     * Variable sets 3 to 5 use the previous state as initial guess and solve
+     * for the temperature (and pressure) inside the equilibrium solver.
      */
     virtual void setState(
         const double* const p_mass, const double* const p_energy,
@@ -184,6 +191,36 @@ public:
                 m_thermo.equilibriumComposition(m_T, m_P, p_mass, mp_X);
                 break;
 
+            // Given pressure and enthalpy (using default elemental fractions)
+            case 3:
+                assert(p_mass[0] > 0.0);
+
+                m_P = p_mass[0];
+                m_thermo.equilibriumCompositionHP(
+                    p_energy[0], m_P, m_thermo.getDefaultComposition(), mp_X,
+                    m_T);
+                break;
+
+            // Given pressure and entropy (using default elemental fractions)
+            case 4:
+                assert(p_mass[0] > 0.0);
+
+                m_P = p_mass[0];
+                m_thermo.equilibriumCompositionSP(
+                    p_energy[0], m_P, m_thermo.getDefaultComposition(), mp_X,
+                    m_T);
+                break;
+
+            // Given density and energy density (using default elemental
+            // fractions)
+            case 5:
+                assert(p_mass[0] > 0.0);
+
+                m_thermo.equilibriumCompositionUV(
+                    p_energy[0]/p_mass[0], 1.0/p_mass[0],
+                    m_thermo.getDefaultComposition(), mp_X, m_T, m_P);
+                break;
+
             // Unknown variable set
             default:
                 throw InvalidInputError("variable set", vars)
@@ -191,7 +228,11 @@ public:
                     << ". Possible variable-sets are:\n"
                     << "  0: (mixture density, static energy density)\n"
                     << "  1: (pressure, temperature)\n"
-                    << "  2: (element mole fractions, pressure and temperature)";
+                    << "  2: (element mole fractions, pressure and temperature)\n"
+                    << "  3: (pressure, enthalpy)\n"
+                    << "  4: (pressure, entropy)\n"
+                    << "  5: (mixture density, static energy density) solved "
+                    << "directly by the equilibrium solver";
         }
 
         // Set the remaining temperatures
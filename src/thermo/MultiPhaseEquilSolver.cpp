@@ -123,7 +123,9 @@ void MultiPhaseEquilSolver::Solution::initialize(int np, int nc, int ns)
 bool MultiPhaseEquilSolver::Solution::setupOrdering(
         int* species_group, bool* zero_constraint)
 {
-    static std::vector<int> previous_order(m_np+m_nc+4, 0);
+    std::vector<int>& previous_order = m_previous_order;
+    if (previous_order.size() != static_cast<size_t>(m_np+m_nc+4))
+        previous_order.assign(m_np+m_nc+4, 0);
 
     // Count the number of species in each group and order the species such that
     // the groups are contiguous
@@ -475,7 +477,9 @@ MultiPhaseEquilSolver::MultiPhaseEquilSolver(
         m_pure_condensed(pure_condensed),
         m_solution(thermo),
         m_T(0.0),
-        m_P(0.0)
+        m_P(0.0),
+        m_warm_start(false),
+        m_have_solution(false)
 {
     // Sizing information
     m_ns  = m_thermo.nSpecies();
@@ -497,6 +501,8 @@ MultiPhaseEquilSolver::MultiPhaseEquilSolver(
     mp_g       = new double [m_ns];
     mp_g0      = new double [m_ns];
     mp_c       = new double [m_nc];
+    mp_h       = new double [m_ns];
+    mp_cp      = new double [m_ns];
     
     std::fill(mp_c, mp_c+m_nc, 0.0);
     
@@ -515,6 +521,8 @@ MultiPhaseEquilSolver::~MultiPhaseEquilSolver()
     delete [] mp_g;
     delete [] mp_g0;
     delete [] mp_c;
+    delete [] mp_h;
+    delete [] mp_cp;
 };
 
 //==============================================================================
@@ -781,8 +789,12 @@ std::pair<int, int> MultiPhaseEquilSolver::equilibrate(
         return std::make_pair(0,0);
     }
     
+    // The last solution can only be used again if this call converges
+    const bool warm = m_warm_start && m_have_solution;
+    m_have_solution = false;
+
     // Compute the initial conditions lambda(0), Nbar(0), N(0), and g(0)
-    if (!initialConditions(T, P, p_cv)) {
+    if (!initialConditions(T, P, p_cv, warm)) {
         DEBUG("could not compute the initial conditions!" << endl)
         for (int i = 0; i < m_ns; ++i)
             p_sv[i] = 0;
@@ -938,7 +950,8 @@ std::pair<int, int> MultiPhaseEquilSolver::equilibrate(
     if (resk > ms_eps_abs) {
     	cout << "Warning: equilibrium solver finished with residual of "
     	     << resk << "!";
-    }
+    } else
+        m_have_solution = true;
 
     #ifdef SAVE_EIGEN_SCRIPT
         rates(dx, true);
@@ -957,6 +970,371 @@ std::pair<int, int> MultiPhaseEquilSolver::equilibrate(
 
 //==============================================================================
 
+std::pair<int, int> MultiPhaseEquilSolver::equilibrateHP(
+    double h, double P, const double* const p_cv, double* const p_sv,
+    double& T, MoleFracDef mfd)
+{
+    return equilibrateConstrained(FIXED_HP, h, 0.0, p_cv, p_sv, T, P, mfd);
+}
+
+//==============================================================================
+
+std::pair<int, int> MultiPhaseEquilSolver::equilibrateSP(
+    double s, double P, const double* const p_cv, double* const p_sv,
+    double& T, MoleFracDef mfd)
+{
+    return equilibrateConstrained(FIXED_SP, s, 0.0, p_cv, p_sv, T, P, mfd);
+}
+
+//==============================================================================
+
+std::pair<int, int> MultiPhaseEquilSolver::equilibrateUV(
+    double u, double v, const double* const p_cv, double* const p_sv,
+    double& T, double& P, MoleFracDef mfd)
+{
+    return equilibrateConstrained(FIXED_UV, u, v, p_cv, p_sv, T, P, mfd);
+}
+
+//==============================================================================
+
+std::pair<int, int> MultiPhaseEquilSolver::equilibrateConstrained(
+    EquilConstraintType type, double a, double b, const double* const p_cv,
+    double* const p_sv, double& T, double& P, MoleFracDef mfd)
+{
+    assert(T > 0.0);
+    assert(P > 0.0);
+
+    const int    max_iters = 50;
+    const int    max_cuts  = 10;
+    const double tol       = 1.0e-10;
+    const double max_dlnT  = 0.2;
+    const double max_dlnP  = 1.0;
+    const double phase_tol = std::log(1.0e-6);
+
+    if (type == FIXED_TP)
+        return equilibrate(T, P, p_cv, p_sv, mfd);
+
+    const int nx = (type == FIXED_UV ? 2 : 1);
+
+    // Start from the fixed (T,P) solution at the initial guess
+    std::pair<int, int> stats = equilibrate(T, P, p_cv, p_sv, mfd);
+    if (stats.first < 0)
+        return stats;
+
+    int niters = stats.first;
+    int nnewts = stats.second;
+
+    // The composition of a single species mixture is fixed so that only the
+    // temperature (and pressure) need to be determined
+    if (m_ns == 1) {
+        double w [2], dwdT [2], dwdP [2];
+        updateThermoState(T, P);
+        for (int iter = 0; iter < max_iters; ++iter, ++nnewts) {
+            constraintWeights(type, a, b, 0, w, dwdT, dwdP);
+            double dlnT = -w[0] / dwdT[0];
+            dlnT = std::max(-max_dlnT, std::min(max_dlnT, dlnT));
+            updateThermoState(m_T*std::exp(dlnT), m_P);
+            if (type == FIXED_UV && m_thermo.species(0).phase() == GAS)
+                updateThermoState(
+                    m_T, RU*m_T/(m_thermo.speciesMw(0)*b));
+            if (std::abs(dlnT) < tol)
+                break;
+        }
+
+        T = m_T;
+        P = m_P;
+        m_niters = niters;
+        m_nnewts = nnewts;
+        return std::make_pair(niters, nnewts);
+    }
+
+    Solution last_solution(m_thermo);
+    VectorXd r, dx;
+    MatrixXd A;
+
+    updateThermoState(T, P);
+    double res = computeAugmentedResidual(type, a, b, r);
+
+    // Newton iterations on the augmented system, followed by a fixed (T,P)
+    // solution which checks for phase redistribution if condensed phases
+    // are present
+    for (int pass = 0; pass < 3; ++pass) {
+        int iter = 0;
+        while (res > tol && iter++ < max_iters) {
+            // First check if a phase needs to be removed (always include gas)
+            int m = 1;
+            bool removed = false;
+            while (m < m_solution.npr()) {
+                if (m_solution.lnNbar()[m] < phase_tol) {
+                    m_solution.removePhase(m);
+                    removed = true;
+                } else
+                    m++;
+            }
+            if (removed)
+                res = computeAugmentedResidual(type, a, b, r);
+
+            const int neq = m_solution.ncr() + m_solution.npr();
+
+            // Compute the Newton direction by eliminating the temperature and
+            // pressure unknowns with the Schur complement of the symmetric
+            // fixed (T,P) block, which is factored the same way as in newton()
+            formAugmentedSystemMatrix(type, a, b, A);
+            LDLT<MatrixXd, Upper> ldlt(A.topLeftCorner(neq, neq));
+            MatrixXd Z  = ldlt.solve(A.topRightCorner(neq, nx));
+            VectorXd z0 = ldlt.solve(-r.head(neq));
+            MatrixXd S  = A.bottomRightCorner(nx, nx) -
+                A.bottomLeftCorner(nx, neq)*Z;
+
+            dx.resize(neq+nx);
+            dx.tail(nx) = S.partialPivLu().solve(
+                -r.tail(nx) - A.bottomLeftCorner(nx, neq)*z0);
+            dx.head(neq) = z0 - Z*dx.tail(nx);
+
+            // Limit the temperature and pressure changes in a single step
+            double alpha = 1.0;
+            if (std::abs(dx(neq)) > max_dlnT)
+                alpha = max_dlnT / std::abs(dx(neq));
+            if (nx > 1 && alpha*std::abs(dx(neq+1)) > max_dlnP)
+                alpha = max_dlnP / std::abs(dx(neq+1));
+
+            // Backtrack along the Newton direction until the residual
+            // decreases
+            last_solution = m_solution;
+            const double lnT = std::log(m_T);
+            const double lnP = std::log(m_P);
+            double new_res = res;
+
+            for (int k = 0; k < max_cuts; ++k, alpha *= 0.5) {
+                m_solution = last_solution;
+                updateThermoState(
+                    std::exp(lnT + alpha*dx(neq)),
+                    nx > 1 ? std::exp(lnP + alpha*dx(neq+1)) : m_P);
+                m_solution.update(alpha*dx.head(neq), m_B);
+                new_res = computeAugmentedResidual(type, a, b, r);
+                if (new_res < res)
+                    break;
+            }
+
+            nnewts++;
+
+            // Could not reduce the residual any further
+            if (!(new_res < res)) {
+                m_solution = last_solution;
+                updateThermoState(std::exp(lnT), std::exp(lnP));
+                res = computeAugmentedResidual(type, a, b, r);
+                break;
+            }
+
+            res = new_res;
+        }
+
+        if (m_np == 1)
+            break;
+
+        stats = equilibrate(m_T, m_P, p_cv, p_sv, mfd);
+        if (stats.first < 0)
+            return stats;
+        niters += stats.first;
+        nnewts += stats.second;
+
+        updateThermoState(m_T, m_P);
+        res = computeAugmentedResidual(type, a, b, r);
+        if (res <= tol)
+            break;
+    }
+
+    if (res > tol) {
+        cout << "Warning: constrained equilibrium solver finished with "
+             << "residual of " << res << "!" << endl;
+    }
+
+    // Unwrap the solution for the user and return convergence stats
+    m_solution.unpackMoleFractions(p_sv, mfd);
+    std::copy(mp_g, mp_g+m_ns, mp_g0);
+
+    T = m_T;
+    P = m_P;
+    m_niters = niters;
+    m_nnewts = nnewts;
+
+    return std::make_pair(niters, nnewts);
+}
+
+//==============================================================================
+
+void MultiPhaseEquilSolver::updateThermoState(double T, double P)
+{
+    m_T = T;
+    m_P = P;
+
+    m_thermo.speciesGOverRT(m_T, m_P, mp_g);
+    m_thermo.speciesHOverRT(m_T, mp_h);
+    m_thermo.speciesCpOverR(m_T, mp_cp);
+
+    // The solution is always at s = 1 when this function is used
+    m_solution.setG(mp_g, mp_g, 1.0);
+    m_solution.updateY(m_B);
+}
+
+//==============================================================================
+
+void MultiPhaseEquilSolver::constraintWeights(
+    EquilConstraintType type, double a, double b, int k,
+    double* const p_w, double* const p_dwdT, double* const p_dwdP) const
+{
+    const int nsr = (m_ns == 1 ? 1 : m_solution.nsr());
+    const int ncr = m_solution.ncr();
+    const int* const p_sjr = m_solution.sjr();
+    const int* const p_cir = m_solution.cir();
+    const double RT = RU*m_T;
+
+    for (int j = 0; j < nsr; ++j) {
+        const int jk = (m_ns == 1 ? 0 : p_sjr[j]);
+        const double mw = m_thermo.speciesMw(jk);
+        const double gas = (m_thermo.species(jk).phase() == GAS ? 1.0 : 0.0);
+
+        switch (type) {
+        case FIXED_HP:
+            p_w[j]    = mp_h[jk] - mw*a/RT;
+            p_dwdT[j] = mp_cp[jk] - mp_h[jk] + mw*a/RT;
+            p_dwdP[j] = 0.0;
+            break;
+        case FIXED_SP: {
+            // The species chemical potentials are B*lambda by construction
+            // (or simply g for a single species mixture)
+            double mu = (m_ns == 1 ? mp_g[jk] : 0.0);
+            for (int i = 0; i < ncr && m_ns > 1; ++i)
+                mu += m_B(jk, p_cir[i])*m_solution.lambda()[i];
+            p_w[j]    = mp_h[jk] - mu - mw*a/RU;
+            p_dwdT[j] = mp_cp[jk] - (m_ns == 1 ? 0.0 : mp_h[jk]);
+            p_dwdP[j] = (m_ns == 1 ? -gas : 0.0);
+            break;
+        }
+        case FIXED_UV:
+            if (k == 0) {
+                p_w[j]    = mp_h[jk] - gas - mw*a/RT;
+                p_dwdT[j] = mp_cp[jk] - mp_h[jk] + mw*a/RT;
+                p_dwdP[j] = 0.0;
+            } else {
+                const double pv = m_P*b/RT;
+                p_w[j]    = gas - mw*pv;
+                p_dwdT[j] = mw*pv;
+                p_dwdP[j] = -mw*pv;
+            }
+            break;
+        default:
+            p_w[j] = p_dwdT[j] = p_dwdP[j] = 0.0;
+        }
+    }
+}
+
+//==============================================================================
+
+double MultiPhaseEquilSolver::computeAugmentedResidual(
+    EquilConstraintType type, double a, double b, VectorXd& r) const
+{
+    const int neq = m_solution.ncr() + m_solution.npr();
+    const int nsr = m_solution.nsr();
+    const int nx  = (type == FIXED_UV ? 2 : 1);
+    const double* const p_y = m_solution.y();
+
+    r.resize(neq+nx);
+    computeResidual(r);
+    double res = r.head(neq).squaredNorm();
+
+    VectorXd w(nsr), dwdT(nsr), dwdP(nsr);
+    for (int k = 0; k < nx; ++k) {
+        constraintWeights(type, a, b, k, w.data(), dwdT.data(), dwdP.data());
+
+        // Scale the extra equations to be comparable to the element ones
+        double scale = 0.0;
+        r(neq+k) = 0.0;
+        for (int j = 0; j < nsr; ++j) {
+            r(neq+k) += p_y[j]*p_y[j]*w(j);
+            scale += p_y[j]*p_y[j]*(std::abs(w(j)) + 1.0);
+        }
+        res += r(neq+k)*r(neq+k)/(scale*scale);
+    }
+
+    return std::sqrt(res);
+}
+
+//==============================================================================
+
+void MultiPhaseEquilSolver::formAugmentedSystemMatrix(
+    EquilConstraintType type, double a, double b, MatrixXd& A) const
+{
+    const int npr = m_solution.npr();
+    const int ncr = m_solution.ncr();
+    const int nsr = m_solution.nsr();
+    const int neq = ncr + npr;
+    const int nx  = (type == FIXED_UV ? 2 : 1);
+    const int* const p_sjr = m_solution.sjr();
+    const int* const p_cir = m_solution.cir();
+    const int* const p_sizes = m_solution.sizes();
+    const double* const p_y = m_solution.y();
+
+    // The (symmetric) equilibrium block is the same as for fixed (T,P)
+    MatrixXd Aeq(neq, neq);
+    formSystemMatrix(Aeq);
+
+    A = MatrixXd::Zero(neq+nx, neq+nx);
+    A.topLeftCorner(neq, neq) = Aeq.selfadjointView<Upper>();
+
+    // Derivatives of the species moles with respect to ln(T) and ln(P) are
+    // N_j*H_j/RT and -N_j (gas species only) respectively
+    double Nj, gas;
+    int jk;
+    for (int m = 0; m < npr; ++m) {
+        for (int j = p_sizes[m]; j < p_sizes[m+1]; ++j) {
+            jk  = p_sjr[j];
+            Nj  = p_y[j]*p_y[j];
+            gas = (m_thermo.species(jk).phase() == GAS ? 1.0 : 0.0);
+
+            for (int i = 0; i < ncr; ++i) {
+                A(i,neq) += m_B(jk, p_cir[i])*Nj*mp_h[jk];
+                if (nx > 1)
+                    A(i,neq+1) -= m_B(jk, p_cir[i])*Nj*gas;
+            }
+
+            A(ncr+m,neq) += Nj*mp_h[jk];
+            if (nx > 1)
+                A(ncr+m,neq+1) -= Nj*gas;
+        }
+    }
+
+    // Rows corresponding to the extra constraint equations
+    VectorXd w(nsr), dwdT(nsr), dwdP(nsr);
+    for (int k = 0; k < nx; ++k) {
+        const int row = neq+k;
+        constraintWeights(type, a, b, k, w.data(), dwdT.data(), dwdP.data());
+
+        for (int m = 0; m < npr; ++m) {
+            for (int j = p_sizes[m]; j < p_sizes[m+1]; ++j) {
+                jk  = p_sjr[j];
+                Nj  = p_y[j]*p_y[j];
+                gas = (m_thermo.species(jk).phase() == GAS ? 1.0 : 0.0);
+
+                for (int i = 0; i < ncr; ++i) {
+                    A(row,i) += Nj*m_B(jk, p_cir[i])*w(j);
+
+                    // Entropy weights depend on lambda through mu
+                    if (type == FIXED_SP)
+                        A(row,i) -= Nj*m_B(jk, p_cir[i]);
+                }
+
+                A(row,ncr+m) += Nj*w(j);
+                A(row,neq)   += Nj*(mp_h[jk]*w(j) + dwdT(j));
+                if (nx > 1)
+                    A(row,neq+1) += Nj*(dwdP(j) - gas*w(j));
+            }
+        }
+    }
+}
+
+//==============================================================================
+
 // Simple comparison function for sorting which is used in the next function.
 bool sortLargestSpecies(
 	const std::pair<int, double>& s1, const std::pair<int, double>& s2)
@@ -1083,8 +1461,8 @@ void MultiPhaseEquilSolver::rates(VectorXd& dx, bool save)
     Map<const VectorXd> y(m_solution.y(), nsr);
 
     // Compute a least squares factorization of H
-    static MatrixXd H; H = y.asDiagonal()*m_solution.reducedMatrix(m_B, m_Br);
-    static JacobiSVD<MatrixXd> svd; svd.compute(H, ComputeThinU | ComputeThinV);
+    MatrixXd& H = m_H; H = y.asDiagonal()*m_solution.reducedMatrix(m_B, m_Br);
+    JacobiSVD<MatrixXd>& svd = m_svd; svd.compute(H, ComputeThinU | ComputeThinV);
 
     // Use tableau for temporary storage
     Map<VectorXd> ydg(mp_tableau, nsr);
@@ -1152,8 +1530,8 @@ void MultiPhaseEquilSolver::rates_ci(int k, VectorXd& dx)
     VectorXd y = Map<const ArrayXd>(m_solution.y(), nsr).max(1.e-6);
 
     // Compute a least squares factorization of H
-    static MatrixXd H; H = y.asDiagonal()*m_solution.reducedMatrix(m_B, m_Br);
-    static JacobiSVD<MatrixXd> svd; svd.compute(H, ComputeThinU | ComputeThinV);
+    MatrixXd& H = m_H; H = y.asDiagonal()*m_solution.reducedMatrix(m_B, m_Br);
+    JacobiSVD<MatrixXd>& svd = m_svd; svd.compute(H, ComputeThinU | ComputeThinV);
 
     // Use tableau for temporary storage
     Map<VectorXd> phi(mp_tableau, nsr);
@@ -1235,15 +1613,15 @@ double MultiPhaseEquilSolver::newton()
     const double* const p_lnNbar = m_solution.lnNbar();
     
     // First compute the residual
-    static VectorXd r; r.resize(ncr+npr);
+    VectorXd& r = m_r; r.resize(ncr+npr);
     computeResidual(r);
     
     double res = r.norm();
     if (res > 1.0)
         return res;
 
-    static MatrixXd A;  A.resize(ncr+npr,ncr+npr);
-    static VectorXd dx; dx.resize(ncr+npr);
+    MatrixXd& A  = m_A;  A.resize(ncr+npr,ncr+npr);
+    VectorXd& dx = m_dx; dx.resize(ncr+npr);
     
     int iter = 0;
     while (res > ms_eps_abs && iter < max_iters) {
@@ -1281,7 +1659,7 @@ double MultiPhaseEquilSolver::newton()
         #endif
         
         // Solve the linear system (if it is singular then don't bother)
-        static LDLT<MatrixXd, Upper> ldlt;
+        LDLT<MatrixXd, Upper>& ldlt = m_ldlt;
         ldlt.compute(A);
         dx = ldlt.solve(-r);
         
@@ -1365,7 +1743,8 @@ bool MultiPhaseEquilSolver::checkForDeterminedSpecies()
 //==============================================================================
 
 bool MultiPhaseEquilSolver::initialConditions(
-        const double T, const double P, const double* const p_c)
+        const double T, const double P, const double* const p_c,
+        const bool warm)
 {
     DEBUG("entering initialConditions()" << endl)
     const double alpha = 1.0e-3;
@@ -1410,6 +1789,13 @@ bool MultiPhaseEquilSolver::initialConditions(
         return true;
     }
 
+    // A warm start continues from the previous solution, which has a zero
+    // residual for the previous g, to the new g
+    if (warm && !(composition_change || order_change || m_np != 1)) {
+        std::copy(m_solution.g(), m_solution.g()+m_ns, mp_g0);
+        return true;
+    }
+
     // Use the tableau as temporary storage
     double* p_N = mp_tableau;
     double* p_Nbar = p_N + nsr;
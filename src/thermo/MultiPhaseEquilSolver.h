@@ -48,6 +48,17 @@ enum MoleFracDef {
     GLOBAL
 };
 
+/**
+ * Enumerates the pairs of state variables which can be held fixed, along with
+ * the elemental composition, when computing an equilibrium state.
+ */
+enum EquilConstraintType {
+    FIXED_TP, ///< temperature and pressure
+    FIXED_HP, ///< mixture enthalpy (J/kg) and pressure
+    FIXED_SP, ///< mixture entropy (J/kg-K) and pressure
+    FIXED_UV  ///< mixture energy (J/kg) and specific volume (m^3/kg)
+};
+
 
 //==============================================================================
 
@@ -158,6 +169,61 @@ public:
     std::pair<int,int> equilibrate(
         double T, double P, const double *const p_ev, double *const p_sv,
         MoleFracDef mfd = GLOBAL);
+
+    /**
+     * Computes the equilibrium composition and temperature of the mixture at
+     * fixed mixture enthalpy (J/kg) and pressure.  On input, T holds the
+     * initial guess for the temperature and on output the equilibrium
+     * temperature.  Temperature is solved for in the same Newton system as
+     * the element potentials and phase moles.
+     *
+     * @return Same as equilibrate().
+     */
+    std::pair<int,int> equilibrateHP(
+        double h, double P, const double *const p_ev, double *const p_sv,
+        double& T, MoleFracDef mfd = GLOBAL);
+
+    /**
+     * Computes the equilibrium composition and temperature of the mixture at
+     * fixed mixture entropy (J/kg-K) and pressure.
+     * @see equilibrateHP()
+     */
+    std::pair<int,int> equilibrateSP(
+        double s, double P, const double *const p_ev, double *const p_sv,
+        double& T, MoleFracDef mfd = GLOBAL);
+
+    /**
+     * Computes the equilibrium composition, temperature, and pressure of the
+     * mixture at fixed mixture energy (J/kg) and specific volume (m^3/kg).  On
+     * input, T and P hold the initial guesses for the temperature and pressure.
+     * @see equilibrateHP()
+     */
+    std::pair<int,int> equilibrateUV(
+        double u, double v, const double *const p_ev, double *const p_sv,
+        double& T, double& P, MoleFracDef mfd = GLOBAL);
+
+    /**
+     * Turns warm starts on or off.  When on, equilibrate() continues from the
+     * solution of the last converged call with the same elemental composition
+     * to the new temperature and pressure, instead of starting from new
+     * initial conditions.  Only single phase mixtures are warm started.  The
+     * last solution is discarded, so that the next call always starts from
+     * new initial conditions.
+     */
+    void setWarmStart(bool warm) {
+        m_warm_start = warm;
+        m_have_solution = false;
+    }
+
+    /**
+     * Returns the temperature of the last computed equilibrium state.
+     */
+    double T() const { return m_T; }
+
+    /**
+     * Returns the pressure of the last computed equilibrium state.
+     */
+    double P() const { return m_P; }
     
     /**
      * Adds an additional linear constraint to the equilibrium solver.
@@ -464,6 +530,9 @@ private:
         int* mp_sizes;
         int* mp_sjr;
         int* mp_cir;
+
+        // Ordering information from the last call to setupOrdering()
+        std::vector<int> m_previous_order;
         
         const Thermodynamics& m_thermo;
     };
@@ -482,12 +551,15 @@ private:
     bool checkForDeterminedSpecies();
     
     /**
-     * Sets up the initial conditions of the equilibrium problem.
+     * Sets up the initial conditions of the equilibrium problem.  If warm is
+     * true, the current solution is used as the initial conditions when the
+     * composition and species ordering are unchanged.
      * @return true if a set of initial conditions could be computed, false
      * otherwise
      */
     bool initialConditions(
-        const double T, const double P, const double* const p_c);
+        const double T, const double P, const double* const p_c,
+        const bool warm = false);
 
     /**
      * Computes \f$\bar{N}(0)\f$, \f$\lambda(0)\f$, and \f$\tilde{g}(0)\f$ given
@@ -533,6 +605,45 @@ private:
      */
     void computeResidual(Eigen::VectorXd& r) const;
 
+    /**
+     * Drives the solution to the equilibrium state satisfying the given
+     * constraint type, treating ln(T) (and ln(P) for FIXED_UV) as additional
+     * unknowns in the Newton system.  The initial T and P are used as a
+     * starting point for a fixed (T,P) solution.
+     */
+    std::pair<int,int> equilibrateConstrained(
+        EquilConstraintType type, double a, double b, const double *const p_ev,
+        double *const p_sv, double& T, double& P, MoleFracDef mfd);
+
+    /**
+     * Updates the species Gibbs energies, enthalpies and specific heats at the
+     * given temperature and pressure and recomputes the solution accordingly.
+     */
+    void updateThermoState(double T, double P);
+
+    /**
+     * Computes the residual vector of the augmented system used in
+     * equilibrateConstrained() and returns its (scaled) norm.
+     */
+    double computeAugmentedResidual(
+        EquilConstraintType type, double a, double b, Eigen::VectorXd& r) const;
+
+    /**
+     * Computes the (non-symmetric) Jacobian of the augmented system used in
+     * equilibrateConstrained().
+     */
+    void formAugmentedSystemMatrix(
+        EquilConstraintType type, double a, double b, Eigen::MatrixXd& A) const;
+
+    /**
+     * Computes the per-species weights of the extra constraint equations such
+     * that r = sum_j N_j w_j, along with their partial derivatives with respect
+     * to ln(T) and ln(P).  The second equation is only used for FIXED_UV.
+     */
+    void constraintWeights(
+        EquilConstraintType type, double a, double b, int k,
+        double* const p_w, double* const p_dwdT, double* const p_dwdP) const;
+
     /**
      * Adjusts the phase ordering according to the vapor pressure test and phase
      * rule based on the current (converged) solution parameters.  If a phase
@@ -580,12 +691,27 @@ private:
     double* mp_g;
     double* mp_g0;
     double* mp_c;
+    double* mp_h;
+    double* mp_cp;
     
     bool m_pure_condensed;
     
     int m_niters;
     int m_nnewts;
 
+    // Whether equilibrate() may continue from the last converged solution
+    bool m_warm_start;
+    bool m_have_solution;
+
+    // Work storage for rates() and newton(), kept per instance so that
+    // separate solvers may be used concurrently
+    Eigen::MatrixXd m_H;
+    Eigen::JacobiSVD<Eigen::MatrixXd> m_svd;
+    Eigen::MatrixXd m_A;
+    Eigen::VectorXd m_r;
+    Eigen::VectorXd m_dx;
+    Eigen::LDLT<Eigen::MatrixXd, Eigen::Upper> m_ldlt;
+
 };
 
     } // namespace Thermodynamics
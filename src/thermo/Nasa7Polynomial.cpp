@@ -79,6 +79,26 @@ void Nasa7Polynomial::enthalpy(const double *const p_params, double &h) const
         mp_coefficients[index][5] * p_params[5];
 }
 
+void Nasa7Polynomial::cpAndEnthalpy(
+    const double *const p_cp_params, const double *const p_h_params,
+    double &cp, double &h) const
+{
+    int index = tRange(p_cp_params[0]);
+    
+    cp = mp_coefficients[index][0] +
+         mp_coefficients[index][1] * p_cp_params[0] +
+         mp_coefficients[index][2] * p_cp_params[1] +
+         mp_coefficients[index][3] * p_cp_params[2] +
+         mp_coefficients[index][4] * p_cp_params[3];
+    
+    h = mp_coefficients[index][0] +
+        mp_coefficients[index][1] * p_h_params[1] +
+        mp_coefficients[index][2] * p_h_params[2] +
+        mp_coefficients[index][3] * p_h_params[3] +
+        mp_coefficients[index][4] * p_h_params[4] +
+        mp_coefficients[index][5] * p_h_params[5];
+}
+
 void Nasa7Polynomial::entropy(const double *const p_params, double &s) const
 {
     int index = tRange(p_params[1]);
@@ -135,6 +135,15 @@ public:
      */
     void enthalpy(const double *const p_params, double &h) const;
     
+    /**
+     * Computes Cp/Ru and H/Ru/T together, looking up the temperature range
+     * only once.
+     * @see computeParams()
+     */
+    void cpAndEnthalpy(
+        const double *const p_cp_params, const double *const p_h_params,
+        double &cp, double &h) const;
+    
     /**
      * Computes dimensionless entropy S/Ru.
      * @see computeParams()
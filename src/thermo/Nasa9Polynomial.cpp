@@ -98,6 +98,21 @@ void Nasa9Polynomial::enthalpy(const double *const p_params, double &h) const
         h += mp_coefficients[tr][i] * p_params[i];
 }
 
+void Nasa9Polynomial::cpAndEnthalpy(
+    const double *const p_cp_params, const double *const p_h_params,
+    double &cp, double &h) const
+{
+    int tr = tRange(p_cp_params[3]);
+
+    cp = mp_coefficients[tr][0] * p_cp_params[0];
+    for (int i = 1; i < 7; ++i)
+        cp += mp_coefficients[tr][i] * p_cp_params[i];
+
+    h = mp_coefficients[tr][0] * p_h_params[0];
+    for (int i = 1; i < 8; ++i)
+        h += mp_coefficients[tr][i] * p_h_params[i];
+}
+
 void Nasa9Polynomial::entropy(const double *const p_params, double &s) const
 {
     int tr = tRange(p_params[3]);
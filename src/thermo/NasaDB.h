@@ -67,6 +67,11 @@ public:
         double* const h, double* const ht, double* const hr, double* const hv, 
         double* const hel, double* const hf);
     
+    /**
+     * Computes the species Cp/Ru and H/Ru/T in one pass over the species.
+     */
+    void cpAndEnthalpy(double T, double* const p_cp, double* const p_h);
+
     void entropy(
         double Th, double Te, double Tr, double Tv, double Tel, double P,
         double* const s, double* const st, double* const sr, double* const sv, 
@@ -97,6 +102,7 @@ private:
     size_t m_ns;
     std::vector<PolynomialType> m_polynomials;
     double mp_params[8];
+    double mp_h_params[8];
 };
 
 template <typename PolynomialType>
@@ -137,6 +143,16 @@ void NasaDB<PolynomialType>::enthalpy(
     if (hf != NULL) std::fill(hf, hf+m_ns, 0.0);      
 }
 
+template <typename PolynomialType>
+void NasaDB<PolynomialType>::cpAndEnthalpy(
+    double T, double* const p_cp, double* const p_h)
+{
+    PolynomialType::computeParams(T, mp_params, PolynomialType::CP);
+    PolynomialType::computeParams(T, mp_h_params, PolynomialType::ENTHALPY);
+    for (size_t i = 0; i < m_ns; ++i)
+        m_polynomials[i].cpAndEnthalpy(mp_params, mp_h_params, p_cp[i], p_h[i]);
+}
+
 template <typename PolynomialType>
 void NasaDB<PolynomialType>::entropy(
     double Th, double Te, double Tr, double Tv, double Tel, double P,
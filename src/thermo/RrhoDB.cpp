@@ -34,6 +34,8 @@
 #include "LookupTable.h"
 #include "Utilities.h"
 
+#include <Eigen/Dense>
+
 #include <iostream>
 #include <cstdlib>
 #include <cmath>
@@ -42,6 +44,7 @@
 using namespace std;
 using namespace Mutation::Numerics;
 using namespace Mutation::Utilities;
+using namespace Eigen;
 
 namespace Mutation {
     namespace Thermodynamics {
@@ -81,19 +84,26 @@ typedef struct {
     double linearity;   // L / 2
 } RotData;
 
-typedef struct {
-    double g;           // degeneracy
-    double theta;       // characteristic temperature
-} ElecLevel;
-
+// The electronic levels of all the heavy species are stored contiguously, so
+// that the Boltzmann factors of all the levels are computed at once
 typedef struct {
     unsigned int offset;
     unsigned int nheavy;
     unsigned int nlevels;
-    int* p_nelec;
-    ElecLevel* p_levels;
+    int* p_nelec;       // number of levels of each heavy species
+    int* p_first;       // index of the first level of each heavy species
+    double* p_g;        // degeneracies
+    double* p_theta;    // characteristic temperatures
+    double* p_work;     // work array for the Boltzmann factors
 } ElectronicData;
 
+typedef struct {
+    unsigned int nmolecules;
+    const int* p_nvib;
+    const double* p_vib_temps;
+    const ElectronicData* p_elec;
+} InternalData;
+
 
 /**
  * A thermodynamic database that uses the Rigid-Rotator Harmonic-Oscillator
@@ -108,7 +118,16 @@ public:
         : ThermoDB(298.15, 101325.0), m_ns(0), m_na(0), m_nm(0),
           m_has_electron(false),
           m_use_tables(true),
-          m_last_bfacs_T(0.0)
+          m_last_vib_exp_T(0.0),
+          mp_el_bfac_table(NULL),
+          m_last_bfacs_T(0.0),
+          m_use_int_tables(false),
+          mp_int_table(NULL),
+          mp_int_values(NULL),
+          m_int_table_error(0.0),
+          m_last_vib_T(0.0),
+          m_last_el_T(0.0),
+          m_bracket_T(0.0)
     { }
     
     /**
@@ -121,16 +140,58 @@ public:
         delete [] mp_indices;
         delete [] mp_rot_data;
         delete [] mp_nvib;
+        delete [] mp_vib_first;
         delete [] mp_vib_temps;
         
         delete [] m_elec_data.p_nelec;
-        delete [] m_elec_data.p_levels;
+        delete [] m_elec_data.p_first;
+        delete [] m_elec_data.p_g;
+        delete [] m_elec_data.p_theta;
+        delete [] m_elec_data.p_work;
         delete [] mp_part_sst;
         delete [] mp_el_bfacs;
         
-        if (m_use_tables) {
-            delete mp_el_bfac_table;
-        }
+        delete mp_el_bfac_table;
+        delete mp_int_table;
+        delete [] mp_int_values;
+    }
+
+    /**
+     * Tabulates the vibrational and electronic specific heats, enthalpies and
+     * entropies of all the species in one table over \f$\ln T\f$.  The
+     * table is only built the first time it is needed for a given error.
+     */
+    void useInternalEnergyTables(bool use, double max_error)
+    {
+        m_use_int_tables = use;
+        if (!use || (mp_int_table != NULL && max_error == m_int_table_error))
+            return;
+
+        const int nfuncs = 3*m_nm + 3*(m_na+m_nm);
+        delete mp_int_table;
+        mp_int_table = new InternalTable(
+            50.0, 50000.0, nfuncs, m_int_data, max_error, LOG_COORDINATE);
+        m_int_table_error = max_error;
+
+        delete [] mp_int_values;
+        mp_int_values = new double [nfuncs];
+        m_last_vib_T = m_last_el_T = m_bracket_T = 0.0;
+    }
+
+    /**
+     * Switches the linear interpolation of the electronic Boltzmann factors
+     * from a table on or off.  The table is used by default, and the factors
+     * are computed exactly when it is off.
+     */
+    void useBoltzmannTable(bool use)
+    {
+        if (use && mp_el_bfac_table == NULL)
+            mp_el_bfac_table = new Mutation::Utilities::LookupTable
+                <double, double, ElecBFacsFunctor>(
+                50.0, 50000.0, 3*(m_na+m_nm), m_elec_data, 0.005);
+
+        m_use_tables = use;
+        m_last_bfacs_T = 0.0;
     }
 
     /**
@@ -326,6 +387,124 @@ public:
         }
     }
     
+    /**
+     * Computes the unitless species \f$C_{P,i}/R_U\f$ and \f$h_i/R_U T\f$ in
+     * thermal equilibrium at T.  The vibrational exponentials and the
+     * electronic Boltzmann factors are evaluated once for both.
+     */
+    void cpAndEnthalpy(double T, double* const p_cp, double* const p_h)
+    {
+        // The tabulated contributions are already interpolated once for both
+        if (useInternalTable(T)) {
+            cp(T, T, T, T, T, p_cp, NULL, NULL, NULL, NULL);
+            enthalpy(T, T, T, T, T, p_h, NULL, NULL, NULL, NULL, NULL);
+            return;
+        }
+
+        // Translation and rotation
+        cpT(p_cp, Eq());
+        cpR(p_cp, PlusEq());
+        hT(T, T, p_h, Eq());
+        hR(T, p_h, PlusEq());
+
+        // Vibration, with fac = 1/(exp(theta/T)-1)
+        updateVibExponentials(T);
+        m_vib_work = (m_vib_exp - 1.0).inverse();
+        double x;
+        LOOP_MOLECULES(
+            for (int k = mp_vib_first[i]; k < mp_vib_first[i]+mp_nvib[i]; ++k) {
+                x = mp_vib_temps[k] / T;
+                p_cp[j] += x*x*m_vib_exp(k)*m_vib_work(k)*m_vib_work(k);
+                if (T >= 10.0)
+                    p_h[j] += mp_vib_temps[k]*m_vib_work(k);
+            }
+        )
+
+        // Electronic excitation
+        updateElecBoltzmannFactors(T);
+        addElectronic(T, mp_el_bfacs, p_cp, p_h);
+
+        // Formation
+        hF(p_h, PlusEq());
+        LOOP(p_h[i] /= T);
+    }
+
+    /**
+     * Computes cpAndEnthalpy() at n temperatures at once.  The vibrational
+     * exponentials and electronic Boltzmann factors of all the temperatures
+     * are computed in single array expressions, and reduced per species for
+     * every temperature together.
+     */
+    void batchCpAndEnthalpy(
+        int n, const double* const p_T, double* const p_cp, double* const p_h)
+    {
+        // Tabulated internal energies are interpolated one temperature at a
+        // time
+        if (m_use_int_tables) {
+            ThermoDB::batchCpAndEnthalpy(n, p_T, p_cp, p_h);
+            return;
+        }
+
+        Map<const ArrayXd> T(p_T, n);
+        Map<ArrayXXd> cp(p_cp, m_ns, n);
+        Map<ArrayXXd> h(p_h, m_ns, n);
+
+        // Translation, rotation and formation
+        for (int k = 0; k < n; ++k) {
+            cpT(&cp(0,k), Eq());
+            cpR(&cp(0,k), PlusEq());
+            hT(p_T[k], p_T[k], &h(0,k), Eq());
+            hR(p_T[k], &h(0,k), PlusEq());
+            hF(&h(0,k), PlusEq());
+        }
+
+        // Vibration, one row per mode and one column per temperature
+        const ArrayXd invT = T.inverse();
+        if (m_nm > 0) {
+            const ArrayXXd x = vibTemps().matrix() * invT.matrix().transpose();
+            const ArrayXXd e = x.exp();
+            const ArrayXXd fac = (e - 1.0).inverse();
+            const ArrayXXd cpv = x.square() * e * fac.square();
+            const ArrayXXd hv = fac.colwise() * vibTemps();
+            const ArrayXd hmask = (T >= 10.0).cast<double>();
+            LOOP_MOLECULES(
+                cp.row(j) += cpv.middleRows(
+                    mp_vib_first[i], mp_nvib[i]).colwise().sum();
+                h.row(j) += hv.middleRows(
+                    mp_vib_first[i], mp_nvib[i]).colwise().sum() *
+                    hmask.transpose();
+            )
+        }
+
+        // Electronic excitation, from the Boltzmann factor sums of each
+        // temperature
+        ArrayXXd bfacs(3*m_elec_data.nheavy, n);
+        if (m_use_tables) {
+            for (int k = 0; k < n; ++k)
+                mp_el_bfac_table->lookup(p_T[k], &bfacs(0,k));
+        } else {
+            const int nl = m_elec_data.nlevels;
+            Map<const ArrayXd> g(m_elec_data.p_g, nl);
+            Map<const ArrayXd> theta(m_elec_data.p_theta, nl);
+            const ArrayXXd fac = (-(theta.matrix() *
+                invT.matrix().transpose()).array()).exp().colwise() * g;
+            for (unsigned int i = 0; i < m_elec_data.nheavy; ++i) {
+                const int first = m_elec_data.p_first[i];
+                const int nli = m_elec_data.p_nelec[i];
+                const ArrayXXd f = fac.middleRows(first, nli);
+                const ArrayXd th = theta.segment(first, nli);
+                bfacs.row(3*i+0) = f.colwise().sum();
+                bfacs.row(3*i+1) = (f.colwise() * th).colwise().sum();
+                bfacs.row(3*i+2) = (f.colwise() * th.square()).colwise().sum();
+            }
+        }
+
+        for (int k = 0; k < n; ++k) {
+            addElectronic(p_T[k], &bfacs(0,k), &cp(0,k), &h(0,k));
+            h.col(k) /= p_T[k];
+        }
+    }
+
 //    void hv(double Tv, double* const p_hv)
 //    {
 //        int ilevel = 0;
@@ -469,25 +648,71 @@ private:
         void operator () (
             double T, double* p_f, const DataProvider& data, const OP& op) const
         {
-            double fac;
-            int ilevel = 0;
+            const int n = data.nlevels;
+            Map<const ArrayXd> g(data.p_g, n);
+            Map<const ArrayXd> theta(data.p_theta, n);
+            Map<ArrayXd> fac(data.p_work, n);
+
+            // Boltzmann factors of all the levels at once
+            fac = g * (-theta / T).exp();
 
+            // Sums over the levels of each species
             for (unsigned int i = 0; i < data.nheavy; ++i) {
-                p_f[3*i+0] = 0.0;
-                p_f[3*i+1] = 0.0;
-                p_f[3*i+2] = 0.0;
-
-                for (int k = 0; k < data.p_nelec[i]; ++k, ilevel++) {
-                    fac = data.p_levels[ilevel].g *
-                        std::exp(-data.p_levels[ilevel].theta / T);
-                    p_f[3*i+0] += fac;
-                    p_f[3*i+1] += fac * data.p_levels[ilevel].theta;
-                    p_f[3*i+2] += fac * data.p_levels[ilevel].theta *
-                        data.p_levels[ilevel].theta;
+                const int first = data.p_first[i];
+                const int nl = data.p_nelec[i];
+                p_f[3*i+0] = fac.segment(first, nl).sum();
+                p_f[3*i+1] =
+                    (fac.segment(first, nl) * theta.segment(first, nl)).sum();
+                p_f[3*i+2] = (fac.segment(first, nl) *
+                    theta.segment(first, nl).square()).sum();
+            }
+        }
+    };
+
+    /**
+     * Computes the vibrational \f$C_P/R_U\f$, \f$h/R_U\f$ (in K) and
+     * \f$s/R_U\f$ of each molecule followed by the same electronic
+     * quantities of each heavy particle.
+     */
+    class InternalFunctor
+    {
+    public:
+        typedef InternalData DataProvider;
+
+        void operator() (double T, double* p_f, const DataProvider& data) const
+        {
+            int ilevel = 0;
+            double x, fac;
+
+            // Vibration, with fac = 1/(exp(theta/T)-1)
+            for (unsigned int i = 0; i < data.nmolecules; ++i, p_f += 3) {
+                p_f[0] = p_f[1] = p_f[2] = 0.0;
+                for (int k = 0; k < data.p_nvib[i]; ++k, ilevel++) {
+                    x = data.p_vib_temps[ilevel] / T;
+                    fac = 1.0 / (std::exp(x) - 1.0);
+                    p_f[0] += x*x*fac*(1.0 + fac);
+                    p_f[1] += data.p_vib_temps[ilevel]*fac;
+                    p_f[2] += x*fac + std::log(1.0 + fac);
                 }
             }
+
+            // Electronic excitation, from the Boltzmann factor sums
+            const ElectronicData& elec = *data.p_elec;
+            ElecBFacsFunctor()(T, p_f, elec);
+
+            double f0, f1, f2;
+            for (unsigned int i = 0; i < elec.nheavy; ++i, p_f += 3) {
+                f0 = p_f[0]; f1 = p_f[1]; f2 = p_f[2];
+                p_f[0] = (elec.p_nelec[i] > 1 ?
+                    (f2*f0 - f1*f1)/(T*T*f0*f0) : 0.0);
+                p_f[1] = (f0 > 0 ? f1/f0 : 0.0);
+                p_f[2] = (f0 > 0 ? f1/(f0*T) + std::log(f0) : 0.0);
+            }
         }
     };
+
+    typedef Mutation::Utilities::UniformLookupTable<double, InternalFunctor>
+        InternalTable;
     
 protected:
 
@@ -614,13 +839,17 @@ protected:
             nvib += mp_nvib[i];
         )
         
+        mp_vib_first = new int [m_nm];
         mp_vib_temps = new double [nvib];
         int itemp = 0;
         LOOP_MOLECULES(
             const ParticleRRHO& rrho = rrhos[j];
+            mp_vib_first[i] = itemp;
             for (int k = 0; k < mp_nvib[i]; ++k, itemp++)
                 mp_vib_temps[itemp] = rrho.vibrationalEnergy(k);
         )
+        m_vib_exp.resize(nvib);
+        m_vib_work.resize(nvib);
         
         // Finally store the electronic energy levels in a compact form like the
         // vibrational energy levels
@@ -631,29 +860,33 @@ protected:
             m_elec_data.nlevels += m_elec_data.p_nelec[i];
         )
         
-        m_elec_data.p_levels = new ElecLevel [m_elec_data.nlevels];
+        m_elec_data.p_first = new int [m_na + m_nm];
+        m_elec_data.p_g     = new double [m_elec_data.nlevels];
+        m_elec_data.p_theta = new double [m_elec_data.nlevels];
+        m_elec_data.p_work  = new double [m_elec_data.nlevels];
         int ilevel = 0;
         LOOP_HEAVY(
             const ParticleRRHO& rrho = rrhos[j];
+            m_elec_data.p_first[i] = ilevel;
             for (int k = 0; k < m_elec_data.p_nelec[i]; ++k, ilevel++) {
-                m_elec_data.p_levels[ilevel].g =
-                    rrho.electronicEnergy(k).first;
-                m_elec_data.p_levels[ilevel].theta = 
-                    rrho.electronicEnergy(k).second;
+                m_elec_data.p_g[ilevel]     = rrho.electronicEnergy(k).first;
+                m_elec_data.p_theta[ilevel] = rrho.electronicEnergy(k).second;
             }
-        )        
+        )
         
         m_elec_data.offset = (m_has_electron ? 1 : 0);
         m_elec_data.nheavy = m_na + m_nm;
         
-        if (m_use_tables) {
-            mp_el_bfac_table = new Mutation::Utilities::LookupTable
-                <double, double, ElecBFacsFunctor>(
-                50.0, 50000.0, 3*(m_na+m_nm), m_elec_data, 0.005);
-        }
+        useBoltzmannTable(m_use_tables);
         
         mp_el_bfacs = new double [3*(m_na+m_nm)];
 
+        // Data used to tabulate the internal energy contributions
+        m_int_data.nmolecules  = m_nm;
+        m_int_data.p_nvib      = mp_nvib;
+        m_int_data.p_vib_temps = mp_vib_temps;
+        m_int_data.p_elec      = &m_elec_data;
+
         // Compute the contribution of the partition functions at the standard
         // state temperature to the species enthalpies
         mp_part_sst = new double [m_ns];
@@ -679,6 +912,78 @@ private:
         m_last_bfacs_T = T;
     }
 
+    /**
+     * Computes \f$\exp(\theta_k/T)\f$ of all the vibrational modes at once,
+     * unless they were last computed at T.
+     */
+    void updateVibExponentials(double T)
+    {
+        if (T == m_last_vib_exp_T)
+            return;
+
+        m_vib_exp = (vibTemps() / T).exp();
+        m_last_vib_exp_T = T;
+    }
+
+    /**
+     * Returns the characteristic temperatures of all the vibrational modes.
+     */
+    Map<const ArrayXd> vibTemps() const {
+        return Map<const ArrayXd>(mp_vib_temps, m_vib_exp.size());
+    }
+
+    /**
+     * Returns the sum of the given values over the vibrational modes of
+     * molecule i.
+     */
+    double vibSum(int i, const ArrayXd& values) const {
+        return values.segment(mp_vib_first[i], mp_nvib[i]).sum();
+    }
+
+    /**
+     * Returns true if the internal energy contributions at T are interpolated
+     * from the internal energy table.
+     */
+    bool useInternalTable(double T) const
+    {
+        return m_use_int_tables && T >= mp_int_table->minIndex() &&
+            T <= mp_int_table->maxIndex();
+    }
+
+    /**
+     * Interpolates the internal energy functions [start, end) at T unless
+     * they were last interpolated at T.  The bracket in the table is shared by
+     * all the functions interpolated at the same temperature.
+     */
+    void updateInternalValues(double T, int start, int end, double& last_T)
+    {
+        if (T == last_T)
+            return;
+
+        if (T != m_bracket_T) {
+            m_bracket = mp_int_table->bracket(T);
+            m_bracket_T = T;
+        }
+
+        mp_int_table->lookup(m_bracket, start, end, mp_int_values, Eq());
+        last_T = T;
+    }
+
+    /**
+     * Updates the tabulated vibrational (cp, h, s) of the molecules at T.
+     */
+    void updateVibValues(double T) {
+        updateInternalValues(T, 0, 3*m_nm, m_last_vib_T);
+    }
+
+    /**
+     * Updates the tabulated electronic (cp, h, s) of the heavy species at T.
+     */
+    void updateElecValues(double T) {
+        updateInternalValues(
+            T, 3*m_nm, 3*m_nm + 3*m_elec_data.nheavy, m_last_el_T);
+    }
+
     
     /**
      * Computes the translational Cp/Ru for each species.
@@ -703,21 +1008,21 @@ private:
      */
     template <typename OP>
     void cpV(double Tv, double* const cp, const OP& op) {
-        int ilevel = 0;
-        double sum, fac1, fac2;
+        if (useInternalTable(Tv)) {
+            updateVibValues(Tv);
+            op(cp[0], 0.0);
+            LOOP_ATOMS(op(cp[j], 0.0));
+            LOOP_MOLECULES(op(cp[j], mp_int_values[3*i]));
+            return;
+        }
+
+        updateVibExponentials(Tv);
+        m_vib_work = (vibTemps() / Tv).square() * m_vib_exp /
+            (m_vib_exp - 1.0).square();
+
         op(cp[0], 0.0);
         LOOP_ATOMS(op(cp[j], 0.0));
-        LOOP_MOLECULES(
-            sum = 0.0;
-            for (int k = 0; k < mp_nvib[i]; ++k, ilevel++) {
-                fac1 = mp_vib_temps[ilevel] / Tv;
-                fac2 = std::exp(fac1);
-                fac1 *= fac1*fac2;
-                fac2 -= 1.0;
-                sum += fac1/(fac2*fac2);
-            }
-            op(cp[j], sum);
-        )
+        LOOP_MOLECULES(op(cp[j], vibSum(i, m_vib_work)));
     }
 
     /**
@@ -727,6 +1032,15 @@ private:
     template <typename OP>
     void cpE(double T, double* const p_cp, const OP& op)
     {
+        if (useInternalTable(T)) {
+            updateElecValues(T);
+            op(p_cp[0], 0.0);
+            const double* const p_el = mp_int_values + 3*m_nm;
+            for (unsigned int i = 0; i < m_elec_data.nheavy; ++i)
+                op(p_cp[i+m_elec_data.offset], p_el[3*i]);
+            return;
+        }
+
         updateElecBoltzmannFactors(T);
         op(p_cp[0], 0.0);
 
@@ -764,18 +1078,15 @@ private:
      */
     template <typename OP>
     void hV(double T, double* const h, const OP& op) {
-        if (T < 10.0) {
+        if (useInternalTable(T)) {
+            updateVibValues(T);
+            LOOP_MOLECULES(op(h[j], mp_int_values[3*i+1]));
+        } else if (T < 10.0) {
             LOOP_MOLECULES(op(h[j], 0.0));
         } else {
-            int ilevel = 0;
-            double sum;
-            LOOP_MOLECULES(
-                sum = 0.0;
-                for (int k = 0; k < mp_nvib[i]; ++k, ilevel++)
-                    sum += mp_vib_temps[ilevel] /
-                        (std::exp(mp_vib_temps[ilevel] / T) - 1.0);
-                op(h[j], sum);
-            )
+            updateVibExponentials(T);
+            m_vib_work = vibTemps() / (m_vib_exp - 1.0);
+            LOOP_MOLECULES(op(h[j], vibSum(i, m_vib_work)));
         }
     }
     
@@ -786,6 +1097,15 @@ private:
     template <typename OP>
     void hE(double T, double* const p_h, const OP& op)
     {
+        if (useInternalTable(T)) {
+            updateElecValues(T);
+            op(p_h[0], 0.0);
+            const double* const p_el = mp_int_values + 3*m_nm;
+            for (unsigned int i = 0; i < m_elec_data.nheavy; ++i)
+                op(p_h[i+m_elec_data.offset], p_el[3*i+1]);
+            return;
+        }
+
         updateElecBoltzmannFactors(T);
         op(p_h[0], 0.0);
 
@@ -798,6 +1118,24 @@ private:
         }
     }
     
+    /**
+     * Adds the electronic Cp/Ru and enthalpy in K of each species at T, given
+     * the Boltzmann factor sums at T.
+     */
+    void addElectronic(
+        double T, const double* facs, double* const p_cp, double* const p_h)
+    {
+        int j;
+        for (unsigned int i = 0; i < m_elec_data.nheavy; ++i, facs += 3) {
+            j = i + m_elec_data.offset;
+            if (m_elec_data.p_nelec[i] > 1)
+                p_cp[j] +=
+                    (facs[2]*facs[0]-facs[1]*facs[1])/(T*T*facs[0]*facs[0]);
+            if (facs[0] > 0)
+                p_h[j] += facs[1]/facs[0];
+        }
+    }
+
     /**
      * Computes the formation enthalpy of each species in K.
      */
@@ -835,17 +1173,16 @@ private:
      */
     template <typename OP>
     void sV(double T, double* const s, const OP& op) {
-        int ilevel = 0;
-        double fac, sum1, sum2;
-        LOOP_MOLECULES(
-            sum1 = sum2 = 0.0;
-            for (int k = 0; k < mp_nvib[i]; ++k, ilevel++) {
-                fac  =  std::exp(mp_vib_temps[ilevel] / T);
-                sum1 += mp_vib_temps[ilevel] / (fac - 1.0);
-                sum2 += std::log(1.0 - 1.0 / fac);
-            }
-            op(s[j], (sum1 / T - sum2));
-        )
+        if (useInternalTable(T)) {
+            updateVibValues(T);
+            LOOP_MOLECULES(op(s[j], mp_int_values[3*i+2]));
+            return;
+        }
+
+        updateVibExponentials(T);
+        m_vib_work = vibTemps() / (T * (m_vib_exp - 1.0)) -
+            (1.0 - m_vib_exp.inverse()).log();
+        LOOP_MOLECULES(op(s[j], vibSum(i, m_vib_work)));
     }
     
     /**
@@ -853,6 +1190,15 @@ private:
      */
     template <typename OP>
     void sE(double T, double* const p_s, const OP& op) {
+        if (useInternalTable(T)) {
+            updateElecValues(T);
+            op(p_s[0], 0.0);
+            const double* const p_el = mp_int_values + 3*m_nm;
+            for (unsigned int i = 0; i < m_elec_data.nheavy; ++i)
+                op(p_s[i+m_elec_data.offset], p_el[3*i+2]);
+            return;
+        }
+
         updateElecBoltzmannFactors(T);
         op(p_s[0], 0.0);
 
@@ -883,16 +1229,27 @@ private:
     RotData*   mp_rot_data;
     
     int*       mp_nvib;
+    int*       mp_vib_first;
     double*    mp_vib_temps;
+    ArrayXd    m_vib_exp;
+    ArrayXd    m_vib_work;
+    double     m_last_vib_exp_T;
     
     ElectronicData m_elec_data;
     Mutation::Utilities::LookupTable<double, double, ElecBFacsFunctor>* mp_el_bfac_table;
     double* mp_el_bfacs;
     double m_last_bfacs_T;
 
-    //Mutation::Utilities::LookupTable<double, double, HelFunctor>* mp_hel_table;
-    //Mutation::Utilities::LookupTable<double, double, SelFunctor>* mp_sel_table;
-    //Mutation::Utilities::LookupTable<double, double, CpelFunctor>* mp_cpel_table;
+    // Tabulated vibrational and electronic cp, h, and s
+    bool m_use_int_tables;
+    InternalData m_int_data;
+    InternalTable* mp_int_table;
+    double* mp_int_values;
+    double m_int_table_error;
+    double m_last_vib_T;
+    double m_last_el_T;
+    InternalTable::Bracket m_bracket;
+    double m_bracket_T;
 
 }; // class RrhoDB
 
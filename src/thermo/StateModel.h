@@ -32,6 +32,8 @@
 #include "Kinetics.h"
 #include "TransferModel.h"
 
+#include <limits>
+
 namespace Mutation {
     namespace Thermodynamics {
 
@@ -44,6 +46,17 @@ class Transport;
  * @{
  */
 
+/**
+ * Convergence information of the last solution of the energy equations by a
+ * StateModel.
+ */
+struct EnergySolveStats
+{
+    int iterations;  ///< number of Newton iterations
+    double residual; ///< norm of the energy equation residuals
+    bool converged;  ///< true if the tolerance was met
+};
+
 /**
  * Base class for all state models.  A mixture state is completely determined
  * when enough thermodynamic values are combined with the mixture composition
@@ -77,10 +90,14 @@ public:
      * @param nmass - number od mass equations
      */
     StateModel(ARGS thermo, const int nenergy, const int nmass)
-        : m_thermo(thermo), m_nenergy(nenergy), m_nmass(nmass)
+        : m_thermo(thermo), m_nenergy(nenergy), m_nmass(nmass),
+          mp_transfer_context(NULL)
     {
         m_T = m_Tr = m_Tv = m_Tel = m_Te = 300.0;
         m_P = 0.0;
+        m_energy_stats.iterations = 0;
+        m_energy_stats.residual = 0.0;
+        m_energy_stats.converged = true;
         mp_X = new double [m_thermo.nSpecies()];
         for (int i = 0; i < thermo.nSpecies(); ++i)
             mp_X[i] = 0.0;
@@ -97,6 +114,7 @@ public:
         // Delete transfer models
         for (int i = 0; i < m_transfer_models.size(); ++i)
             delete m_transfer_models[i].second;
+        delete mp_transfer_context;
     }
     
     /**
@@ -208,6 +226,91 @@ public:
         throw NotImplementedError("StateModel::getTemperatures()");
     }
 
+    /**
+     * Sets the temperatures, ordered as in getTemperatures(), from which the
+     * energy equations are solved by the next call to setState().  By
+     * default, the temperatures of the previous state are used.  The guess is
+     * only a hint, which models that do not use one ignore.
+     */
+    virtual void setInitialTemperatures(const double* const p_T) { }
+
+    /**
+     * Returns the convergence information of the energy equations solved by
+     * the last call to setState() with energy variables.
+     */
+    const EnergySolveStats& energySolveStats() const {
+        return m_energy_stats;
+    }
+
+    /**
+     * Solves the energy equations of n cells, as setState() with variable set
+     * 0 would do for each of them, starting from the temperatures in p_T.
+     * The default implementation sets the state of each cell in turn, so that
+     * the state model is left in the state of the last cell, and shares no
+     * work between the cells.  In thermal equilibrium,
+     * Thermodynamics::getTFromRhoE() solves the cells in lockstep instead.
+     *
+     * @param n       number of cells
+     * @param p_rhoi  species densities (n x nMassEqns, row major)
+     * @param p_rhoe  energy densities (n x nEnergyEqns, row major)
+     * @param p_T     initial temperatures on input, solution on output, with
+     *                the layout of getTemperatures() (n x nEnergyEqns)
+     * @param p_stats (optional) on return, convergence information of each
+     *                cell (n)
+     *
+     * @return the number of cells which did not converge
+     */
+    virtual int batchSolveEnergies(
+        int n, const double* const p_rhoi, const double* const p_rhoe,
+        double* const p_T, EnergySolveStats* const p_stats = NULL)
+    {
+        int nfailed = 0;
+
+        for (int c = 0; c < n; ++c) {
+            setInitialTemperatures(p_T+c*m_nenergy);
+            setState(p_rhoi+c*m_nmass, p_rhoe+c*m_nenergy, 0);
+            getTemperatures(p_T+c*m_nenergy);
+
+            if (!m_energy_stats.converged) nfailed++;
+            if (p_stats != NULL) p_stats[c] = m_energy_stats;
+        }
+
+        return nfailed;
+    }
+
+    /**
+     * Performs one safeguarded Newton update of T for the increasing function
+     * f(T) of an energy equation, given \f$f\f$ and \f$f'\f$ at T.  The
+     * root is kept bracketed in [T_lo, T_hi], which should be initialized to
+     * [50 K, infinity], and a bisection of the bracket replaces any Newton
+     * step which leaves it.  Returns false if \f$f > 0\f$ at 50 K, in which
+     * case the energy is too low for the species densities.
+     */
+    static bool safeguardedNewtonStep(
+        const double f, const double fp, double& T, double& T_lo, double& T_hi)
+    {
+        const double T_min = 50.0;
+
+        if (f > 0.0) {
+            if (T <= T_min)
+                return false;
+            T_hi = T;
+        } else
+            T_lo = T;
+
+        const double T_new = T - f/fp;
+        if (T_new > T_lo && T_new < T_hi)
+            T = T_new;
+        else if (f > 0.0 && T_lo == T_min)
+            T = T_min;
+        else if (T_hi < std::numeric_limits<double>::infinity())
+            T = 0.5*(T_lo + T_hi);
+        else
+            T = 2.0*T;
+
+        return true;
+    }
+
     /**
      * Returns a vector of length n_species times n_energies with each corresponding
 	 * energy per unit mass.  The first n_species values correspond to the total energy
@@ -268,17 +371,50 @@ public:
     /**
      * This function provides the total energy transfer source terms
      *
+     * If the species production rates at the current state are already
+     * known, they can be given in p_wdot to avoid computing them again.
+     *
      * @todo loop over all energy equations making the source term
      * for the total energy equal to zero
      */
-    virtual void energyTransferSource(double* const p_omega)
+    virtual void energyTransferSource(
+        double* const p_omega, const double* const p_wdot = NULL)
     {
         for (int i = 0; i < m_nenergy-1; ++i)
             p_omega[i] = 0.0;
 
+        if (m_transfer_models.empty())
+            return;
+
+        // The quantities shared by the terms are computed at most once
+        mp_transfer_context->reset(p_wdot);
         for (int i = 0; i < m_transfer_models.size(); ++i)
             p_omega[m_transfer_models[i].first] +=
-                m_transfer_models[i].second->source();
+                m_transfer_models[i].second->source(*mp_transfer_context);
+    }
+
+    /**
+     * Provides the Jacobian of the energy transfer source terms.  Row i of
+     * p_jac, of length ns + nEnergyEqns, holds the derivatives of the source
+     * term of energy equation i+1 with respect to the species densities,
+     * T and Tv as described in Mutation::Transfer::TransferModel::jacobian().
+     * The matrix is stored in row major order.
+     */
+    virtual void energyTransferJacobian(double* const p_jac)
+    {
+        const int ns = m_thermo.nSpecies();
+        const int ncols = ns + m_nenergy;
+        std::fill(p_jac, p_jac + (m_nenergy-1)*ncols, 0.0);
+
+        // Only the two-temperature model has transfer terms, for which the
+        // columns match the derivatives of each term
+        m_transfer_jac.resize(ns+2);
+        for (int i = 0; i < m_transfer_models.size(); ++i) {
+            m_transfer_models[i].second->jacobian(&m_transfer_jac[0]);
+            double* const p_row = p_jac + m_transfer_models[i].first*ncols;
+            for (int j = 0; j < ns+2; ++j)
+                p_row[j] += m_transfer_jac[j];
+        }
     }
     
 protected:
@@ -292,6 +428,10 @@ protected:
         assert(i >= 0);
         assert(i < m_nenergy-1);
         m_transfer_models.push_back(std::make_pair(i, p_term));
+
+        if (mp_transfer_context == NULL)
+            mp_transfer_context =
+                new Mutation::Transfer::TransferContext(p_term->mixture());
     }
 
     /**
@@ -387,6 +527,66 @@ protected:
         return true;
     }
 
+    /**
+     * Solves the same energy equation as getTFromRhoE(cp, h, ...) with a
+     * safeguarded Newton method, using a provider cph(T, p_cp, p_h) which
+     * computes the species \f$C_{p,i}/R_u\f$ and \f$H_i/R_uT\f$ together so
+     * that each iteration needs a single thermodynamic evaluation.
+     *
+     * @see safeguardedNewtonStep()
+     */
+    template <typename CpHProvider>
+    bool getTFromRhoE(
+        const CpHProvider& cph,
+        const double rhoe,
+        double& T,
+        double* const p_cp,
+        double* const p_h,
+        const double alpha = 0.0,
+        const double atol = 1.0e-12,
+        const double rtol = 1.0e-12,
+        const int max_iters = 100)
+    {
+        const int ns = m_thermo.nSpecies();
+        const double rhoe_over_Ru = rhoe/RU;
+        const double tol = rtol*std::abs(rhoe_over_Ru) + atol;
+
+        double T_lo = 50.0;
+        double T_hi = std::numeric_limits<double>::infinity();
+        double f, fp;
+
+        T = std::max(T, T_lo);
+        for (int iter = 0; ; ++iter) {
+            cph(T, p_cp, p_h);
+            f = fp = alpha;
+            for (int i = 0; i < ns; ++i) {
+                f  += mp_X[i]*p_h[i];
+                fp += mp_X[i]*p_cp[i];
+            }
+            f = T*f - rhoe_over_Ru;
+
+            m_energy_stats.iterations = iter;
+            m_energy_stats.residual = std::abs(f);
+            m_energy_stats.converged = (std::abs(f) <= tol);
+
+            if (m_energy_stats.converged)
+                return true;
+
+            if (iter == max_iters) {
+                std::cerr << "Exceeded max iterations when computing temperature!\n";
+                std::cerr << "res = " << f / rhoe_over_Ru << ", T = " << T << std::endl;
+                return false;
+            }
+
+            if (!safeguardedNewtonStep(f, fp, T, T_lo, T_hi)) {
+                m_energy_stats.converged = false;
+                std::cerr << "Clamping T at 50 K, energy is too low for the "
+                     << "given species densities..." << std::endl;
+                return false;
+            }
+        }
+    }
+
 protected:
 
     const Thermodynamics& m_thermo;
@@ -402,10 +602,14 @@ protected:
     double m_B;
     
     double* mp_X;
+
+    EnergySolveStats m_energy_stats;
     
 
     std::vector< std::pair<int, Mutation::Transfer::TransferModel*> >
         m_transfer_models;
+    std::vector<double> m_transfer_jac;
+    Mutation::Transfer::TransferContext* mp_transfer_context;
 private:
 
 
@@ -153,6 +153,24 @@ void ThermoDB::cv(
 
 //==============================================================================
 
+void ThermoDB::cpAndEnthalpy(double T, double* const p_cp, double* const p_h)
+{
+    cp(T, T, T, T, T, p_cp, NULL, NULL, NULL, NULL);
+    enthalpy(T, T, T, T, T, p_h, NULL, NULL, NULL, NULL, NULL);
+}
+
+//==============================================================================
+
+void ThermoDB::batchCpAndEnthalpy(
+    int n, const double* const p_T, double* const p_cp, double* const p_h)
+{
+    const size_t ns = m_species.size();
+    for (int i = 0; i < n; ++i)
+        cpAndEnthalpy(p_T[i], p_cp+i*ns, p_h+i*ns);
+}
+
+//==============================================================================
+
 void ThermoDB::cpv(double T, double* const p_cp)
 {
     throw NotImplementedError("ThermoDB::cpv()");
@@ -181,6 +199,20 @@ void ThermoDB::hel(double T, double* const p_h)
 
 //==============================================================================
 
+void ThermoDB::useInternalEnergyTables(bool use, double max_error)
+{
+    throw NotImplementedError("ThermoDB::useInternalEnergyTables()");
+}
+
+//==============================================================================
+
+void ThermoDB::useBoltzmannTable(bool use)
+{
+    throw NotImplementedError("ThermoDB::useBoltzmannTable()");
+}
+
+//==============================================================================
+
 void ThermoDB::cpint(double T, double* const p_cp) {
     cp(T, T, T, T, T, p_cp);
     Map<ArrayXd>(p_cp, m_species.size()) -= 2.5;
@@ -120,6 +120,23 @@ public:
      */
     virtual void cpint(double T, double* const cp);
 
+    /**
+     * Switches the tabulation of the temperature dependent internal energy
+     * contributions to the species specific heats, enthalpies and entropies
+     * on or off.  When on, these are interpolated from tables built with the
+     * given maximum relative error, and when off they are computed exactly.
+     * The default implementation throws a NotImplementedError.
+     */
+    virtual void useInternalEnergyTables(bool use, double max_error = 1.0e-4);
+
+    /**
+     * Switches the tabulation of the electronic Boltzmann factors on or off.
+     * When on, they are interpolated linearly from a table, and when off they
+     * are computed exactly.  The default implementation throws a
+     * NotImplementedError.
+     */
+    virtual void useBoltzmannTable(bool use);
+
     /**
      * Computes the unitless species specific heats at constant pressure
      * \f$ C_{p,i}/R_U\f$ of each species in thermal nonequilibrium.
@@ -141,6 +158,22 @@ public:
         double* const cpr = NULL, double* const cpv = NULL,
         double* const cpel = NULL) = 0;
     
+    /**
+     * Computes the unitless species specific heats at constant pressure
+     * \f$ C_{p,i}/R_U\f$ and enthalpies \f$ h_i/R_U T\f$ in thermal
+     * equilibrium at T.  The default implementation calls cp() and then
+     * enthalpy().
+     */
+    virtual void cpAndEnthalpy(double T, double* const p_cp, double* const p_h);
+
+    /**
+     * Computes cpAndEnthalpy() at n temperatures, with the species values of
+     * temperature i stored in p_cp[i*ns] and p_h[i*ns].  Databases can
+     * override this to evaluate all the temperatures at once.
+     */
+    virtual void batchCpAndEnthalpy(
+        int n, const double* const p_T, double* const p_cp, double* const p_h);
+
     /**
      * Computes the species vibrational specific heats at the given temperature
      * nondimensionalized by the universal gas constant.
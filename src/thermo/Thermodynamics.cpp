@@ -30,6 +30,7 @@
 #include "Utilities.h"
 #include "Composition.h"
 
+#include <limits>
 #include <set>
 
 using namespace std;
@@ -48,7 +49,7 @@ Thermodynamics::Thermodynamics(
     const string& thermo_db,
     const string& state_model )
     : mp_work1(NULL), mp_work2(NULL), mp_wrkcp(NULL), mp_default_composition(NULL),
-      m_has_electrons(false), m_natoms(0), m_nmolecules(0)
+      m_has_electrons(false), m_natoms(0), m_nmolecules(0), m_state_epoch(1)
 {
     try {
         // Load the thermodynamic database
@@ -180,6 +181,102 @@ void Thermodynamics::setState(
 {
     mp_state->setState(p_v1, p_v2, vars);
     convert<X_TO_Y>(X(), mp_y);
+    m_state_epoch++;
+}
+
+//==============================================================================
+
+void Thermodynamics::setState(
+    const double* const p_v1, const double* const p_v2, const int vars,
+    const double* const p_T)
+{
+    mp_state->setInitialTemperatures(p_T);
+    setState(p_v1, p_v2, vars);
+}
+
+//==============================================================================
+
+int Thermodynamics::getTFromRhoE(
+    int n, const double* const p_rhoi, const double* const p_rhoe,
+    double* const p_T, const double atol, const double rtol,
+    const int max_iters) const
+{
+    const int ns = nSpecies();
+
+    // Species concentrations, energy equation parameters and Newton brackets
+    // of each cell
+    vector<double> conc(n*ns), rhoe(n), tol(n), T_lo(n, 50.0),
+        T_hi(n, numeric_limits<double>::infinity());
+    vector<int> active(n);
+
+    for (int c = 0; c < n; ++c) {
+        for (int i = 0; i < ns; ++i)
+            conc[c*ns+i] = std::max(p_rhoi[c*ns+i] / speciesMw(i), 0.0);
+        rhoe[c] = p_rhoe[c] / RU;
+        tol[c] = rtol*std::abs(rhoe[c]) + atol;
+        p_T[c] = std::max(p_T[c], 50.0);
+        active[c] = c;
+    }
+
+    vector<double> T(n), cp(n*ns), h(n*ns);
+    int nfailed = 0;
+
+    for (int iter = 0; !active.empty(); ++iter) {
+        // Evaluate the unconverged cells together
+        const int na = active.size();
+        for (int k = 0; k < na; ++k)
+            T[k] = p_T[active[k]];
+        mp_thermodb->batchCpAndEnthalpy(na, &T[0], &cp[0], &h[0]);
+
+        int nactive = 0;
+        for (int k = 0; k < na; ++k) {
+            const int c = active[k];
+            const double* const p_X = &conc[c*ns];
+            double f = 0.0, fp = 0.0, sum = 0.0;
+            for (int i = 0; i < ns; ++i) {
+                f   += p_X[i]*h[k*ns+i];
+                fp  += p_X[i]*cp[k*ns+i];
+                sum += p_X[i];
+            }
+            f = T[k]*(f - sum) - rhoe[c];
+            fp -= sum;
+
+            if (std::abs(f) <= tol[c])
+                continue;
+
+            if (iter == max_iters ||
+                !StateModel::safeguardedNewtonStep(
+                    f, fp, p_T[c], T_lo[c], T_hi[c]))
+            {
+                nfailed++;
+                continue;
+            }
+
+            active[nactive++] = c;
+        }
+        active.resize(nactive);
+    }
+
+    return nfailed;
+}
+
+//==============================================================================
+
+int Thermodynamics::batchSolveEnergies(
+    int n, const double* const p_rhoi, const double* const p_rhoe,
+    double* const p_T, EnergySolveStats* const p_stats)
+{
+    const int nfailed =
+        mp_state->batchSolveEnergies(n, p_rhoi, p_rhoe, p_T, p_stats);
+    convert<X_TO_Y>(X(), mp_y);
+    m_state_epoch++;
+    return nfailed;
+}
+
+//==============================================================================
+
+const EnergySolveStats& Thermodynamics::energySolveStats() const {
+    return mp_state->energySolveStats();
 }
 
 //==============================================================================
@@ -309,10 +406,38 @@ std::pair<int, int> Thermodynamics::equilibriumComposition(
 
 //==============================================================================
 
+std::pair<int, int> Thermodynamics::equilibriumCompositionHP(
+    double h, double P, const double* const p_Xe, double* const p_X,
+    double& T, MoleFracDef mdf) const
+{
+    return mp_equil->equilibrateHP(h, P, p_Xe, p_X, T, mdf);
+}
+
+//==============================================================================
+
+std::pair<int, int> Thermodynamics::equilibriumCompositionSP(
+    double s, double P, const double* const p_Xe, double* const p_X,
+    double& T, MoleFracDef mdf) const
+{
+    return mp_equil->equilibrateSP(s, P, p_Xe, p_X, T, mdf);
+}
+
+//==============================================================================
+
+std::pair<int, int> Thermodynamics::equilibriumCompositionUV(
+    double u, double v, const double* const p_Xe, double* const p_X,
+    double& T, double& P, MoleFracDef mdf) const
+{
+    return mp_equil->equilibrateUV(u, v, p_Xe, p_X, T, P, mdf);
+}
+
+//==============================================================================
+
 void Thermodynamics::equilibrate(double T, double P, double* const p_Xe) const
 {
     mp_state->equilibrate(T, P, p_Xe);
     convert<X_TO_Y>(X(), mp_y);
+    m_state_epoch++;
 }
 
 //==============================================================================
@@ -926,6 +1051,14 @@ void Thermodynamics::speciesHOverRT(
 
 //==============================================================================
 
+void Thermodynamics::speciesCpAndHOverRT(
+    double T, double* const p_cp, double* const p_h) const
+{
+    mp_thermodb->cpAndEnthalpy(T, p_cp, p_h);
+}
+
+//==============================================================================
+
 void Thermodynamics::speciesHOverRT(double T, double* const h) const 
 {
     mp_thermodb->enthalpy(
@@ -45,6 +45,7 @@ namespace Mutation {
 
 class StateModel;
 class Composition;
+struct EnergySolveStats;
 
 /**
  * Possible conversion methods that can be used with the 
@@ -307,6 +308,64 @@ public:
      */
     void setState(
         const double* const p_v1, const double* const p_v2, const int vars = 0);
+
+    /**
+     * Sets the state of the mixture like setState(p_v1, p_v2, vars), but
+     * solves the energy equations from the temperatures p_T, ordered as in
+     * getTemperatures(), instead of from the temperatures of the previous
+     * state.  This lets each cell of a flow solver which shares one mixture
+     * start from its own previous temperatures.
+     */
+    void setState(
+        const double* const p_v1, const double* const p_v2, const int vars,
+        const double* const p_T);
+
+    /**
+     * Computes the temperatures of n cells in thermal equilibrium from their
+     * species densities and static energy densities, solving the same energy
+     * equation as setState() with variable set 0 in the ChemNonEq1T state
+     * model.  The Newton iterations of all the cells proceed together, so
+     * that the thermodynamic database evaluates every iteration for all the
+     * unconverged cells at once.  The state of the mixture is not changed.
+     *
+     * @param n         number of cells
+     * @param p_rhoi    species densities in kg/m^3 (n x nSpecies, row major)
+     * @param p_rhoe    static energy densities in J/m^3 (n)
+     * @param p_T       initial guesses on input, temperatures in K on output
+     * @param atol      absolute tolerance on the energy equation residual
+     * @param rtol      relative tolerance on the energy equation residual
+     * @param max_iters maximum number of Newton iterations
+     *
+     * @return the number of cells which did not converge
+     */
+    int getTFromRhoE(
+        int n, const double* const p_rhoi, const double* const p_rhoe,
+        double* const p_T, const double atol = 1.0e-12,
+        const double rtol = 1.0e-12, const int max_iters = 100) const;
+
+    /**
+     * Solves the energy equations of n cells with the StateModel of the
+     * mixture, which is left in the state of the last cell.
+     * @see StateModel::batchSolveEnergies()
+     *
+     * @return the number of cells which did not converge
+     */
+    int batchSolveEnergies(
+        int n, const double* const p_rhoi, const double* const p_rhoe,
+        double* const p_T, EnergySolveStats* const p_stats = NULL);
+
+    /**
+     * Returns the convergence information of the energy equations solved by
+     * the last call to setState() with energy variables.
+     */
+    const EnergySolveStats& energySolveStats() const;
+
+    /**
+     * Returns a counter which is incremented each time the state of the
+     * mixture is changed through setState() or equilibrate().  Quantities
+     * which only depend on the state can be cached against this value.
+     */
+    unsigned long stateEpoch() const { return m_state_epoch; }
         
     /**
      * Computes the equilibrium composition of the mixture at the given fixed
@@ -324,6 +383,35 @@ public:
     std::pair<int, int> equilibriumComposition(
         double T, double P, const double* const p_Xe, double* const p_X,
         MoleFracDef mdf = GLOBAL) const;
+
+    /**
+     * Computes the equilibrium composition and temperature of the mixture at
+     * the given fixed enthalpy (J/kg), pressure, and elemental moles/mole
+     * fractions.  On input, T is the initial guess for the temperature.  The
+     * temperature is solved for directly by the equilibrium solver.
+     */
+    std::pair<int, int> equilibriumCompositionHP(
+        double h, double P, const double* const p_Xe, double* const p_X,
+        double& T, MoleFracDef mdf = GLOBAL) const;
+
+    /**
+     * Computes the equilibrium composition and temperature of the mixture at
+     * the given fixed entropy (J/kg-K), pressure, and elemental moles/mole
+     * fractions.  On input, T is the initial guess for the temperature.
+     */
+    std::pair<int, int> equilibriumCompositionSP(
+        double s, double P, const double* const p_Xe, double* const p_X,
+        double& T, MoleFracDef mdf = GLOBAL) const;
+
+    /**
+     * Computes the equilibrium composition, temperature, and pressure of the
+     * mixture at the given fixed energy (J/kg), specific volume (m^3/kg), and
+     * elemental moles/mole fractions.  On input, T and P are the initial
+     * guesses for the temperature and pressure.
+     */
+    std::pair<int, int> equilibriumCompositionUV(
+        double u, double v, const double* const p_Xe, double* const p_X,
+        double& T, double& P, MoleFracDef mdf = GLOBAL) const;
     
     /**
      * Equilibrates the mixture to the given temperature, pressure, and
@@ -720,6 +808,13 @@ public:
      * Returns the unitless vector of species enthalpies \f$ H_i / R_u T \f$.
      */
     void speciesHOverRT(double T, double* const h) const; 
+
+    /**
+     * Computes the unitless species specific heats \f$ C_{p,i} / R_u \f$
+     * and enthalpies \f$ H_i / R_u T \f$ at the given temperature together.
+     */
+    void speciesCpAndHOverRT(
+        double T, double* const p_cp, double* const p_h) const;
     
     /**
      * Computes the unitless species enthalpies and can optionally fill vectors
@@ -926,6 +1021,8 @@ private:
     int  m_natoms;
     int  m_nmolecules;
     int  m_ngas;
+
+    mutable unsigned long m_state_epoch;
     
 }; // class Thermodynamics
 
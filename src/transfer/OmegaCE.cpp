@@ -27,6 +27,7 @@
 
 #include "Mixture.h"
 #include "TransferModel.h"
+#include <algorithm>
 #include <cmath>
 
 namespace Mutation {
@@ -44,22 +45,62 @@ public:
 		: TransferModel(mix)
 	{
 		mp_wrk1 = new double [mix.nSpecies()];
+		mp_wrk2 = new double [3*mix.nReactions()];
 	}
 
 	~OmegaCE()
 	{
 		delete [] mp_wrk1;
+		delete [] mp_wrk2;
 	}
 
 	double source()
+	{
+		return source(context());
+	}
+
+	double source(TransferContext& ctx)
 	{
 		static const double cv = 1.5*RU/m_mixture.speciesMw(0);
+		return ctx.productionRates()[0]*cv*m_mixture.Te();
+	}
+
+	/**
+	 * Computes the analytic Jacobian of the source term, written as
+	 * \f$ \frac{3}{2} R_u T_e \sum_r \Delta\nu_{e,r} \xi_r \f$.
+	 */
+	void jacobian(double* const p_jac)
+	{
+		const int ns = m_mixture.nSpecies();
+		const int nr = m_mixture.nReactions();
+		const double Te = m_mixture.Te();
+
+		double* const p_dnu   = mp_wrk2;
+		double* const p_drdT  = mp_wrk2 + nr;
+		double* const p_drdTv = mp_wrk2 + 2*nr;
+
+		// Electron energy change across each reaction
+		std::fill(mp_wrk1, mp_wrk1+ns, 0.0);
+		mp_wrk1[0] = 1.5*RU*Te;
+		std::fill(p_dnu, p_dnu+nr, 0.0);
+		m_mixture.getReactionDelta(mp_wrk1, p_dnu);
+
+		m_mixture.netRatesOfProgressGradientRho(p_dnu, p_jac);
+		m_mixture.netRatesOfProgressDerivatives(p_drdT, p_drdTv);
+
+		p_jac[ns] = p_jac[ns+1] = 0.0;
+		for (int j = 0; j < nr; ++j) {
+			p_jac[ns]   += p_dnu[j]*p_drdT[j];
+			p_jac[ns+1] += p_dnu[j]*p_drdTv[j];
+		}
+
 		m_mixture.netProductionRates(mp_wrk1);
-		return mp_wrk1[0]*cv*m_mixture.Te();
+		p_jac[ns+1] += mp_wrk1[0]*1.5*RU/m_mixture.speciesMw(0);
 	}
 
 private:
 	double* mp_wrk1;
+	double* mp_wrk2;
 };
 
 // Register the transfer model
@@ -28,6 +28,8 @@
 #include "Mixture.h"
 #include "TransferModel.h"
 
+#include <algorithm>
+
 namespace Mutation {
     namespace Transfer {
 
@@ -48,30 +50,79 @@ public:
 	{
 		mp_wrk1 = new double [mix.nSpecies()];
 		mp_wrk2 = new double [mix.nSpecies()];
+		mp_wrk3 = new double [4*mix.nReactions()];
 	};
 
 	~OmegaCElec()
 	{
 		delete [] mp_wrk1;
 		delete [] mp_wrk2;
+		delete [] mp_wrk3;
 	};
 
 	double source()
 	{
-		m_mixture.speciesHOverRT(NULL, NULL, NULL, NULL, mp_wrk1, NULL);
-		m_mixture.netProductionRates(mp_wrk2);
+		return source(context());
+	}
+
+	double source(TransferContext& ctx)
+	{
+		const double* p_hel = ctx.helOverRT();
+		const double* p_wdot = ctx.productionRates();
 
 		double sum = 0.0;
 
 		for(int i = 0 ; i < m_mixture.nSpecies(); ++i)
-			sum += mp_wrk1[i]*mp_wrk2[i]/m_mixture.speciesMw(i);
+			sum += p_hel[i]*p_wdot[i]/m_mixture.speciesMw(i);
+
+		return (sum*ctx.T()*RU);
+	}
+
+	/**
+	 * Computes the analytic Jacobian of the source term, written as
+	 * \f$ \sum_r \Delta E^E_r \xi_r \f$ where \f$ \Delta E^E_r \f$ is the
+	 * change in electronic energy across reaction r, which only depends on
+	 * the electronic temperature (equal to Tv).
+	 */
+	void jacobian(double* const p_jac)
+	{
+		const int ns = m_mixture.nSpecies();
+		const int nr = m_mixture.nReactions();
+		const double T  = m_mixture.T();
+		const double Tv = m_mixture.Tv();
+
+		double* const p_dE    = mp_wrk3;
+		double* const p_dcp   = mp_wrk3 + nr;
+		double* const p_drdT  = mp_wrk3 + 2*nr;
+		double* const p_drdTv = mp_wrk3 + 3*nr;
+
+		// Electronic energy and specific heat changes across each reaction
+		m_mixture.speciesHOverRT(NULL, NULL, NULL, NULL, mp_wrk1, NULL);
+		m_mixture.speciesCpOverR(T, Tv, T, Tv, Tv, NULL, NULL, NULL, NULL, mp_wrk2);
+		for (int i = 0; i < ns; ++i)
+			mp_wrk1[i] *= RU*T;
+		std::fill(mp_wrk3, mp_wrk3+2*nr, 0.0);
+		m_mixture.getReactionDelta(mp_wrk1, p_dE);
+		m_mixture.getReactionDelta(mp_wrk2, p_dcp);
+
+		m_mixture.netRatesOfProgressGradientRho(p_dE, p_jac);
+		m_mixture.netRatesOfProgressDerivatives(p_drdT, p_drdTv);
+
+		p_jac[ns] = p_jac[ns+1] = 0.0;
+		for (int j = 0; j < nr; ++j) {
+			p_jac[ns]   += p_dE[j]*p_drdT[j];
+			p_jac[ns+1] += p_dE[j]*p_drdTv[j];
+		}
 
-		return (sum*m_mixture.T()*RU);
+		m_mixture.netRatesOfProgress(p_drdT);
+		for (int j = 0; j < nr; ++j)
+			p_jac[ns+1] += RU*p_dcp[j]*p_drdT[j];
 	}
 
 private:
 	double* mp_wrk1;
 	double* mp_wrk2;
+	double* mp_wrk3;
 };
 
 // Register the transfer model
@@ -28,6 +28,8 @@
 #include "Mixture.h"
 #include "TransferModel.h"
 
+#include <algorithm>
+
 namespace Mutation {
     namespace Transfer {
 
@@ -60,14 +62,17 @@ public:
 		: TransferModel(mix)
 	{
 		m_ns = m_mixture.nSpecies();
+		m_nr = m_mixture.nReactions();
 		mp_wrk1 = new double [m_ns];
 		mp_wrk2 = new double [m_ns];
+		mp_wrk3 = new double [4*m_nr];
 	};
 
 	~OmegaCV()
 	{
 		delete [] mp_wrk1;
 		delete [] mp_wrk2;
+		delete [] mp_wrk3;
 	};
 /**
  * Computes the source terms of the Vibration-Chemistry energy transfer in \f$ [J/(m^3\cdot s)] \f$
@@ -76,11 +81,16 @@ public:
  *
  */
 	double source()
+	{
+		return source(context());
+	}
+
+	double source(TransferContext& ctx)
 	{
 		static int i_transfer_model = 0;
 		switch (i_transfer_model){
 		   case 0:
-			  return compute_source_Candler();
+			  return compute_source_Candler(ctx);
 		  break;
 		   default:
 			  std::cerr << "The selected Chemistry-Vibration-Chemistry model is not implemented yet";
@@ -88,12 +98,52 @@ public:
 		}
 	}
 
+/**
+ * Computes the analytic Jacobian of the non-preferential source term, written
+ * as \f$ \sum_r \Delta E^V_r \xi_r \f$ where \f$ \Delta E^V_r \f$ is the
+ * change in vibrational energy across reaction r, which only depends on Tv.
+ */
+	void jacobian(double* const p_jac)
+	{
+		const double T  = m_mixture.T();
+		const double Tv = m_mixture.Tv();
+
+		double* const p_dE    = mp_wrk3;
+		double* const p_dcp   = mp_wrk3 + m_nr;
+		double* const p_drdT  = mp_wrk3 + 2*m_nr;
+		double* const p_drdTv = mp_wrk3 + 3*m_nr;
+
+		// Vibrational energy and specific heat changes across each reaction
+		m_mixture.speciesHOverRT(NULL, NULL, NULL, mp_wrk1, NULL, NULL);
+		m_mixture.speciesCpOverR(T, Tv, T, Tv, Tv, NULL, NULL, NULL, mp_wrk2, NULL);
+		for (int i = 0; i < m_ns; ++i)
+			mp_wrk1[i] *= RU*T;
+		std::fill(mp_wrk3, mp_wrk3+2*m_nr, 0.0);
+		m_mixture.getReactionDelta(mp_wrk1, p_dE);
+		m_mixture.getReactionDelta(mp_wrk2, p_dcp);
+
+		m_mixture.netRatesOfProgressGradientRho(p_dE, p_jac);
+		m_mixture.netRatesOfProgressDerivatives(p_drdT, p_drdTv);
+
+		p_jac[m_ns] = p_jac[m_ns+1] = 0.0;
+		for (int j = 0; j < m_nr; ++j) {
+			p_jac[m_ns]   += p_dE[j]*p_drdT[j];
+			p_jac[m_ns+1] += p_dE[j]*p_drdTv[j];
+		}
+
+		m_mixture.netRatesOfProgress(p_drdT);
+		for (int j = 0; j < m_nr; ++j)
+			p_jac[m_ns+1] += RU*p_dcp[j]*p_drdT[j];
+	}
+
 private:
 	int m_ns;
+	int m_nr;
 	double* mp_wrk1;
 	double* mp_wrk2;
+	double* mp_wrk3;
 
-	double const compute_source_Candler();
+	double const compute_source_Candler(TransferContext& ctx);
 };
 
  /**
@@ -106,24 +156,22 @@ private:
  *
  */
 
-double const OmegaCV::compute_source_Candler()
+double const OmegaCV::compute_source_Candler(TransferContext& ctx)
 {
-
-
 	 // Getting Vibrational Energy
-	 m_mixture.speciesHOverRT(NULL, NULL, NULL, mp_wrk1, NULL, NULL);
+	 const double* p_hv = ctx.hvOverRT();
 
 	 // Getting Production Rate
-	 m_mixture.netProductionRates(mp_wrk2);
+	 const double* p_wdot = ctx.productionRates();
 
 	 // Inner Product
 	 double c1 = 1.0E0;
 	 double sum = 0.E0;
 
 	 for(int i = 0 ; i < m_ns; ++i)
-		 sum += mp_wrk1[i]*mp_wrk2[i]/m_mixture.speciesMw(i);
+		 sum += p_hv[i]*p_wdot[i]/m_mixture.speciesMw(i);
 
-	 return(c1*sum*m_mixture.T()*RU);
+	 return(c1*sum*ctx.T()*RU);
  }
 
 // Register the transfer model
@@ -28,6 +28,7 @@
 #include "Mixture.h"
 #include "TransferModel.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include <Eigen/Dense>
@@ -63,13 +64,18 @@ public:
 	{ }
 
 	double source()
+	{
+		return source(context());
+	}
+
+	double source(TransferContext& ctx)
 	{
 	    if (!m_has_electrons)
 		    return 0.0;
 
 	    const double * p_X = m_mixture.X();
         double nd = m_mixture.numberDensity();
-        double T = m_mixture.T();
+        double T = ctx.T();
         double Te = m_mixture.Te();
 
         const double ns = m_mixture.nSpecies();
@@ -86,6 +92,53 @@ public:
         return 1.5*KB*nd*p_X[0]*(T-Te)/tau;
 	}
 
+	/**
+	 * Computes the analytic Jacobian of the source term.  The electron-ion
+	 * collision integrals depend on the electron temperature and number
+	 * density through the Debye length as well, \f$\lambda_D \propto
+	 * \sqrt{T_e/n_e}\f$, which is included in the derivatives.
+	 */
+	void jacobian(double* const p_jac)
+	{
+	    const int ns = m_mixture.nSpecies();
+	    std::fill(p_jac, p_jac+ns+2, 0.0);
+
+	    if (!m_has_electrons)
+		    return;
+
+        double nd = m_mixture.numberDensity();
+        double T = m_mixture.T();
+        double Te = m_mixture.Te();
+
+        // Species number densities
+        const ArrayXd n = nd*Map<const ArrayXd>(m_mixture.X(),ns);
+
+        // CollisionDB data
+        const ArrayXd& Q11ei = m_collisions.Q11ei();
+        const ArrayXd& mass  = m_collisions.mass();
+        const ArrayXd& dlnQ11ei =
+            m_collisions.dlnT(Transport::CollisionDB::Q11EI);
+        const ArrayXd& dlnLQ11ei =
+            m_collisions.dlnDebyeLength(Transport::CollisionDB::Q11EI);
+
+        // Electron velocity and relaxation frequency
+        double ve = sqrt(KB*8.*Te/(PI*mass(0)));
+        double fac = mass(0)*8./3.*ve;
+        double nu = fac*(n*Q11ei/mass).tail(ns-1).sum();
+        double dnu = 0.5*nu/Te +
+            fac*(n*Q11ei/mass*(dlnQ11ei+0.5*dlnLQ11ei)).tail(ns-1).sum()/Te;
+
+        // Derivative of nu with respect to ln(n_e) through the Debye length
+        double dnu_ne = -0.5*fac*(n*Q11ei/mass*dlnLQ11ei).tail(ns-1).sum();
+
+        const double ce = 1.5*KB*n(0);
+        p_jac[0] = 1.5*KB*NA/m_mixture.speciesMw(0)*(T-Te)*(nu+dnu_ne);
+        for (int j = 1; j < ns; ++j)
+            p_jac[j] = ce*(T-Te)*fac*Q11ei(j)/mass(j)*NA/m_mixture.speciesMw(j);
+        p_jac[ns]   = ce*nu;
+        p_jac[ns+1] = ce*((T-Te)*dnu - nu);
+	}
+
 private:
 	Transport::CollisionDB& m_collisions;
 	bool m_has_electrons;
@@ -28,6 +28,7 @@
 #include "Mixture.h"
 #include "TransferModel.h"
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -45,7 +46,7 @@ public:
         m_ns = m_mixture.nSpecies();
         m_nr = m_mixture.nReactions();
         mp_hf = new double [m_ns];
-        mp_h = new double [m_ns];
+        mp_h = new double [std::max(m_ns, m_nr)];
         mp_rate = new double [m_nr];
         mp_delta = new double [m_nr];
         for(int i=0; i<m_nr; ++i) {
@@ -83,27 +84,61 @@ public:
       */
     double source()
     {
-        // Get Formation enthalpy
-        m_mixture.speciesHOverRT(mp_h, NULL, NULL, NULL, NULL, mp_hf);
+        return source(context());
+    }
 
-        // Get reaction enthalpies
+    double source(TransferContext& ctx)
+    {
+        // Get reaction enthalpies from the formation enthalpies
         std::fill(mp_delta, mp_delta+m_nr, 0.0);
-        m_mixture.getReactionDelta(mp_hf,mp_delta);
+        m_mixture.getReactionDelta(ctx.hfOverRT(),mp_delta);
 
         // Get molar rates of progress
-        m_mixture.netRatesOfProgress(mp_rate);
+        const double* p_rate = ctx.ratesOfProgress();
 
         double src = 0.0;
         int j;
         for (int i = 0; i < m_rId.size(); ++i) {
             j = m_rId[i];
-            src += mp_delta[j]*mp_rate[j];
+            src += mp_delta[j]*p_rate[j];
         }
 
-        return (-src*RU*m_mixture.T());
+        return (-src*RU*ctx.T());
 
     }
 
+    /**
+     * Computes the analytic Jacobian of the source term.  The reaction
+     * enthalpies are formation enthalpies which do not depend on the state,
+     * so only the rates of progress of the electron impact reactions vary.
+     */
+    void jacobian(double* const p_jac)
+    {
+        // Get Formation enthalpy
+        m_mixture.speciesHOverRT(mp_h, NULL, NULL, NULL, NULL, mp_hf);
+
+        // Get reaction enthalpies
+        std::fill(mp_delta, mp_delta+m_nr, 0.0);
+        m_mixture.getReactionDelta(mp_hf,mp_delta);
+
+        // Weights of the electron impact reactions only
+        const double fac = -RU*m_mixture.T();
+        std::fill(mp_rate, mp_rate+m_nr, 0.0);
+        for (int i = 0; i < m_rId.size(); ++i)
+            mp_rate[m_rId[i]] = fac*mp_delta[m_rId[i]];
+
+        m_mixture.netRatesOfProgressGradientRho(mp_rate, p_jac);
+
+        // Reuse the reaction work arrays for the temperature derivatives
+        m_mixture.netRatesOfProgressDerivatives(mp_delta, mp_h);
+        p_jac[m_ns] = p_jac[m_ns+1] = 0.0;
+        for (int i = 0; i < m_rId.size(); ++i) {
+            const int j = m_rId[i];
+            p_jac[m_ns]   += mp_rate[j]*mp_delta[j];
+            p_jac[m_ns+1] += mp_rate[j]*mp_h[j];
+        }
+    }
+
 private:
     int m_ns;
     int m_nr;
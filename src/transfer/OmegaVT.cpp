@@ -28,9 +28,14 @@
 #include "MillikanWhite.h"
 #include "Mixture.h"
 #include "TransferModel.h"
+#include <algorithm>
 #include <cmath>
+#include <vector>
+
+#include <Eigen/Dense>
 
 using namespace Mutation;
+using namespace Eigen;
 
 namespace Mutation {
     namespace Transfer {
@@ -43,7 +48,7 @@ class OmegaVT : public TransferModel
 public:
 
     OmegaVT(Mixture& mix)
-        : TransferModel(mix), m_mw(mix)
+        : TransferModel(mix)
     {
         m_const_Park_correction = std::sqrt(PI*KB/(8.E0*NA));
         m_ns              = m_mixture.nSpecies();
@@ -54,6 +59,35 @@ public:
             mp_Mw[i] = m_mixture.speciesMw(i);
         mp_hv = new double [m_ns];
         mp_hveq = new double [m_ns];
+        mp_cpv = new double [m_ns];
+        mp_cpveq = new double [m_ns];
+
+        // Pack the Millikan-White coefficients of every (partner, vibrator)
+        // pair in contiguous arrays with one column per vibrator
+        MillikanWhite mw(mix);
+        const int nv = mw.nVibrators();
+        const int nh = m_ns - m_transfer_offset;
+
+        m_vib_index.resize(nv);
+        m_omega.resize(nv);
+        m_a.resize(nh, nv);
+        m_b.resize(nh, nv);
+        m_sqrt_mu.resize(nh, nv);
+        m_tau.resize(nh, nv);
+        m_tau_mw.resize(nh, nv);
+        m_q.resize(nv);
+        m_tau_m.resize(nv);
+        m_weights.resize(nh);
+
+        for (int v = 0; v < nv; ++v) {
+            m_vib_index[v] = mw[v].index();
+            m_omega(v) = mw[v].omega();
+            for (int j = 0; j < nh; ++j) {
+                m_a(j,v) = mw[v][j].a();
+                m_b(j,v) = mw[v][j].b();
+                m_sqrt_mu(j,v) = std::sqrt(mw[v][j].mu());
+            }
+        }
     }
 
     virtual ~OmegaVT()
@@ -61,6 +95,8 @@ public:
         delete [] mp_Mw;
         delete [] mp_hv;
         delete [] mp_hveq;
+        delete [] mp_cpv;
+        delete [] mp_cpveq;
     }
 
     /**
@@ -79,63 +115,106 @@ public:
      */
 
     double source()
+    {
+        return source(context());
+    }
+
+    double source(TransferContext& ctx)
+    {
+        const double * p_Y = ctx.Y();
+        double rho = ctx.density();
+        double T = ctx.T();
+
+        // Vibrational enthalpies at T and at the current state (T, Tv)
+        const double * p_hveq = ctx.hvEqOverRT();
+        const double * p_hv = ctx.hvOverRT();
+
+        compute_tau_VT(T, ctx.P(), p_Y);
+
+        double src = 0.0;
+        for (int v = 0; v < m_tau_m.size(); ++v) {
+            const int i = m_vib_index[v];
+            src += p_Y[i]*rho*RU*T/mp_Mw[i]*(p_hveq[i] - p_hv[i])/m_tau_m(v);
+        }
+        return src;
+    }
+
+    /**
+     * Computes the analytic Jacobian of the VT source term.  Writing
+     * \f$\Omega^{VT} = \sum_m q_m / \tau^{VT}_m\f$, the relaxation times are
+     * inversely proportional to the pressure, which depends on the densities,
+     * T and Tv (through the electrons), while the Millikan-White and Park
+     * terms depend on T only.
+     */
+    void jacobian(double* const p_jac)
     {
         const double * p_Y = m_mixture.Y();
-        double rho = m_mixture.density();
-        double T = m_mixture.T();
-        double Tv = m_mixture.Tv();
+        const double rho = m_mixture.density();
+        const double T = m_mixture.T();
+        const double Tv = m_mixture.Tv();
+        const double P = m_mixture.P();
+        const int nh = m_ns - m_transfer_offset;
 
         m_mixture.speciesHOverRT(T, T, T, T, T, NULL, NULL, NULL, mp_hveq, NULL, NULL);
         m_mixture.speciesHOverRT(T, Tv, T, Tv, Tv, NULL, NULL, NULL, mp_hv, NULL, NULL);
+        m_mixture.speciesCpOverR(T, T, T, T, T, NULL, NULL, NULL, mp_cpveq, NULL);
+        m_mixture.speciesCpOverR(T, Tv, T, Tv, Tv, NULL, NULL, NULL, mp_cpv, NULL);
+
+        compute_tau_VT(T, P, p_Y);
+
+        std::fill(p_jac, p_jac+m_ns+2, 0.0);
 
-        int inv = 0;
+        // Vibrational energy differences
         double src = 0.0;
-        for (int iv = 0; iv-inv < m_mw.nVibrators(); ++iv){
-            if(m_mixture.species(iv).type() != Mutation::Thermodynamics::MOLECULE){
-                inv++;
-            } else {
-                src += p_Y[iv]*rho*RU*T/mp_Mw[iv]*(mp_hveq[iv] - mp_hv[iv])/compute_tau_VT_m(iv-inv);
-            }
+        for (int v = 0; v < m_tau_m.size(); ++v) {
+            const int i = m_vib_index[v];
+            const double c = p_Y[i]*rho/mp_Mw[i];
+            const double de = RU*T*(mp_hveq[i] - mp_hv[i]);
+            m_q(v) = c*de;
+            src += m_q(v)/m_tau_m(v);
+            p_jac[i]    += de/(mp_Mw[i]*m_tau_m(v));
+            p_jac[m_ns] += c*RU*mp_cpveq[i]/m_tau_m(v);
+            p_jac[m_ns+1] -= c*RU*mp_cpv[i]/m_tau_m(v);
         }
-        return src;
-    }
 
-private:
+        // Pressure dependence of the relaxation times
+        double ce = 0.0, ch = 0.0;
+        for (int i = 0; i < m_ns; ++i)
+            (i < m_transfer_offset ? ce : ch) += p_Y[i]*rho/mp_Mw[i];
 
-    MillikanWhite m_mw;
+        for (int i = 0; i < m_ns; ++i)
+            p_jac[i] += src*RU*(i < m_transfer_offset ? Tv : T)/(mp_Mw[i]*P);
+        p_jac[m_ns]   += src*RU*ch/P;
+        p_jac[m_ns+1] += src*RU*ce/P;
 
-   /**
-    * @brief This function computes the Millikan and White relaxation time
-    * for each diatomic collision
-    *
-    * @param vibrator index
-    * @param partner index
-    *
-    * @return Millikan and White relaxation time \tau_{m,j}^{MW}
-    */
+        // Partner dependence of the frequency averages
+        const ArrayXXd inv_tau = m_tau.inverse();
+        const double s1 = m_weights.sum();
+        const VectorXd g = inv_tau.matrix() * m_q.matrix();
+        for (int j = 0; j < nh; ++j) {
+            const int i = j + m_transfer_offset;
+            p_jac[i] += (g(j) - src)/(mp_Mw[i]*rho*s1);
+        }
 
-   inline double const compute_tau_VT_mj(int const, int const);
+        // Temperature dependence of the pair relaxation times
+        const double park = (T > 20000.0 ? 0.5 : 2.5) / T;
+        const ArrayXXd dtau =
+            m_tau_mw * m_a * (-std::pow(T, -4.0/3.0)/3.0) +
+            (m_tau - m_tau_mw) * park;
+        p_jac[m_ns] -= (m_weights.matrix().transpose() *
+            (dtau * inv_tau.square()).matrix()).dot(m_q.matrix()) / s1;
+    }
 
-    /**
-     * @brief Computes the frequency average over heavy particles.
-     * @param vibrator index
-     *
-     * @return
-     */
-    double compute_tau_VT_m(int const);
+private:
 
     /**
-     * @brief This function computes the Park correction
-     * for vibrational-translational energy transfer
-     * for each collision pair.
-     *
-     * @param vibrator index
-     * @param partner index
+     * @brief Computes the frequency averaged relaxation time of every vibrator
+     * over the heavy particles, including Park's correction, in m_tau_m.
      *
-     * @return Park correction \tau_{m,j}^P
+     * The per-state scalars are evaluated once and the Millikan and White
+     * relaxation times of all the collision pairs in a single exp pass.
      */
-
-    inline double const compute_Park_correction_VT(int const, int const);
+    void compute_tau_VT(double T, double P, const double* const p_Y);
 
     /**
      * Necessary variables
@@ -145,55 +224,58 @@ private:
     double* mp_Mw;
     double* mp_hv;
     double* mp_hveq;
+    double* mp_cpv;
+    double* mp_cpveq;
 
     double m_const_Park_correction;
+
+    /// Species index of each vibrator
+    std::vector<int> m_vib_index;
+
+    /// Limiting cross section factor of each vibrator
+    ArrayXd m_omega;
+
+    /// Millikan-White coefficients of each (partner, vibrator) pair
+    ArrayXXd m_a;
+    ArrayXXd m_b;
+    ArrayXXd m_sqrt_mu;
+
+    // Work arrays
+    ArrayXXd m_tau;
+    ArrayXXd m_tau_mw;
+    ArrayXd  m_q;
+    ArrayXd  m_tau_m;
+    ArrayXd  m_weights;
 };
       
 // Implementation of the Vibrational-Translational Energy Transfer.
-      
-inline double const OmegaVT::compute_Park_correction_VT(int const i_vibrator, int const i_partner)
-{
-    // Limiting cross section for Park's Correction
-    double P = m_mixture.P();
-    double T = m_mixture.T();
-
-    double sigma;
-    if (T > 20000.0) {
-      sigma = m_mw[i_vibrator].omega() * 6.25 ; // 6.25 = (50000/20000)^2
-    } else {
-      sigma = m_mw[i_vibrator].omega() *(2.5E9/(T*T));
-    }
-    
-    return(m_const_Park_correction * sqrt(m_mw[i_vibrator][i_partner].mu()*T)/(sigma*P));
-}
 
- 
-inline double const OmegaVT::compute_tau_VT_mj(int const i_vibrator, int const i_partner)
+void OmegaVT::compute_tau_VT(double T, double P, const double* const p_Y)
 {
-//    Enable in the future for multiple vibrational temperatures
-      double P = m_mixture.P();
-      double T = m_mixture.T();
+    const int nh = m_ns - m_transfer_offset;
 
-      return( exp( m_mw[i_vibrator][i_partner].a() * (pow(T,-1.0/3.0) - m_mw[i_vibrator][i_partner].b()) -18.421) * ONEATM / P );
-}
-      
-double OmegaVT::compute_tau_VT_m(int const i_vibrator)
-{
-    const double * p_Y = m_mixture.Y();
-    
-    double sum1 = 0.0;
-    double sum2 = 0.0;
-    
-    // Partner offset
-    for (int i_partner = m_transfer_offset; i_partner < m_ns; ++i_partner){
-        double tau_j = compute_tau_VT_mj(i_vibrator, i_partner-m_transfer_offset) + compute_Park_correction_VT(i_vibrator, i_partner-m_transfer_offset);
-        sum1 += p_Y[i_partner]/(mp_Mw[i_partner]);
-        sum2 += p_Y[i_partner]/(mp_Mw[i_partner]*tau_j);
+    // Millikan and White relaxation times
+    const double T13 = std::pow(T, -1.0/3.0);
+    m_tau_mw = (m_a * (T13 - m_b) - 18.421).exp() * (ONEATM / P);
+    m_tau = m_tau_mw;
+
+    // Park's correction with the limiting cross section
+    // sigma = omega * (50000/T)^2, frozen above 20000 K
+    const double sigma = (T > 20000.0 ? 6.25 : 2.5E9/(T*T));
+    const double park = m_const_Park_correction * std::sqrt(T) / (sigma * P);
+    for (int v = 0; v < m_tau.cols(); ++v)
+        m_tau.col(v) += (park / m_omega(v)) * m_sqrt_mu.col(v);
+
+    // Frequency average over the heavy partners
+    for (int j = 0; j < nh; ++j) {
+        const int i = j + m_transfer_offset;
+        m_weights(j) = p_Y[i] / mp_Mw[i];
     }
-  
-    return(sum1/sum2);
-}
 
+    m_tau_m = m_weights.sum() /
+        (m_weights.matrix().transpose() * m_tau.inverse().matrix()).array()
+            .transpose();
+}
 
 // Register the transfer model
 Utilities::Config::ObjectProvider<
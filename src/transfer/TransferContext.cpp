@@ -0,0 +1,141 @@
+/**
+ * @file TransferContext.cpp
+ *
+ * @brief Implementation of the TransferContext class.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "TransferContext.h"
+#include "Mixture.h"
+
+#include <algorithm>
+
+namespace Mutation {
+    namespace Transfer {
+
+//==============================================================================
+
+TransferContext::TransferContext(Mutation::Mixture& mix)
+    : m_mixture(mix), m_rho(0.0), m_T(0.0), m_Tv(0.0), m_P(0.0), mp_Y(NULL),
+      m_have_h(false), m_have_hveq(false), m_have_rop(false), mp_wdot(NULL),
+      m_h(mix.nSpecies()), m_hv(mix.nSpecies()), m_hel(mix.nSpecies()),
+      m_hf(mix.nSpecies()), m_hveq(mix.nSpecies()), m_wdot(mix.nSpecies()),
+      m_rop(std::max<size_t>(mix.nReactions(), 1))
+{ }
+
+//==============================================================================
+
+void TransferContext::reset(const double* const p_wdot)
+{
+    m_rho = m_mixture.density();
+    m_T   = m_mixture.T();
+    m_Tv  = m_mixture.Tv();
+    m_P   = m_mixture.P();
+    mp_Y  = m_mixture.Y();
+
+    m_have_h = m_have_hveq = m_have_rop = false;
+    mp_wdot = p_wdot;
+}
+
+//==============================================================================
+
+const double* TransferContext::hOverRT()
+{
+    updateEnthalpies();
+    return &m_h[0];
+}
+
+//==============================================================================
+
+const double* TransferContext::hvOverRT()
+{
+    updateEnthalpies();
+    return &m_hv[0];
+}
+
+//==============================================================================
+
+const double* TransferContext::helOverRT()
+{
+    updateEnthalpies();
+    return &m_hel[0];
+}
+
+//==============================================================================
+
+const double* TransferContext::hfOverRT()
+{
+    updateEnthalpies();
+    return &m_hf[0];
+}
+
+//==============================================================================
+
+const double* TransferContext::hvEqOverRT()
+{
+    if (!m_have_hveq) {
+        m_mixture.speciesHOverRT(
+            m_T, m_T, m_T, m_T, m_T, NULL, NULL, NULL, &m_hveq[0], NULL, NULL);
+        m_have_hveq = true;
+    }
+    return &m_hveq[0];
+}
+
+//==============================================================================
+
+const double* TransferContext::productionRates()
+{
+    if (mp_wdot == NULL) {
+        m_mixture.netProductionRates(&m_wdot[0]);
+        mp_wdot = &m_wdot[0];
+    }
+    return mp_wdot;
+}
+
+//==============================================================================
+
+const double* TransferContext::ratesOfProgress()
+{
+    if (!m_have_rop) {
+        m_mixture.netRatesOfProgress(&m_rop[0]);
+        m_have_rop = true;
+    }
+    return &m_rop[0];
+}
+
+//==============================================================================
+
+void TransferContext::updateEnthalpies()
+{
+    // All the components are computed together in a single call
+    if (!m_have_h) {
+        m_mixture.speciesHOverRT(
+            &m_h[0], NULL, NULL, &m_hv[0], &m_hel[0], &m_hf[0]);
+        m_have_h = true;
+    }
+}
+
+//==============================================================================
+
+    } // namespace Transfer
+} // namespace Mutation
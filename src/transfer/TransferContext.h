@@ -0,0 +1,133 @@
+/**
+ * @file TransferContext.h
+ *
+ * @brief Declaration of the TransferContext class.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRANSFER_TRANSFER_CONTEXT_H
+#define TRANSFER_TRANSFER_CONTEXT_H
+
+#include <cstddef>
+#include <vector>
+
+namespace Mutation {
+
+    // Forward declaration of Mixture type
+    class Mixture;
+
+    namespace Transfer {
+
+/**
+ * Quantities of the current mixture state which are shared by the energy
+ * transfer models.  The state variables are stored on reset() while the
+ * species enthalpies and the chemical rates are only computed the first time
+ * a model asks for them, so that each of them is computed at most once when
+ * all the source terms are evaluated together.
+ */
+class TransferContext
+{
+public:
+
+    /**
+     * Constructs the context for the given mixture.
+     */
+    TransferContext(Mutation::Mixture& mix);
+
+    /**
+     * Forgets the quantities of the previous state and stores the current
+     * state variables.  If the species production rates in kg/m^3-s at the
+     * current state are already known, they can be given in p_wdot (which
+     * must stay valid until the next reset) to avoid recomputing them.
+     */
+    void reset(const double* const p_wdot = NULL);
+
+    /// Mixture density in kg/m^3.
+    double density() const { return m_rho; }
+
+    /// Translational temperature in K.
+    double T() const { return m_T; }
+
+    /// Vibrational temperature in K.
+    double Tv() const { return m_Tv; }
+
+    /// Pressure in Pa.
+    double P() const { return m_P; }
+
+    /// Species mass fractions.
+    const double* Y() const { return mp_Y; }
+
+    /// Species enthalpies \f$H_i/R_uT\f$ at the current state.
+    const double* hOverRT();
+
+    /// Species vibrational enthalpies \f$H^V_i/R_uT\f$ at the current state.
+    const double* hvOverRT();
+
+    /// Species electronic enthalpies \f$H^E_i/R_uT\f$ at the current state.
+    const double* helOverRT();
+
+    /// Species formation enthalpies \f$H^F_i/R_uT\f$.
+    const double* hfOverRT();
+
+    /// Species vibrational enthalpies \f$H^V_i(T)/R_uT\f$ at equilibrium with
+    /// the translational temperature.
+    const double* hvEqOverRT();
+
+    /// Species production rates in kg/m^3-s.
+    const double* productionRates();
+
+    /// Net rates of progress of each reaction in mol/m^3-s.
+    const double* ratesOfProgress();
+
+private:
+
+    void updateEnthalpies();
+
+private:
+
+    Mutation::Mixture& m_mixture;
+
+    double m_rho;
+    double m_T;
+    double m_Tv;
+    double m_P;
+    const double* mp_Y;
+
+    bool m_have_h;
+    bool m_have_hveq;
+    bool m_have_rop;
+    const double* mp_wdot;
+
+    std::vector<double> m_h;
+    std::vector<double> m_hv;
+    std::vector<double> m_hel;
+    std::vector<double> m_hf;
+    std::vector<double> m_hveq;
+    std::vector<double> m_wdot;
+    std::vector<double> m_rop;
+};
+
+    } // namespace Transfer
+} // namespace Mutation
+
+#endif // TRANSFER_TRANSFER_CONTEXT_H
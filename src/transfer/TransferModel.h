@@ -28,6 +28,9 @@
 #ifndef TRANSFER_TRANSFER_MODEL_H
 #define TRANSFER_TRANSFER_MODEL_H
 
+#include "Errors.h"
+#include "TransferContext.h"
+
 namespace Mutation {
 
 	// Forward declaration of Mixture type
@@ -58,7 +61,7 @@ public:
     static std::string typeName() { return "TransferModel"; }
 
     TransferModel(ARGS mix)
-        : m_mixture(mix)
+        : m_mixture(mix), m_context(mix)
     { }
 
 /**
@@ -74,8 +77,54 @@ public:
  */
     virtual double source() = 0;
 
+/**
+ *@brief Computes the source term using the quantities of the current state
+ * in the given context, which are shared by all the transfer models evaluated
+ * at that state.  The default ignores the context.
+ *
+ * @return energy source term
+ */
+    virtual double source(TransferContext& ctx) {
+        return source();
+    }
+
+/**
+ *@brief Computes the analytic Jacobian of the source term with respect to
+ * the species densities and the temperatures,
+ * \f[ \frac{\partial \Omega}{\partial \rho_1}, \dots,
+ *     \frac{\partial \Omega}{\partial \rho_{ns}},
+ *     \frac{\partial \Omega}{\partial T},
+ *     \frac{\partial \Omega}{\partial T_v}, \f]
+ * where the density derivatives are taken at constant temperatures and the
+ * temperature derivatives at constant densities.  The electron and electronic
+ * temperatures are equal to \f$T_v\f$ as in the two-temperature model.
+ *
+ * @param p_jac on return, the ns+2 derivatives of the source term
+ */
+    virtual void jacobian(double* const p_jac) {
+        throw NotImplementedError("TransferModel::jacobian()");
+    }
+
+/**
+ *@brief Returns the mixture this model is evaluated for.
+ */
+    Mutation::Mixture& mixture() { return m_mixture; }
+
+protected:
+/**
+ *@brief Returns the context owned by this model, reset to the current state,
+ * for models which compute source() with source(TransferContext&).
+ */
+    TransferContext& context() {
+        m_context.reset();
+        return m_context;
+    }
+
 protected:
     Mutation::Mixture& m_mixture;
+
+private:
+    TransferContext m_context;
 };
 
 /// @}
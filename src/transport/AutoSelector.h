@@ -0,0 +1,185 @@
+/**
+ * @file AutoSelector.h
+ *
+ * @brief Provides the AutoSelector class which chooses, state by state,
+ * between a cheap mixture rule and the Chapman-Enskog solution.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRANSPORT_AUTO_SELECTOR_H
+#define TRANSPORT_AUTO_SELECTOR_H
+
+#include "CollisionDB.h"
+#include "Thermodynamics.h"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Mutation {
+    namespace Transport {
+
+/**
+ * Base class for the "Auto" transport algorithms which use the Wilke mixture
+ * rule where its estimated relative error is below a tolerance and escalate
+ * to the Chapman-Enskog solution elsewhere.
+ *
+ * The error of the mixture rule is driven by the ionization degree
+ * \f$\sum_{i\in\mathcal{I}} x_i\f$ and by the mass disparity
+ * \f$\sum_{i<j} x_i x_j \ln^2(m_i/m_j)\f$ of the heavy species, which both
+ * vanish for a single neutral species where the rule is exact.  The two
+ * indicators are binned every half decade into a calibration table which
+ * stores, for each cell, the largest error observed on the states solved with
+ * both methods.  A cell is trusted once it holds MIN_SAMPLES samples which are
+ * all within the tolerance.  Every AUDIT_INTERVAL-th state accepted with the
+ * mixture rule is escalated anyway so that the table follows the states
+ * actually visited.
+ */
+class AutoSelector
+{
+public:
+
+    /// Number of samples needed before a calibration cell is trusted.
+    static const int MIN_SAMPLES = 2;
+
+    /// Number of states accepted with the mixture rule between two audits.
+    static const int AUDIT_INTERVAL = 64;
+
+    AutoSelector(CollisionDB& collisions)
+        : m_tol(1.0e-2), m_cell(0), m_nsince(0),
+          m_n_cheap(0), m_n_full(0), m_n_audit(0),
+          m_max_error(NION*NMASS, 0.0), m_samples(NION*NMASS, 0)
+    {
+        const int ns = collisions.nSpecies();
+        const int nh = collisions.nHeavy();
+        const Eigen::ArrayXd& mass = collisions.mass();
+
+        m_ion.resize(nh);
+        for (int i = 0; i < nh; ++i)
+            m_ion(i) = (collisions.thermo().species(i+ns-nh).charge() != 0);
+
+        m_lnm2.resize(nh, nh);
+        for (int i = 0; i < nh; ++i)
+            for (int j = 0; j < nh; ++j)
+                m_lnm2(i,j) = std::pow(std::log(mass(i+ns-nh)/mass(j+ns-nh)), 2);
+    }
+
+    virtual ~AutoSelector() { }
+
+    /// Sets the relative tolerance on the error of the mixture rule.
+    void setTolerance(double tol) { m_tol = tol; }
+
+    /// Returns the relative tolerance on the error of the mixture rule.
+    double tolerance() const { return m_tol; }
+
+    /// Number of evaluations which used the mixture rule.
+    unsigned long nCheap() const { return m_n_cheap; }
+
+    /// Number of evaluations which used the Chapman-Enskog solution.
+    unsigned long nFull() const { return m_n_full; }
+
+    /// Number of Chapman-Enskog evaluations done only to audit the table.
+    unsigned long nAudit() const { return m_n_audit; }
+
+    /// Resets the counters, but keeps the calibration table.
+    void resetCounters() { m_n_cheap = m_n_full = m_n_audit = 0; }
+
+protected:
+
+    /**
+     * Returns true if the mixture rule is accurate enough for the heavy
+     * species mole fractions x, and updates the counters accordingly.
+     */
+    template <typename E>
+    bool useMixtureRule(const Eigen::ArrayBase<E>& x)
+    {
+        double mass = 0.0;
+        for (int j = 0; j < x.size(); ++j)
+            for (int i = j+1; i < x.size(); ++i)
+                mass += x(i)*x(j)*m_lnm2(i,j);
+
+        m_cell = bin((m_ion * x).sum(), 1.0e-8, NION)*NMASS +
+            bin(mass, 1.0e-4, NMASS);
+
+        if (m_samples[m_cell] >= MIN_SAMPLES &&
+            m_max_error[m_cell] <= m_tol && ++m_nsince < AUDIT_INTERVAL) {
+            m_n_cheap++;
+            return true;
+        }
+
+        if (m_nsince >= AUDIT_INTERVAL) m_n_audit++;
+        m_nsince = 0;
+        m_n_full++;
+        return false;
+    }
+
+    /**
+     * Updates the calibration table with the mixture rule and Chapman-Enskog
+     * values obtained at the state of the last call to useMixtureRule().
+     */
+    void calibrate(double cheap, double full)
+    {
+        if (full == 0.0) return;
+        m_max_error[m_cell] = std::max(
+            m_max_error[m_cell], std::abs(cheap - full) / std::abs(full));
+        m_samples[m_cell]++;
+    }
+
+private:
+
+    /// Number of ionization degree and mass disparity bins.
+    static const int NION  = 18;
+    static const int NMASS = 10;
+
+    /**
+     * Returns 0 below vmin and otherwise the half decade above vmin in which
+     * v lies, offset by one and clipped to the n bins.
+     */
+    static int bin(double v, double vmin, int n) {
+        if (v < vmin) return 0;
+        return std::min(n-1, 1 + static_cast<int>(2.0*std::log10(v/vmin)));
+    }
+
+private:
+
+    double m_tol;
+    int m_cell;
+    int m_nsince;
+
+    unsigned long m_n_cheap;
+    unsigned long m_n_full;
+    unsigned long m_n_audit;
+
+    Eigen::ArrayXd m_ion;
+    Eigen::ArrayXXd m_lnm2;
+
+    std::vector<double> m_max_error;
+    std::vector<int> m_samples;
+
+}; // class AutoSelector
+
+    } // namespace Transport
+} // namespace Mutation
+
+#endif // TRANSPORT_AUTO_SELECTOR_H
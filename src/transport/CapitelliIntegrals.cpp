@@ -62,6 +62,31 @@ double BrunoEq11ColInt::compute_(double T)
     return (m_a[0]+x*m_a[1])*e1/(e1+1.0/e1) + m_a[4]*e2/(e2+1.0/e2);
 }
 
+double BrunoEq11ColInt::dlnT_(double T)
+{
+    // Note that e/(e+1/e) = s and ds/du = 2s(1-s)
+    double x  = std::log(T);
+    double e1 = std::exp((x - m_a[2])/m_a[3]);
+    double e2 = std::exp((x - m_a[5])/m_a[6]);
+    double s1 = e1/(e1+1.0/e1);
+    double s2 = e2/(e2+1.0/e2);
+
+    double Q  = (m_a[0]+x*m_a[1])*s1 + m_a[4]*s2;
+    double dQ = m_a[1]*s1 + (m_a[0]+x*m_a[1])*2.0*s1*(1.0-s1)/m_a[3] +
+        m_a[4]*2.0*s2*(1.0-s2)/m_a[6];
+
+    return dQ/Q;
+}
+
+CollisionIntegral::BatchForm BrunoEq11ColInt::batchData(
+    std::vector<double>& coeffs)
+{
+    coeffs.assign(1, baseFactor());
+    coeffs.push_back(0.0);
+    coeffs.insert(coeffs.end(), m_a.data(), m_a.data()+7);
+    return BRUNO_EQ11;
+}
+
 bool BrunoEq11ColInt::isEqual(const CollisionIntegral& ci) const
 {
     const BrunoEq11ColInt& compare =
@@ -92,6 +117,12 @@ double BrunoEq17ColInt::compute_(double T)
     return m_d[0] + x*(m_d[1] + x*m_d[2]);
 }
 
+double BrunoEq17ColInt::dlnT_(double T)
+{
+    double x  = std::log(T);
+    return (m_d[1] + 2.0*x*m_d[2])/(m_d[0] + x*(m_d[1] + x*m_d[2]));
+}
+
 /**
  * Returns true if the coefficients are the same.
  */
@@ -193,6 +224,28 @@ double PiraniColInt::compute_(double T)
     );
 }
 
+double PiraniColInt::dlnT_(double T)
+{
+    // Derivative of the exponent, with e/(e+1/e) = s and ds/du = 2s(1-s)
+    const double x  = std::log(KB*T/m_phi0);
+    const double e1 = std::exp((x - m_a[2])/m_a[3]);
+    const double e2 = std::exp((x - m_a[5])/m_a[6]);
+    const double s1 = e1/(e1+1.0/e1);
+    const double s2 = e2/(e2+1.0/e2);
+
+    return m_a[1]*s1 + (m_a[0] + x*m_a[1])*2.0*s1*(1.0-s1)/m_a[3] +
+        m_a[4]*2.0*s2*(1.0-s2)/m_a[6];
+}
+
+CollisionIntegral::BatchForm PiraniColInt::batchData(
+    std::vector<double>& coeffs)
+{
+    coeffs.assign(1, baseFactor()*m_sig2);
+    coeffs.push_back(std::log(KB/m_phi0));
+    coeffs.insert(coeffs.end(), m_a.data(), m_a.data()+7);
+    return PIRANI;
+}
+
 bool PiraniColInt::isEqual(const CollisionIntegral& ci) const
 {
     const PiraniColInt& compare =
@@ -60,8 +60,10 @@ class BrunoEq11ColInt : public CapitelliIntegral
 {
 public:
     BrunoEq11ColInt(CollisionIntegral::ARGS args);
+    BatchForm batchData(std::vector<double>& coeffs);
 private:
     double compute_(double T);
+    double dlnT_(double T);
 
     /**
      * Returns true if the coefficients are the same.
@@ -84,6 +86,7 @@ public:
     virtual bool canTabulate() const { return true; }
 private:
     double compute_(double T);
+    double dlnT_(double T);
 
     /**
      * Returns true if the coefficients are the same.
@@ -126,9 +129,11 @@ class PiraniColInt : public CapitelliIntegral
 public:
     PiraniColInt(CollisionIntegral::ARGS args);
     virtual bool loaded() const { return m_loaded; }
+    BatchForm batchData(std::vector<double>& coeffs);
 
 private:
     double compute_(double T);
+    double dlnT_(double T);
 
     /**
      * Returns true if the coefficients are the same.
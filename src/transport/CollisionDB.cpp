@@ -39,6 +39,7 @@ using namespace Eigen;
 
 #include <cassert>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 using namespace std;
 
@@ -47,6 +48,17 @@ namespace Mutation {
 
 //==============================================================================
 
+// Names of the collision groups, ordered as in CollisionDB::GroupId
+static const char* const s_group_names[CollisionDB::N_GROUP_IDS] = {
+    "Q11ee", "Q11ei", "Q11ii", "Q11ij",
+    "Q12ei", "Q13ei", "Q14ei", "Q15ei",
+    "Q22ee", "Q22ei", "Q22ii", "Q22ij",
+    "Q23ee", "Q24ee",
+    "Astei", "Astij", "Bstei", "Bstij", "Cstei", "Cstij"
+};
+
+//==============================================================================
+
 CollisionDB::CollisionDB(
     const string& db_name, const Thermodynamics::Thermodynamics& thermo) :
     m_database(databaseFileName(db_name, "transport")),
@@ -54,6 +66,8 @@ CollisionDB::CollisionDB(
     m_ng(thermo.nGas()),
     m_nh(thermo.nHeavy() - thermo.nCondensed()),
     m_tabulate(false), m_table_min(300.),  m_table_max(20000.), m_table_del(100.),
+    m_table_err(0.),
+    m_group_loaded(N_GROUP_IDS, false),
     m_mass(m_ng),
     m_etai(m_nh), m_etafac(m_nh),
     m_nDei(m_ng*(thermo.hasElectrons() ? 1 : 0)),
@@ -76,6 +90,7 @@ CollisionDB::CollisionDB(
             tabulate->getAttribute("Tmin", m_table_min, m_table_min);
             tabulate->getAttribute("Tmax", m_table_max, m_table_max);
             tabulate->getAttribute("dT",   m_table_del, m_table_del);
+            tabulate->getAttribute("max_error", m_table_err, m_table_err);
         }
 
         // Check the table data
@@ -84,13 +99,28 @@ CollisionDB::CollisionDB(
             tabulate->parseCheck(m_table_max > 0.0, "Tmax must be positive.");
             tabulate->parseCheck(m_table_del > 0.0, "dT must be positive.");
             tabulate->parseCheck(m_table_min < m_table_max, "Tmin must be > Tmax.");
-
-            double size = (m_table_max-m_table_min)/m_table_del;
-            tabulate->parseCheck(std::abs(size-int(size))/size < 1.0e-15,
-                "(Tmax - Tmin)/dT must be a positive whole number.");
+            tabulate->parseCheck(m_table_err >= 0.0,
+                "max_error must be non-negative.");
+
+            // dT is only used by uniform tables
+            if (m_table_err == 0.0) {
+                double size = (m_table_max-m_table_min)/m_table_del;
+                tabulate->parseCheck(std::abs(size-int(size))/size < 1.0e-15,
+                    "(Tmax - Tmin)/dT must be a positive whole number.");
+            }
         }
     }
 
+    // Create the (empty) indexed groups, these are loaded on first access
+    m_indexed_groups.assign(N_GROUP_IDS, CollisionGroup(
+        m_tabulate, m_table_min, m_table_max, m_table_del, m_table_err));
+    for (int id = 0; id < N_GROUP_IDS; ++id)
+        m_group_types[id] = groupType(s_group_names[id]);
+
+    // None of the derived arrays are computed yet
+    std::fill(m_derived_epoch, m_derived_epoch+N_DERIVED_ARRAYS, 0ul);
+    m_Dim_one_minus_x = true;
+
     // Loop over the species and create the list of species pairs
     const vector<Species>& species = m_thermo.species();
     for (int i = 0; i < nSpecies(); ++i)
@@ -160,20 +190,68 @@ CollisionDB::GroupType CollisionDB::groupType(const string& name)
 
 const CollisionGroup& CollisionDB::group(const string& name)
 {
+    // Groups with an identifier are stored in the indexed container
+    for (int id = 0; id < N_GROUP_IDS; ++id)
+        if (name == s_group_names[id])
+            return group(static_cast<GroupId>(id));
+
     // Minimal check on the string argument
     GroupType type = groupType(name);
     assert(type != BAD_TYPE);
 
     // Check if this group is already being managed
     map<string, CollisionGroup>::iterator iter = m_groups.find(name);
-    if (iter != m_groups.end()) return iter->second.update(
-        (type < II ? m_thermo.Te() : m_thermo.T()), m_thermo);
+    if (iter != m_groups.end())
+        return iter->second.update(groupTemperature(type), m_thermo);
 
     // Create a new group to manage this type
     CollisionGroup& new_group = m_groups.insert(
-        make_pair(name, CollisionGroup(
-            m_tabulate, m_table_min, m_table_max, m_table_del))).first->second;
+        make_pair(name, CollisionGroup(m_tabulate, m_table_min, m_table_max,
+            m_table_del, m_table_err))).first->second;
+    loadGroup(name, type, new_group);
+
+    // Compute integrals and return the group
+    return new_group.update(groupTemperature(type), m_thermo);
+}
+
+//==============================================================================
+
+const CollisionGroup& CollisionDB::group(GroupId id)
+{
+    assert(id >= 0 && id < N_GROUP_IDS);
+
+    const GroupType type = m_group_types[id];
+    CollisionGroup& indexed_group = m_indexed_groups[id];
+
+    if (!m_group_loaded[id]) {
+        loadGroup(s_group_names[id], type, indexed_group);
+        m_group_loaded[id] = true;
+    }
+
+    return indexed_group.update(groupTemperature(type), m_thermo);
+}
+
+//==============================================================================
 
+const ArrayXd& CollisionDB::dlnT(GroupId id)
+{
+    group(id);
+    return m_indexed_groups[id].dlnT();
+}
+
+//==============================================================================
+
+const ArrayXd& CollisionDB::dlnDebyeLength(GroupId id)
+{
+    group(id);
+    return m_indexed_groups[id].dlnDebyeLength();
+}
+
+//==============================================================================
+
+void CollisionDB::loadGroup(
+    const string& name, GroupType type, CollisionGroup& group)
+{
     // Determine start and end iterator for this group
     const int ns = nSpecies();
     const int e  = (m_thermo.hasElectrons() ? 1 : 0);
@@ -204,17 +282,36 @@ const CollisionGroup& CollisionDB::group(const string& name)
 
     // Manage the collision integrals
     string kind = name.substr(0, name.length()-2);
-    new_group.manage(start, end, &CollisionPair::get, kind);
+    group.manage(start, end, &CollisionPair::get, kind);
+}
 
-    // Compute integrals and return the group
-    return new_group.update(
-        (type < II ? m_thermo.Te() : m_thermo.T()), m_thermo);
+//==============================================================================
+
+void CollisionDB::printTableInfo(std::ostream& out) const
+{
+    out << setw(8) << "Group" << setw(8) << "Points" << setw(14) << "Max error"
+        << setw(10) << "Bytes" << endl;
+
+    for (int id = 0; id < N_GROUP_IDS; ++id) {
+        if (!m_group_loaded[id]) continue;
+        const CollisionGroup& g = m_indexed_groups[id];
+        out << setw(8) << s_group_names[id] << setw(8) << g.tableSize()
+            << setw(14) << g.tableError() << setw(10) << g.tableBytes() << endl;
+    }
+
+    map<string, CollisionGroup>::const_iterator iter = m_groups.begin();
+    for ( ; iter != m_groups.end(); ++iter) {
+        const CollisionGroup& g = iter->second;
+        out << setw(8) << iter->first << setw(8) << g.tableSize()
+            << setw(14) << g.tableError() << setw(10) << g.tableBytes() << endl;
+    }
 }
 
 //==============================================================================
 
 const ArrayXd& CollisionDB::etai()
 {
+    if (derivedIsCurrent(ETAI)) return m_etai;
     return (m_etai = std::sqrt(m_thermo.T()) * m_etafac / Q22ii());
 }
 
@@ -222,6 +319,7 @@ const ArrayXd& CollisionDB::etai()
 
 const ArrayXd& CollisionDB::nDei()
 {
+    if (derivedIsCurrent(NDEI)) return m_nDei;
     if (m_nDei.size() > 0)
         m_nDei = std::sqrt(m_thermo.Te()) * m_Deifac / Q11ei();
     return m_nDei;
@@ -231,6 +329,7 @@ const ArrayXd& CollisionDB::nDei()
 
 const ArrayXd& CollisionDB::nDij()
 {
+    if (derivedIsCurrent(NDIJ)) return m_nDij;
     return (m_nDij = std::sqrt(m_thermo.T()) * m_Dijfac / Q11ij());
 }
 
@@ -238,6 +337,12 @@ const ArrayXd& CollisionDB::nDij()
 
 const ArrayXd& CollisionDB::Dim(bool include_one_minus_x)
 {
+    if (include_one_minus_x != m_Dim_one_minus_x) {
+        m_Dim_one_minus_x = include_one_minus_x;
+        m_derived_epoch[DIM] = 0;
+    }
+    if (derivedIsCurrent(DIM)) return m_Dim;
+
     const int ns = nSpecies();
     const int nh = m_nh;
     const int k  = ns - nh;
@@ -277,6 +382,7 @@ const ArrayXd& CollisionDB::Dim(bool include_one_minus_x)
 
 const ArrayXd& CollisionDB::L01ei()
 {
+    if (derivedIsCurrent(L01EI)) return m_L01ei;
     if (m_L01ei.size() > 0) {
         const double theta = m_thermo.Te() / m_thermo.T();
         m_L01ei = theta*X()*(3.*Q12ei()-2.5*Q11ei());
@@ -289,6 +395,7 @@ const ArrayXd& CollisionDB::L01ei()
 
 const ArrayXd& CollisionDB::L02ei()
 {
+    if (derivedIsCurrent(L02EI)) return m_L02ei;
     if (m_L02ei.size() > 0) {
         const double theta = m_thermo.Te() / m_thermo.T();
         m_L02ei = theta*X()*(10.5*Q12ei()-6.*Q13ei()-35./8.*Q11ei());
@@ -36,6 +36,7 @@
 
 #include <cassert>
 #include <complex>
+#include <iostream>
 #include <map>
 #include <string>
 #include <vector>
@@ -50,6 +51,20 @@ class CollisionDB
 {
 public:
 
+    /**
+     * Identifiers of the collision integral groups used by the transport
+     * algorithms.  Accessing a group by its identifier is a simple indexed
+     * load, avoiding the name lookup of group(const std::string&).
+     */
+    enum GroupId {
+        Q11EE = 0, Q11EI, Q11II, Q11IJ,
+        Q12EI, Q13EI, Q14EI, Q15EI,
+        Q22EE, Q22EI, Q22II, Q22IJ,
+        Q23EE, Q24EE,
+        ASTEI, ASTIJ, BSTEI, BSTIJ, CSTEI, CSTIJ,
+        N_GROUP_IDS
+    };
+
     /**
      * Constructs a new CollisionDB type.
      */
@@ -87,69 +102,96 @@ public:
     /**
      * Returns the collision group corresponding to name, updated to the current
      * state.  If the group is not loaded yet, it is first loaded from the
-     * database.
+     * database.  Names of the groups listed in GroupId are forwarded to
+     * group(GroupId).
      */
     const CollisionGroup& group(const std::string& name);
 
+    /**
+     * Returns the collision group with the given identifier, updated to the
+     * current state.  The group is loaded from the database on first access.
+     */
+    const CollisionGroup& group(GroupId id);
+
+    /**
+     * Returns \f$d\ln Q/d\ln T\f$ of the integrals in the group with the
+     * given identifier, at the current state.  Parameters other than the
+     * temperature, such as the Debye length, are held fixed.
+     */
+    const Eigen::ArrayXd& dlnT(GroupId id);
+
+    /**
+     * Returns \f$d\ln Q/d\ln\lambda_D\f$ of the integrals in the group with
+     * the given identifier with respect to the Debye length, at the current
+     * state and temperature.
+     */
+    const Eigen::ArrayXd& dlnDebyeLength(GroupId id);
+
+    /**
+     * Prints the size, interpolation error and memory footprint of the tables
+     * of every collision group loaded so far.
+     */
+    void printTableInfo(std::ostream& out) const;
+
     /// Provides Q11 collision integral for the electron-electron interaction.
-    double Q11ee() { return group("Q11ee")[0]; }
+    double Q11ee() { return group(Q11EE)[0]; }
 
     /// Provides Q11 collision integrals for electron-heavy interactions.
-    const Eigen::ArrayXd& Q11ei() { return group("Q11ei").array(); }
+    const Eigen::ArrayXd& Q11ei() { return group(Q11EI).array(); }
 
     /// Provides Q11 collision integrals for diagonal heavy-heavy interactions.
-    const Eigen::ArrayXd& Q11ii() { return group("Q11ii").array(); }
+    const Eigen::ArrayXd& Q11ii() { return group(Q11II).array(); }
 
     /// Provides Q11 collision integrals for heavy-heavy interactions.
-    const Eigen::ArrayXd& Q11ij() { return group("Q11ij").array(); }
+    const Eigen::ArrayXd& Q11ij() { return group(Q11IJ).array(); }
 
     /// Provides Q12 collision integrals for electron-heavy interactions.
-    const Eigen::ArrayXd& Q12ei() { return group("Q12ei").array(); }
+    const Eigen::ArrayXd& Q12ei() { return group(Q12EI).array(); }
 
     /// Provides Q13 collision integrals for electron-heavy interactions.
-    const Eigen::ArrayXd& Q13ei() { return group("Q13ei").array(); }
+    const Eigen::ArrayXd& Q13ei() { return group(Q13EI).array(); }
 
     /// Provides Q14 collision integrals for electron-heavy interactions.
-    const Eigen::ArrayXd& Q14ei() { return group("Q14ei").array(); }
+    const Eigen::ArrayXd& Q14ei() { return group(Q14EI).array(); }
 
     /// Provides Q15 collision integrals for electron-heavy interactions.
-    const Eigen::ArrayXd& Q15ei() { return group("Q15ei").array(); }
+    const Eigen::ArrayXd& Q15ei() { return group(Q15EI).array(); }
 
     /// Provides Q22 collision integral for the electron-electron interaction.
-    double Q22ee() { return group("Q22ee")[0]; }
+    double Q22ee() { return group(Q22EE)[0]; }
 
     /// Provides Q22 collision integrals for electron-heavy interactions.
-    const Eigen::ArrayXd& Q22ei() { return group("Q22ei").array(); }
+    const Eigen::ArrayXd& Q22ei() { return group(Q22EI).array(); }
 
     /// Provides Q22 collision integrals for diagonal heavy-heavy interactions.
-    const Eigen::ArrayXd& Q22ii() { return group("Q22ii").array(); }
+    const Eigen::ArrayXd& Q22ii() { return group(Q22II).array(); }
 
     /// Provides Q22 collision integrals for heavy-heavy interactions.
-    const Eigen::ArrayXd& Q22ij() { return group("Q22ij").array(); }
+    const Eigen::ArrayXd& Q22ij() { return group(Q22IJ).array(); }
 
     /// Provides Q23 collision integrals for electron-electron interaction.
-    double Q23ee() { return group("Q23ee")[0]; }
+    double Q23ee() { return group(Q23EE)[0]; }
 
     /// Provides Q24 collision integrals for electron-electron interaction.
-    double Q24ee() { return group("Q24ee")[0]; }
+    double Q24ee() { return group(Q24EE)[0]; }
 
     /// Provides A* collision integrals for electron-heavy interactions.
-    const Eigen::ArrayXd& Astei() { return group("Astei").array(); }
+    const Eigen::ArrayXd& Astei() { return group(ASTEI).array(); }
 
     /// Provides A* collision integrals for heavy-heavy interactions.
-    const Eigen::ArrayXd& Astij() { return group("Astij").array(); }
+    const Eigen::ArrayXd& Astij() { return group(ASTIJ).array(); }
 
     /// Provides B* collision integrals for electron-heavy interactions.
-    const Eigen::ArrayXd& Bstei() { return group("Bstei").array(); }
+    const Eigen::ArrayXd& Bstei() { return group(BSTEI).array(); }
 
     /// Provides B* collision integrals for heavy-heavy interactions.
-    const Eigen::ArrayXd& Bstij() { return group("Bstij").array(); }
+    const Eigen::ArrayXd& Bstij() { return group(BSTIJ).array(); }
 
     /// Provides C* collision integrals for electron-heavy interactions.
-    const Eigen::ArrayXd& Cstei() { return group("Cstei").array(); }
+    const Eigen::ArrayXd& Cstei() { return group(CSTEI).array(); }
 
     /// Provides C* collision integrals for heavy-heavy interactions.
-    const Eigen::ArrayXd& Cstij() { return group("Cstij").array(); }
+    const Eigen::ArrayXd& Cstij() { return group(CSTIJ).array(); }
 
     /// Returns the pure, heavy species shear viscosities array.
     const Eigen::ArrayXd& etai();
@@ -297,9 +339,37 @@ private:
         EE = 0, EI, II, IJ, BAD_TYPE
     };
 
+    /// Derived arrays which are cached against the state epoch.
+    enum DerivedArray {
+        ETAI = 0, NDEI, NDIJ, DIM, L01EI, L02EI, N_DERIVED_ARRAYS
+    };
+
+    /**
+     * Returns true if the given derived array is up to date with the current
+     * state, otherwise marks it as such and returns false.
+     */
+    bool derivedIsCurrent(DerivedArray array) {
+        const unsigned long epoch = m_thermo.stateEpoch();
+        if (m_derived_epoch[array] == epoch) return true;
+        m_derived_epoch[array] = epoch;
+        return false;
+    }
+
     /// Determines the type of group from the group name.
     GroupType groupType(const std::string& name);
 
+    /**
+     * Sets the collision integrals managed by the given group from the name
+     * of the integral kind and the type of group.
+     */
+    void loadGroup(
+        const std::string& name, GroupType type, CollisionGroup& group);
+
+    /// Returns the temperature at which a group of the given type is evaluated.
+    double groupTemperature(GroupType type) const {
+        return (type < II ? m_thermo.Te() : m_thermo.T());
+    }
+
 private:
 
     Mutation::Utilities::IO::XmlDocument m_database;
@@ -314,11 +384,16 @@ private:
     double m_table_min;
     double m_table_max;
     double m_table_del;
+    double m_table_err;
 
     // List of collision pairs
     std::vector<CollisionPair> m_pairs;
 
-    // CollisionGroup container
+    // CollisionGroup containers, indexed by GroupId or by name for the groups
+    // which do not have an identifier
+    std::vector<CollisionGroup> m_indexed_groups;
+    std::vector<bool> m_group_loaded;
+    GroupType m_group_types[N_GROUP_IDS];
     std::map<std::string, CollisionGroup> m_groups;
 
     // Derived data and helper arrays
@@ -332,6 +407,10 @@ private:
     Eigen::ArrayXd m_Dim;
     Eigen::ArrayXd m_L01ei;
     Eigen::ArrayXd m_L02ei;
+
+    // State epoch at which each derived array was last computed
+    unsigned long m_derived_epoch[N_DERIVED_ARRAYS];
+    bool m_Dim_one_minus_x;
 };
 
     } // namespace Transport
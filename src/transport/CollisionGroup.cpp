@@ -28,19 +28,33 @@
  */
 
 #include "CollisionGroup.h"
+#include "Thermodynamics.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 using namespace std;
+using namespace Eigen;
 
 namespace Mutation {
     namespace Transport {
 
 //==============================================================================
 
+// Relative error of an interpolated value (absolute error if exact is zero)
+inline double relativeError(double interp, double exact)
+{
+    const double diff = std::abs(interp - exact);
+    return (exact == 0.0 ? diff : diff / std::abs(exact));
+}
+
+//==============================================================================
+
 void CollisionGroup::manage(
     const std::vector< SharedPtr<CollisionIntegral> >& integrals)
 {
     m_size = integrals.size();
+    m_epoch = 0;
     if (m_size == 0)
         return;
 
@@ -62,10 +76,17 @@ void CollisionGroup::manage(
         m_map[i] = j;
     }
 
-    // If not tabulating, then we are done setting up
-    if (!m_tabulate)
-        return;
+    // Tabulate the integrals which allow it, then group the remaining ones by
+    // functional form
+    if (m_tabulate)
+        tabulate();
+    setupBatches();
+}
 
+//==============================================================================
+
+void CollisionGroup::tabulate()
+{
     // Condense all the tabulatable integrals at the top of the list
     int next = 0;
     for (int i = 0; i < m_integrals.size(); ++i) {
@@ -90,7 +111,62 @@ void CollisionGroup::manage(
         return;
 
     // Generate the table
-    m_table.resize(next, int((m_table_max-m_table_min)/m_table_delta)+1);
+    if (m_table_max_error > 0.0)
+        tabulateAdaptive(next);
+    else
+        tabulateUniform(next);
+}
+
+//==============================================================================
+
+void CollisionGroup::setupBatches()
+{
+    m_batches.clear();
+    m_scalar.clear();
+
+    // Integrals of the same form and number of coefficients share a batch
+    std::vector<double> coeffs;
+    std::vector< std::vector< std::vector<double> > > rows;
+
+    for (int i = m_table.rows(); i < m_integrals.size(); ++i) {
+        CollisionIntegral::BatchForm form = m_integrals[i]->batchData(coeffs);
+        if (form == CollisionIntegral::NO_BATCH) {
+            m_scalar.push_back(i);
+            continue;
+        }
+
+        int b = 0;
+        for ( ; b < m_batches.size(); ++b)
+            if (m_batches[b].form == form && rows[b][0].size() == coeffs.size())
+                break;
+
+        if (b == m_batches.size()) {
+            m_batches.push_back(Batch());
+            m_batches[b].form = form;
+            rows.push_back(std::vector< std::vector<double> >());
+        }
+
+        m_batches[b].index.push_back(i);
+        rows[b].push_back(coeffs);
+    }
+
+    // Store the coefficients with one row per integral, so that each column is
+    // contiguous over the integrals of the batch
+    for (int b = 0; b < m_batches.size(); ++b) {
+        Batch& batch = m_batches[b];
+        batch.coeffs.resize(rows[b].size(), rows[b][0].size());
+        for (int i = 0; i < batch.coeffs.rows(); ++i)
+            for (int j = 0; j < batch.coeffs.cols(); ++j)
+                batch.coeffs(i,j) = rows[b][i][j];
+        batch.values.resize(batch.coeffs.rows());
+    }
+}
+
+//==============================================================================
+
+void CollisionGroup::tabulateUniform(int nrows)
+{
+    m_table.resize(nrows, int((m_table_max-m_table_min)/m_table_delta)+1);
 
     double T = m_table_min;
     for (int j = 0; j < m_table.cols(); ++j) {
@@ -98,6 +174,158 @@ void CollisionGroup::manage(
             m_table(i,j) = m_integrals[i]->compute(T);
         T += m_table_delta;
     }
+
+    // Estimate the interpolation error at the interval midpoints
+    m_table_error = 0.0;
+    for (int j = 0; j < m_table.cols()-1; ++j) {
+        T = m_table_min + (j+0.5)*m_table_delta;
+        for (int i = 0; i < m_table.rows(); ++i)
+            m_table_error = std::max(m_table_error, relativeError(
+                0.5*(m_table(i,j)+m_table(i,j+1)), m_integrals[i]->compute(T)));
+    }
+}
+
+//==============================================================================
+
+void CollisionGroup::tabulateAdaptive(int nrows)
+{
+    // Intervals are not split below this width in ln(T), which bounds the
+    // table size when an integral is not smooth (ie: linear table data)
+    const double min_width  = 1.0e-3;
+    const int    max_passes = 30;
+
+    // Start from a coarse grid, uniform in ln(T)
+    const double x0 = std::log(m_table_min);
+    const double x1 = std::log(m_table_max);
+    const int n0 = 9;
+
+    vector<double>  x(n0);
+    vector<ArrayXd> y(n0, ArrayXd(nrows));
+    for (int k = 0; k < n0; ++k) {
+        x[k] = x0 + k*(x1-x0)/(n0-1);
+        for (int i = 0; i < nrows; ++i)
+            y[k](i) = m_integrals[i]->compute(std::exp(x[k]));
+    }
+
+    // Split every interval whose midpoint error is too large until all
+    // intervals satisfy the tolerance
+    ArrayXd ye(nrows), yi(nrows);
+    vector<double>  new_x;
+    vector<ArrayXd> new_y;
+
+    for (int pass = 0; ; ++pass) {
+        const int n = x.size();
+        m_table_lnT = Map<ArrayXd>(x.data(), n);
+        m_table.resize(nrows, n);
+        for (int k = 0; k < n; ++k)
+            m_table.col(k) = y[k];
+        monotoneSlopes(m_table_lnT, m_table, m_table_slopes);
+
+        new_x.clear();
+        new_y.clear();
+        m_table_error = 0.0;
+
+        for (int k = 0; k < n-1; ++k) {
+            const double xm = 0.5*(x[k]+x[k+1]);
+            for (int i = 0; i < nrows; ++i)
+                ye(i) = m_integrals[i]->compute(std::exp(xm));
+            interpolateCubic(xm, yi.data());
+
+            double error = 0.0;
+            for (int i = 0; i < nrows; ++i)
+                error = std::max(error, relativeError(yi(i), ye(i)));
+            m_table_error = std::max(m_table_error, error);
+
+            new_x.push_back(x[k]);
+            new_y.push_back(y[k]);
+            if (error > m_table_max_error && x[k+1]-x[k] > min_width &&
+                pass < max_passes) {
+                new_x.push_back(xm);
+                new_y.push_back(ye);
+            }
+        }
+
+        if (new_x.size() == n-1)
+            break;
+
+        new_x.push_back(x.back());
+        new_y.push_back(y.back());
+        x.swap(new_x);
+        y.swap(new_y);
+    }
+}
+
+//==============================================================================
+
+void CollisionGroup::monotoneSlopes(
+    const ArrayXd& x, const ArrayXXd& y, ArrayXXd& slopes)
+{
+    const int n = x.size();
+    slopes.resize(y.rows(), n);
+
+    for (int i = 0; i < y.rows(); ++i) {
+        if (n == 2) {
+            slopes.row(i).fill((y(i,1)-y(i,0))/(x(1)-x(0)));
+            continue;
+        }
+
+        // Interior points use the weighted harmonic mean of the secants, or
+        // zero at local extrema
+        for (int k = 1; k < n-1; ++k) {
+            const double h0 = x(k)-x(k-1), h1 = x(k+1)-x(k);
+            const double d0 = (y(i,k)-y(i,k-1))/h0;
+            const double d1 = (y(i,k+1)-y(i,k))/h1;
+            if (d0*d1 <= 0.0)
+                slopes(i,k) = 0.0;
+            else {
+                const double w0 = 2.0*h1+h0, w1 = h1+2.0*h0;
+                slopes(i,k) = (w0+w1)/(w0/d0 + w1/d1);
+            }
+        }
+
+        // End points use a shape preserving three-point formula
+        for (int end = 0; end < 2; ++end) {
+            const int k  = (end == 0 ? 0 : n-1);
+            const int s  = (end == 0 ? 1 : -1);
+            const double h0 = std::abs(x(k+s)-x(k));
+            const double h1 = std::abs(x(k+2*s)-x(k+s));
+            const double d0 = (y(i,k+s)-y(i,k))/(x(k+s)-x(k));
+            const double d1 = (y(i,k+2*s)-y(i,k+s))/(x(k+2*s)-x(k+s));
+
+            double m = ((2.0*h0+h1)*d0 - h0*d1)/(h0+h1);
+            if (m*d0 <= 0.0)
+                m = 0.0;
+            else if (d0*d1 <= 0.0 && std::abs(m) > 3.0*std::abs(d0))
+                m = 3.0*d0;
+            slopes(i,k) = m;
+        }
+    }
+}
+
+//==============================================================================
+
+void CollisionGroup::interpolateCubic(double lnT, double* const p_values) const
+{
+    const int n = m_table_lnT.size();
+    const double* const x = m_table_lnT.data();
+
+    // Find the interval containing lnT
+    int k = std::upper_bound(x, x+n, lnT) - x - 1;
+    k = std::max(0, std::min(k, n-2));
+
+    // Cubic Hermite basis functions
+    const double h   = x[k+1]-x[k];
+    const double t   = (lnT-x[k])/h;
+    const double t1  = 1.0-t;
+    const double h00 = (1.0+2.0*t)*t1*t1;
+    const double h10 = t*t1*t1*h;
+    const double h01 = t*t*(3.0-2.0*t);
+    const double h11 = -t*t*t1*h;
+
+    for (int i = 0; i < m_table.rows(); ++i)
+        p_values[i] =
+            h00*m_table(i,k)   + h10*m_table_slopes(i,k) +
+            h01*m_table(i,k+1) + h11*m_table_slopes(i,k+1);
 }
 
 //==============================================================================
@@ -105,8 +333,18 @@ void CollisionGroup::manage(
 CollisionGroup& CollisionGroup::update(
     double T, const Thermodynamics::Thermodynamics& thermo)
 {
+    // Nothing to do if the values are already up to date
+    if (m_epoch == thermo.stateEpoch() && m_T == T)
+        return *this;
+    m_epoch = thermo.stateEpoch();
+    m_T = T;
+
     // Compute tabulated data
-    if (m_table.rows() > 0) {
+    if (m_table.rows() > 0 && m_table_lnT.size() > 0) {
+        // Clip the temperature to the table bounds
+        double Tc = std::max(std::min(T, m_table_max), m_table_min);
+        interpolateCubic(std::log(Tc), m_unique_vals.data());
+    } else if (m_table.rows() > 0) {
         // Clip the temperature to the table bounds
         double Tc = std::max(std::min(T, m_table_max), m_table_min);
 
@@ -120,8 +358,16 @@ CollisionGroup& CollisionGroup::update(
             ratio*(m_table.col(i) - m_table.col(i-1)) + m_table.col(i);
     }
 
-    // Compute non tabulated data
-    for (int i = m_table.rows(); i < m_integrals.size(); ++i) {
+    // Compute non tabulated data, one batch of integrals at a time
+    for (int b = 0; b < m_batches.size(); ++b) {
+        Batch& batch = m_batches[b];
+        CollisionIntegral::computeBatch(batch.form, T, batch.coeffs, batch.values);
+        for (int i = 0; i < batch.index.size(); ++i)
+            m_unique_vals[batch.index[i]] = batch.values[i];
+    }
+
+    for (int k = 0; k < m_scalar.size(); ++k) {
+        const int i = m_scalar[k];
         m_integrals[i]->getOtherParams(thermo);
         m_unique_vals[i] = m_integrals[i]->compute(T);
     }
@@ -133,6 +379,47 @@ CollisionGroup& CollisionGroup::update(
     return *this;
 }
 
+//==============================================================================
+
+const Eigen::ArrayXd& CollisionGroup::dlnT()
+{
+    if (m_dlnT_epoch == m_epoch && m_dlnT_T == m_T)
+        return m_dlnT;
+    m_dlnT_epoch = m_epoch;
+    m_dlnT_T = m_T;
+
+    // The other parameters of the integrals were set by the last update
+    m_unique_dlnT.resize(m_integrals.size());
+    for (int i = 0; i < m_integrals.size(); ++i)
+        m_unique_dlnT[i] = m_integrals[i]->dlnT(m_T);
+
+    m_dlnT.resize(m_size);
+    for (int i = 0; i < m_size; ++i)
+        m_dlnT[i] = m_unique_dlnT[m_map[i]];
+
+    return m_dlnT;
+}
+
+//==============================================================================
+
+const Eigen::ArrayXd& CollisionGroup::dlnDebyeLength()
+{
+    if (m_dlnL_epoch == m_epoch && m_dlnL_T == m_T)
+        return m_dlnL;
+    m_dlnL_epoch = m_epoch;
+    m_dlnL_T = m_T;
+
+    m_unique_dlnL.resize(m_integrals.size());
+    for (int i = 0; i < m_integrals.size(); ++i)
+        m_unique_dlnL[i] = m_integrals[i]->dlnDebyeLength(m_T);
+
+    m_dlnL.resize(m_size);
+    for (int i = 0; i < m_size; ++i)
+        m_dlnL[i] = m_unique_dlnL[m_map[i]];
+
+    return m_dlnL;
+}
+
 //==============================================================================
 
     } // namespace Transport
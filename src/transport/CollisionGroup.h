@@ -52,17 +52,27 @@ public:
 
     /**
      * Constructs an empty CollisionGroup with specified tabulation parameters.
-     * @param tabulate - whether or not to tabulate collision integrals
-     * @param min      - minimum temperature for tabulation
-     * @param max      - maximum temperature for tabulation
-     * @param delta    - temperature spacing in the table
+     * If max_error is positive, the table breakpoints are placed adaptively in
+     * \f$\ln T\f$ until monotone cubic interpolation reproduces every
+     * integral within the given relative error, and delta is ignored.
+     * Otherwise, a uniform table with linear interpolation is used.
+     *
+     * @param tabulate  - whether or not to tabulate collision integrals
+     * @param min       - minimum temperature for tabulation
+     * @param max       - maximum temperature for tabulation
+     * @param delta     - temperature spacing in the table
+     * @param max_error - maximum relative error of an adaptive table
      */
     CollisionGroup(
         bool tabulate = true,
-        double min = 300.0, double max = 20000.0, double delta = 100.0) :
+        double min = 300.0, double max = 20000.0, double delta = 100.0,
+        double max_error = 0.0) :
         m_tabulate(tabulate),
         m_size(0),
-        m_table_min(min), m_table_max(max), m_table_delta(delta)
+        m_epoch(0), m_T(0.0), m_dlnT_epoch(0), m_dlnT_T(0.0),
+        m_dlnL_epoch(0), m_dlnL_T(0.0),
+        m_table_min(min), m_table_max(max), m_table_delta(delta),
+        m_table_max_error(max_error), m_table_error(0.0)
     { }
 
     /**
@@ -87,7 +97,9 @@ public:
 
     /**
      * Updates the collision integral values for this collision group using the
-     * given temperature.  Returns a reference to itself.
+     * given temperature.  The values are only recomputed if the temperature or
+     * the state of thermo changed since the last update.  Returns a reference
+     * to itself.
      */
     CollisionGroup& update(
         double T, const Thermodynamics::Thermodynamics& thermo);
@@ -112,14 +124,71 @@ public:
      */
     const Eigen::ArrayXd& array() const { return m_values; }
 
+    /**
+     * Returns \f$d\ln Q/d\ln T\f$ of each integral at the temperature of the
+     * last update.  The derivatives are taken from the integrals themselves,
+     * not from the table, and only computed once per update.
+     */
+    const Eigen::ArrayXd& dlnT();
+
+    /**
+     * Returns \f$d\ln Q/d\ln\lambda_D\f$ of each integral with respect to
+     * the Debye length, at the state of the last update.  Integrals which do
+     * not depend on the Debye length give zero.
+     */
+    const Eigen::ArrayXd& dlnDebyeLength();
+
+    /**
+     * Number of temperature breakpoints in the table (0 if not tabulated).
+     */
+    int tableSize() const { return m_table.cols(); }
+
+    /**
+     * Largest relative interpolation error of the table measured at the
+     * interval midpoints when the table was generated.
+     */
+    double tableError() const { return m_table_error; }
+
+    /**
+     * Memory used by the table data in bytes.
+     */
+    std::size_t tableBytes() const {
+        return sizeof(double)*(m_table.size() + m_table_slopes.size() +
+            m_table_lnT.size());
+    }
+
 private:
 
+    /// Tabulates the integrals which can be tabulated.
+    void tabulate();
+
+    /// Groups the non-tabulated integrals by batch form.
+    void setupBatches();
+
+    /// Fills a uniform table for the first nrows integrals.
+    void tabulateUniform(int nrows);
+
+    /// Fills an adaptive log-T table for the first nrows integrals.
+    void tabulateAdaptive(int nrows);
+
+    /// Computes monotone cubic (Fritsch-Carlson) slopes of the table rows.
+    static void monotoneSlopes(
+        const Eigen::ArrayXd& x, const Eigen::ArrayXXd& y,
+        Eigen::ArrayXXd& slopes);
+
+    /// Interpolates all rows of an adaptive table at the given ln(T).
+    void interpolateCubic(double lnT, double* const p_values) const;
+
     /// Whether or not to tabulate integrals managed by this group
     bool m_tabulate;
 
     /// Number of integrals managed by this group
     int  m_size;
 
+    /// State epoch and temperature of the last update
+    unsigned long m_epoch;
+    double m_T;
+
     /// vector of non-tabulated integrals
     std::vector< SharedPtr<CollisionIntegral> > m_integrals;
 
@@ -128,11 +197,41 @@ private:
     Eigen::ArrayXd   m_unique_vals;
     std::vector<int> m_map;
 
+    /// Logarithmic temperature derivatives and the update they belong to
+    unsigned long    m_dlnT_epoch;
+    double           m_dlnT_T;
+    Eigen::ArrayXd   m_dlnT;
+    Eigen::ArrayXd   m_unique_dlnT;
+
+    /// Logarithmic Debye length derivatives and the update they belong to
+    unsigned long    m_dlnL_epoch;
+    double           m_dlnL_T;
+    Eigen::ArrayXd   m_dlnL;
+    Eigen::ArrayXd   m_unique_dlnL;
+
     /// Table of tabulated integrals versus temperature
     double m_table_min;
     double m_table_max;
     double m_table_delta;
+    double m_table_max_error;
+    double m_table_error;
     Eigen::ArrayXXd m_table;
+
+    /// Breakpoints in ln(T) and ln(T) slopes of an adaptive table
+    Eigen::ArrayXd  m_table_lnT;
+    Eigen::ArrayXXd m_table_slopes;
+
+    /// Integrals of the same functional form evaluated together
+    struct Batch {
+        CollisionIntegral::BatchForm form;
+        std::vector<int> index;   // positions in the unique integral list
+        Eigen::ArrayXXd  coeffs;  // one row of coefficients per integral
+        Eigen::ArrayXd   values;
+    };
+    std::vector<Batch> m_batches;
+
+    /// Non-tabulated integrals which are evaluated one by one
+    std::vector<int> m_scalar;
 };
 
 	} // namespace Transport
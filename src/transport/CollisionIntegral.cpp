@@ -114,6 +114,55 @@ CollisionIntegral::CollisionIntegral(CollisionIntegral::ARGS args) :
 
 //==============================================================================
 
+void CollisionIntegral::computeBatch(
+    BatchForm form, double T, const Eigen::ArrayXXd& c, Eigen::ArrayXd& values)
+{
+    const double lnT = std::log(T);
+
+    switch (form) {
+    // c = [factor, a_0, ..., a_n-1]
+    case EXP_POLY:
+        values = c.col(1);
+        for (int j = 2; j < c.cols(); ++j)
+            values = values*lnT + c.col(j);
+        values = c.col(0)*values.exp();
+        break;
+
+    // c = [factor, ln(T) shift, a_0, ..., a_6]
+    case BRUNO_EQ11:
+    case PIRANI: {
+        const Eigen::ArrayXd x  = lnT + c.col(1);
+        const Eigen::ArrayXd e1 = ((x - c.col(4))/c.col(5)).exp();
+        const Eigen::ArrayXd e2 = ((x - c.col(7))/c.col(8)).exp();
+        values = (c.col(2) + x*c.col(3))*e1/(e1+1.0/e1) +
+            c.col(6)*e2/(e2+1.0/e2);
+        if (form == PIRANI)
+            values = values.exp();
+        values *= c.col(0);
+        break;
+    }
+
+    default:
+        values.setZero();
+    }
+}
+
+//==============================================================================
+
+double CollisionIntegral::dlnT_(double T)
+{
+    // Step in ln(T) balancing truncation and round-off errors
+    const double h = 1.0e-4;
+
+    const double Q = compute_(T);
+    if (Q == 0.0)
+        return 0.0;
+
+    return (compute_(T*std::exp(h)) - compute_(T*std::exp(-h)))/(2.0*h*Q);
+}
+
+//==============================================================================
+
 double CollisionIntegral::loadSpeciesParameter(
     Mutation::Utilities::IO::XmlElement& root, const std::string& parameter,
     const std::string& species, std::string units, double def)
@@ -199,6 +248,8 @@ private:
 
     double compute_(double T) { return m_value; }
 
+    double dlnT_(double T) { return 0.0; }
+
     /**
      * Returns true if the constant value is the same.
      */
@@ -235,6 +286,8 @@ private:
 
 	double compute_(double T) { return m_value; }
 
+	double dlnT_(double T) { return 0.0; }
+
 	/**
      * Returns true if the constant value is the same.
      */
@@ -277,6 +330,12 @@ public:
             std::back_inserter(m_params));
     }
 
+    BatchForm batchData(std::vector<double>& coeffs) {
+        coeffs.assign(1, baseFactor());
+        coeffs.insert(coeffs.end(), m_params.begin(), m_params.end());
+        return EXP_POLY;
+    }
+
 private:
 
     double compute_(double T) {
@@ -287,6 +346,18 @@ private:
         return std::exp(val);
     }
 
+    // Derivative of the polynomial in ln(T)
+    double dlnT_(double T) {
+        double lnT = std::log(T);
+        double val = m_params[0];
+        double der = 0.0;
+        for (int i = 1; i < m_params.size(); ++i) {
+            der = der*lnT + val;
+            val = val*lnT + m_params[i];
+        }
+        return der;
+    }
+
     /**
      * Returns true if the constant value is the same.
      */
@@ -374,6 +445,15 @@ private:
         }
     }
 
+    double dlnT_(double T) {
+        switch(m_type) {
+        case AST:
+        case Q11: return m_ci2->dlnT(T) - m_ci1->dlnT(T);
+        case Q22: return m_ci1->dlnT(T) + m_ci2->dlnT(T);
+        }
+        return 0.0;
+    }
+
     /**
      * Returns true if the constant value is the same.
      */
@@ -623,6 +703,8 @@ private:
 
     double compute_(double T) { return m_ratio * m_integral->compute(T); }
 
+    double dlnT_(double T) { return m_integral->dlnT(T); }
+
     /**
      * Returns true if the ratio and integral are the same.
      */
@@ -689,6 +771,13 @@ private:
         return std::sqrt(Q1*Q1 + Q2*Q2);
     }
 
+    double dlnT_(double T)
+    {
+        double Q1 = m_Q1->compute(T);
+        double Q2 = m_Q2->compute(T);
+        return (Q1*Q1*m_Q1->dlnT(T) + Q2*Q2*m_Q2->dlnT(T))/(Q1*Q1 + Q2*Q2);
+    }
+
     SharedPtr<CollisionIntegral> getIntegral(
             CollisionIntegral::ARGS args, const std::string& tag)
     {
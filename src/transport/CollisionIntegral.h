@@ -33,9 +33,13 @@
 #include "Units.h"
 #include "SharedPtr.h"
 
+#include <Eigen/Dense>
+
+
 #include <iostream>
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 namespace Mutation {
 
@@ -69,6 +73,17 @@ public:
 	/// Returns name of this type.
 	static std::string typeName() { return "CollisionIntegral"; }
 
+	/**
+	 * Functional forms which can be evaluated for many integrals at once with
+	 * computeBatch().
+	 */
+	enum BatchForm {
+	    NO_BATCH = 0,
+	    EXP_POLY,   ///< exp(sum_i a_i (ln T)^(n-1-i))
+	    BRUNO_EQ11, ///< Eq. (11) of Bruno et al. 2010
+	    PIRANI      ///< exp() of Eq. (11) in ln(kT/phi0), Laricchiuta 2007
+	};
+
 	/**
 	 * Constructor used in self registration.
 	 */
@@ -104,6 +119,38 @@ public:
 		return m_fac*m_units.convertToBase(compute_(T));
 	}
 
+	/**
+	 * Returns the logarithmic derivative \f$d\ln Q/d\ln T\f$ of this integral
+	 * at the given temperature.  Any other parameters set by getOtherParams()
+	 * (ie: the Debye length) are held fixed.
+	 */
+	double dlnT(double T) { return dlnT_(T); }
+
+	/**
+	 * Returns the logarithmic derivative \f$d\ln Q/d\ln\lambda_D\f$ of this
+	 * integral with respect to the Debye length set by getOtherParams(), at
+	 * the given temperature.  The default is zero, for integrals which do not
+	 * depend on the Debye length.
+	 */
+	double dlnDebyeLength(double T) { return dlnDebyeLength_(T); }
+
+	/**
+	 * Returns the batch form of this integral and fills coeffs with the
+	 * coefficients used by computeBatch().  The first coefficient is always
+	 * the factor which converts the kernel value to m^2.  Integrals which
+	 * depend on more than the temperature return NO_BATCH, the default.
+	 */
+	virtual BatchForm batchData(std::vector<double>& coeffs) { return NO_BATCH; }
+
+	/**
+	 * Evaluates the integrals of the given batch form at temperature T.  Each
+	 * row of coeffs holds the coefficients given by batchData() for one
+	 * integral and the results are stored in values.
+	 */
+	static void computeBatch(
+	    BatchForm form, double T, const Eigen::ArrayXXd& coeffs,
+	    Eigen::ArrayXd& values);
+
 	/**
 	 * Gets any other parameters necessary to compute the integral which cannot
 	 * be determined from the temperature alone.  Default behavior is to do
@@ -136,6 +183,18 @@ protected:
 
 	virtual double compute_(double T) = 0;
 
+	/**
+	 * Computes \f$d\ln Q/d\ln T\f$.  The default is a central difference of
+	 * compute_() in \f$\ln T\f$, which integrals with a differentiable fit
+	 * override with the analytic derivative.
+	 */
+	virtual double dlnT_(double T);
+
+	/**
+	 * Computes \f$d\ln Q/d\ln\lambda_D\f$, zero by default.
+	 */
+	virtual double dlnDebyeLength_(double T) { return 0.0; }
+
 	/**
 	 * Ensures that collision integral types can be compared.
 	 */
@@ -161,6 +220,11 @@ protected:
 	 */
 	void setFactor(double fac) { m_fac = fac; }
 
+	/**
+	 * Returns the factor which converts values of compute_() to m^2.
+	 */
+	double baseFactor() { return m_fac*m_units.convertToBase(1.0); }
+
 	/**
 	 * Loads pure species parameter from the collision database with the given
 	 * name for the given species in base units.  If the parameter is not
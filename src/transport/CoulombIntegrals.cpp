@@ -32,14 +32,18 @@
 #include "CollisionIntegral.h"
 #include "CollisionPair.h"
 #include "CoulombIntegrals.h"
+#include "Interpolators.h"
 #include "Thermodynamics.h"
 #include "XMLite.h"
+using namespace Mutation::Numerics;
 using namespace Mutation::Thermodynamics;
 using namespace Mutation::Utilities::Config;
+using namespace Mutation::Utilities::IO;
 
 #include <Eigen/Dense>
 using namespace Eigen;
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 using namespace std;
@@ -58,22 +62,25 @@ double DebyeHuckleEvaluator::operator() (double T, CoulombType type)
     const double b = QE*QE / (8.0*PI*EPS0*KB*T);
 
     // Clip maximum lambda
-    m_lambda = std::min(m_lambda, 2.0*sm_tstvec[N_TST_POINTS-1]*b);
+    const double lambda = std::min(m_lambda, 2.0*sm_tstvec[N_TST_POINTS-1]*b);
 
     // Check if we need to update the values
-    if (std::abs(T-m_last_T) + std::abs(m_lambda-m_last_lambda) > 1.0e-10) {
+    if (std::abs(T-m_last_T) + std::abs(lambda-m_last_lambda) > 1.0e-10) {
         // Reduced temperature
-        const double Tst = std::max(0.5*m_lambda/b, sm_tstvec[0]);
+        const double Tst = std::max(0.5*lambda/b, sm_tstvec[0]);
 
         // Interpolate the table using reduced temperature
-        interpolate(Tst);
+        if (m_cubic)
+            interpolateFine(Tst);
+        else
+            interpolate(Tst);
 
         // Convert from reduced form
-        m_values.head(BST_ATT) *= PI*m_lambda*m_lambda/(Tst*Tst);
+        m_values.head(BST_ATT) *= PI*lambda*lambda/(Tst*Tst);
 
         // Save last updated state
         m_last_T = T;
-        m_last_lambda = m_lambda;
+        m_last_lambda = lambda;
     }
 
     switch (type) {
@@ -97,6 +104,12 @@ void DebyeHuckleEvaluator::setDebyeLength(double Te, double ne)
     assert(Te >= 0.0);
     assert(ne >= 0.0);
 
+    // Every Debye-Huckle integral sets the same length, only do it once
+    if (Te == m_last_Te && ne == m_last_ne)
+        return;
+    m_last_Te = Te;
+    m_last_ne = ne;
+
     // Protect against small electron number densities
     ne = std::max(ne, 1.0e-16);
 
@@ -104,6 +117,33 @@ void DebyeHuckleEvaluator::setDebyeLength(double Te, double ne)
     m_lambda = std::sqrt(0.5*EPS0*KB*Te/(ne*QE*QE));
 }
 
+double DebyeHuckleEvaluator::dlnDebyeLength(double T, CoulombType type)
+{
+    // Step in ln(lambda) balancing truncation and round-off errors
+    const double h = 1.0e-4;
+
+    const double Q = (*this)(T, type);
+    if (Q == 0.0)
+        return 0.0;
+
+    // The perturbations are usually below the tolerance of the cached values
+    // in meters, so those are invalidated before each evaluation
+    const double lambda = m_lambda;
+    m_lambda = lambda*std::exp(h);
+    m_last_lambda = -1.0;
+    const double Qp = (*this)(T, type);
+    m_lambda = lambda*std::exp(-h);
+    m_last_lambda = -1.0;
+    const double Qm = (*this)(T, type);
+
+    // Restore the values at the actual Debye length
+    m_lambda = lambda;
+    m_last_lambda = -1.0;
+    (*this)(T, type);
+
+    return (Qp - Qm)/(2.0*h*Q);
+}
+
 void DebyeHuckleEvaluator::interpolate(double Tst)
 {
     // Clip to table boundaries
@@ -113,7 +153,8 @@ void DebyeHuckleEvaluator::interpolate(double Tst)
         m_values = sm_table.row(N_TST_POINTS-1);
     else {
         // Find the index to interpolate between
-        int i = 1; while (sm_tstvec[i] < Tst) ++i;
+        const double* const p_tst = sm_tstvec.data();
+        int i = std::lower_bound(p_tst+1, p_tst+N_TST_POINTS, Tst) - p_tst;
 
         // Interpolate
         m_values = (sm_table.row(i)-sm_table.row(i-1))*(Tst-sm_tstvec[i])/
@@ -122,6 +163,46 @@ void DebyeHuckleEvaluator::interpolate(double Tst)
 }
 
 
+void DebyeHuckleEvaluator::interpolateFine(double Tst)
+{
+    const double x0 = std::log(sm_tstvec[0]);
+    const double dx = (std::log(sm_tstvec[N_TST_POINTS-1]) - x0) /
+        (N_TST_FINE_POINTS-1);
+
+    // Uniform spacing in ln(T*) gives the index directly
+    const double s = (std::log(Tst) - x0) / dx;
+    if (s <= 0.0)
+        m_values = sm_fine_table.row(0);
+    else if (s >= N_TST_FINE_POINTS-1)
+        m_values = sm_fine_table.row(N_TST_FINE_POINTS-1);
+    else {
+        const int i = static_cast<int>(s);
+        const double r = s - i;
+        m_values = (1.0-r)*sm_fine_table.row(i) + r*sm_fine_table.row(i+1);
+    }
+}
+
+
+ArrayXXd DebyeHuckleEvaluator::initFineTable()
+{
+    const int n = N_TST_POINTS;
+    const ArrayXd x = sm_tstvec.log();
+    const double x0 = x[0];
+    const double dx = (x[n-1] - x0) / (N_TST_FINE_POINTS-1);
+
+    ArrayXXd fine(N_TST_FINE_POINTS, N_TABLE_TYPES);
+    for (int j = 0; j < N_TABLE_TYPES; ++j) {
+        const ArrayXd y = sm_table.col(j);
+        MCHInterpolator<double> mch(
+            Interpolator<double>::ARGS(x.data(), y.data(), n));
+        for (int i = 0; i < N_TST_FINE_POINTS; ++i)
+            fine(i,j) = mch(x0 + i*dx);
+    }
+
+    return fine;
+}
+
+
 // Initialize the T* index values
 Array<double, N_TST_POINTS, 1> init_tstvec() {
     Array<double, N_TST_POINTS, 1> vec; vec <<
@@ -169,9 +250,18 @@ Array<double, N_TST_POINTS, N_TABLE_TYPES, ColMajor> init_table() {
 Array<double, N_TST_POINTS, N_TABLE_TYPES, ColMajor>
     DebyeHuckleEvaluator::sm_table = init_table();
 
+// Refined table, must be initialized after the table and T* values above
+ArrayXXd DebyeHuckleEvaluator::sm_fine_table =
+    DebyeHuckleEvaluator::initFineTable();
+
 /**
  * Represents a collision integral computed with the Debye-Huckle potential
  * (Coulomb potential screened by the Debye length).
+ *
+ * The tabulated data is linearly interpolated by default.  Setting the
+ * interpolator attribute to "MonotoneCubic", on the integral or for all
+ * Debye-Huckel integrals in the global-options, uses the refined cubic table
+ * instead.
  */
 class DebyeHuckleColInt : public CollisionIntegral
 {
@@ -186,6 +276,26 @@ public:
     {
         assert(args.pair.type() == ATTRACTIVE || args.pair.type() == REPULSIVE);
 
+        // Interpolation of the table, global option first
+        string interpolator = "Linear";
+        XmlElement& root = args.xml.document()->root();
+        XmlElement::const_iterator options = root.findTag("global-options");
+        if (options != root.end()) {
+            XmlElement::const_iterator dh =
+                options->findTagWithAttribute("integral", "type", "Debye-Huckel");
+            if (dh != options->end())
+                dh->getAttribute("interpolator", interpolator, interpolator);
+        }
+        args.xml.getAttribute("interpolator", interpolator, interpolator);
+
+        if (interpolator == "Linear")
+            m_cubic = false;
+        else if (interpolator == "MonotoneCubic")
+            m_cubic = true;
+        else
+            args.xml.parseError(
+                "Debye-Huckel interpolator must be Linear or MonotoneCubic.");
+
         // Set the type of integral we need
         string kind = args.kind;
         CollisionType type = args.pair.type();
@@ -219,33 +329,50 @@ public:
 
     // Set the Debye length
     void getOtherParams(const class Thermodynamics& thermo) {
-        sm_evaluator.setDebyeLength(
+        evaluator().setDebyeLength(
             thermo.Te(),
             thermo.hasElectrons() ? thermo.numberDensity()*thermo.X()[0] : 0.0);
     };
 
 private:
 
-    double compute_(double T) { return sm_evaluator(T, m_type); }
+    double compute_(double T) { return evaluator()(T, m_type); }
+
+    double dlnDebyeLength_(double T) {
+        return evaluator().dlnDebyeLength(T, m_type);
+    }
 
     /**
-     * Returns true if the constant value is the same.
+     * Returns the evaluator of this thread.  The evaluators cache the Debye
+     * length and the last interpolation, so they are not shared among threads.
+     */
+    DebyeHuckleEvaluator& evaluator() const {
+        return (m_cubic ? sm_cubic : sm_linear);
+    }
+
+    /**
+     * Returns true if the integral type and interpolation are the same.
      */
     bool isEqual(const CollisionIntegral& ci) const {
         const DebyeHuckleColInt& compare =
             dynamic_cast<const DebyeHuckleColInt&>(ci);
-        return (m_type == compare.m_type);
+        return (m_type == compare.m_type &&
+            m_cubic == compare.m_cubic);
     }
 
 private:
 
     CoulombType m_type;
-    static DebyeHuckleEvaluator sm_evaluator;
+    bool m_cubic;
+
+    static thread_local DebyeHuckleEvaluator sm_linear;
+    static thread_local DebyeHuckleEvaluator sm_cubic;
 
 }; // class CoulombColInt
 
-// Initialization of the DebyeHuckleEvaluator
-DebyeHuckleEvaluator DebyeHuckleColInt::sm_evaluator;
+// Initialization of the DebyeHuckleEvaluators
+thread_local DebyeHuckleEvaluator DebyeHuckleColInt::sm_linear(false);
+thread_local DebyeHuckleEvaluator DebyeHuckleColInt::sm_cubic(true);
 
 // Register the "Debye-Huckle" CollisionIntegral
 ObjectProvider<DebyeHuckleColInt, CollisionIntegral> DebyeHuckle_ci("Debye-Huckel");
@@ -59,9 +59,18 @@ enum CoulombType {
 // Number of temperature points in the collision integral table
 #define N_TST_POINTS 26
 
+// Number of points of the refined table, uniformly spaced in ln(T*)
+#define N_TST_FINE_POINTS 401
+
 /**
  * Evaluates the Debye-Huckle collision integrals all at once because this is
  * faster then doing them individually all the time.
+ *
+ * By default the tabulated data is linearly interpolated in reduced
+ * temperature.  When cubic interpolation is requested, a finer table is used
+ * instead, which is precomputed once by monotone cubic interpolation of the
+ * data in ln(T*).  Its uniform spacing lets all the integrals be interpolated
+ * in a single pass without searching the table.
  */
 class DebyeHuckleEvaluator
 {
@@ -69,10 +78,14 @@ public:
     /**
      * Constructor.
      */
-    DebyeHuckleEvaluator() :
-        m_lambda(0.0), m_last_T(-1.0), m_last_lambda(-1.0)
+    DebyeHuckleEvaluator(bool cubic = false) :
+        m_cubic(cubic), m_lambda(0.0), m_last_T(-1.0), m_last_lambda(-1.0),
+        m_last_Te(-1.0), m_last_ne(-1.0)
     { }
 
+    /// Returns true if the refined, cubic interpolated table is used.
+    bool cubic() const { return m_cubic; }
+
     /**
      * Computes the Coulomb integral type at the temperature T.
      */
@@ -83,6 +96,12 @@ public:
      */
     void setDebyeLength(double Te, double ne);
 
+    /**
+     * Computes \f$d\ln Q/d\ln\lambda_D\f$ of the Coulomb integral type at
+     * the temperature T by a central difference in the Debye length.
+     */
+    double dlnDebyeLength(double T, CoulombType type);
+
 private:
 
     /**
@@ -90,14 +109,26 @@ private:
      */
     void interpolate(double Tst);
 
+    /**
+     * Interpolates the refined table based on reduced temperature.
+     */
+    void interpolateFine(double Tst);
+
+    /// Builds the refined table from the tabulated data.
+    static Eigen::ArrayXXd initFineTable();
+
 private:
 
+    bool m_cubic;
     double m_lambda;
     double m_last_T;
     double m_last_lambda;
+    double m_last_Te;
+    double m_last_ne;
 
     static Eigen::Array<double, N_TST_POINTS, N_TABLE_TYPES, Eigen::ColMajor> sm_table;
     static Eigen::Array<double, N_TST_POINTS, 1> sm_tstvec;
+    static Eigen::ArrayXXd sm_fine_table;
     Eigen::Array<double, N_TABLE_TYPES, 1> m_values;
 };
 
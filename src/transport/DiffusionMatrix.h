@@ -60,6 +60,20 @@ public:
     /// Returns the multicomponent diffusion matrix.
     virtual const Eigen::MatrixXd& diffusionMatrix() = 0;
 
+    /**
+     * Computes the diffusion velocities
+     * \f[ V_i = -\sum_j D_{ij} d_j \f]
+     * for the given driving forces.  The default implementation forms the
+     * diffusion matrix, algorithms with more structure should override it.
+     */
+    virtual void diffusionVelocities(
+        const double* const p_d, double* const p_V)
+    {
+        const int ns = m_collisions.nSpecies();
+        Eigen::Map<Eigen::VectorXd>(p_V, ns) =
+            -diffusionMatrix() * Eigen::Map<const Eigen::VectorXd>(p_d, ns);
+    }
+
 protected:
 
     CollisionDB& m_collisions;
@@ -101,10 +101,10 @@ double ElectronSubSystem::electronThermalConductivity(int order)
 
     // 2nd order solution
     if (order == 2)
-        return fac * xe / m_collisions.Lee<2>()(1,1);
+        return fac * xe / system<2>().L(1,1);
 
     // 3rd order solution
-    Eigen::Matrix3d L = m_collisions.Lee<3>();
+    const Eigen::Matrix3d& L = system<3>().L;
     return fac * xe * L(2,2) / (L(1,1)*L(2,2) - L(1,2)*L(1,2));
 }
 
@@ -262,6 +262,53 @@ Eigen::Vector3d ElectronSubSystem::electronDiffusionCoefficient2B(
     return Dee;
 }
 
+//==============================================================================
+
+template <int P>
+void ElectronSubSystem::electronProperties(
+    ElectronTransportProperties& props, bool anisotropic)
+{
+    const double fac =
+        m_thermo.numberDensity()*m_thermo.X()[0]*QE*QE/(KB*m_thermo.Te());
+
+    props.D_e      = electronDiffusionCoefficient<P>();
+    props.sigma    = fac * props.D_e;
+    props.lambda_e = (P == 1 ? 0.0 : electronThermalConductivity(P));
+    props.k_Te     = electronThermalDiffusionRatio<P>();
+
+    if (!anisotropic) return;
+
+    props.D_e_B      = electronDiffusionCoefficientB<P>();
+    props.sigma_B    = fac * props.D_e_B;
+    props.lambda_e_B = electronThermalConductivityB<P>();
+    props.k_Te_B     = electronThermalDiffusionRatioB<P>();
+}
+
+//==============================================================================
+
+void ElectronSubSystem::electronProperties(
+    ElectronTransportProperties& props, int order, bool anisotropic)
+{
+    if (!m_thermo.hasElectrons()) {
+        props.sigma = props.lambda_e = props.D_e = props.k_Te = 0.0;
+        props.sigma_B.setZero();
+        props.lambda_e_B.setZero();
+        props.D_e_B.setZero();
+        props.k_Te_B.setZero();
+        return;
+    }
+
+    switch (order) {
+    case 1: electronProperties<1>(props, anisotropic); break;
+    case 2: electronProperties<2>(props, anisotropic); break;
+    case 3: electronProperties<3>(props, anisotropic); break;
+    default:
+        std::cout << "Warning: invalid order for electron transport properties.  ";
+        std::cout << "Using order 3..." << std::endl;
+        electronProperties<3>(props, anisotropic);
+    }
+}
+
 //==============================================================================
 
     } // namespace Transport
@@ -35,11 +35,64 @@
 #include "Constants.h"
 
 #include <Eigen/Dense>
+#include <complex>
+#include <tuple>
 #include <vector>
 
 namespace Mutation {
     namespace Transport {
 
+/**
+ * Electron transport properties computed together by
+ * ElectronSubSystem::electronProperties().  The anisotropic members are only
+ * set when requested and hold the parallel, perpendicular and transverse
+ * components.
+ */
+struct ElectronTransportProperties
+{
+    double sigma;               ///< electric conductivity in S/m
+    double lambda_e;            ///< electron thermal conductivity in W/m-K
+    double D_e;                 ///< electron diffusion coefficient
+    double k_Te;                ///< electron thermal diffusion ratio
+
+    Eigen::Vector3d sigma_B;    ///< anisotropic electric conductivity in S/m
+    Eigen::Vector3d lambda_e_B; ///< anisotropic electron thermal conductivity
+    Eigen::Vector3d D_e_B;      ///< anisotropic electron diffusion coefficient
+    Eigen::Vector3d k_Te_B;     ///< anisotropic electron thermal diffusion ratio
+};
+
+/**
+ * Holds the electron subsystem matrices of order P and their inverses for one
+ * state.  The real matrices, the complex (B-field) matrices and the
+ * \f$\beta^{pD_i}\f$ coefficients are each assembled at most once per state,
+ * when first needed.  The inverses are the closed-form fixed-size inverses.
+ */
+template <int P>
+struct ElectronSystem
+{
+    /// Size of the blocks without the first row and column.
+    static const int R = (P > 1 ? P-1 : 1);
+
+    ElectronSystem() : epoch(0), B_epoch(0), beta_epoch(0), B(0.0) { }
+
+    unsigned long epoch;      ///< state epoch of the real matrices
+    unsigned long B_epoch;    ///< state epoch of the complex matrices
+    unsigned long beta_epoch; ///< state epoch of the beta coefficients
+    double B;                 ///< B-field of the complex matrices
+
+    double fac;                                         ///< Leefac()
+    Eigen::Matrix<double,P,P> L;                        ///< Lee<P>()
+    Eigen::Matrix<double,P,P> Linv;                     ///< L^-1
+    Eigen::Matrix<double,R,R> Lr_inv;                   ///< bottom-right L^-1
+    Eigen::Matrix<double,P,P> L1;                       ///< fac*L
+    Eigen::Matrix<double,P,P> L1inv;                    ///< L1^-1
+    Eigen::Matrix<double,R,R> L1r_inv;                  ///< bottom-right L1^-1
+    Eigen::Matrix<std::complex<double>,P,P> L2;         ///< L1 + i LBee<P>()
+    Eigen::Matrix<std::complex<double>,P,P> L2inv;      ///< L2^-1
+    Eigen::Matrix<std::complex<double>,R,R> L2r_inv;    ///< bottom-right L2^-1
+    Eigen::Matrix<double,P,Eigen::Dynamic> beta;        ///< BetaDi<P>
+};
+
 /**
  * Provides functions which solve the electron-heavy transport systems.  It is
  * convenient to package all of these functions into a separate class.
@@ -106,6 +159,16 @@ public:
     /// Anisotropic second-order electron thermal diffusion ratios.
     const Eigen::Matrix<double,-1,3>& electronThermalDiffusionRatios2B(int order = 3);
 
+    /**
+     * Computes the electric conductivity, electron thermal conductivity,
+     * electron diffusion coefficient and electron thermal diffusion ratio
+     * from one assembly of the electron subsystem, and their anisotropic
+     * forms as well if requested.  All properties are zero without electrons.
+     */
+    void electronProperties(
+        ElectronTransportProperties& props, int order = 3,
+        bool anisotropic = false);
+
 
     /**
      * Returns the factor which must be multiplied by the result of the
@@ -141,20 +204,33 @@ protected:
         return (m_collisions.X()*a).tail(m_collisions.nHeavy()).sum();
     }
 
+    /**
+     * Returns the real matrices of order P for the current state, assembling
+     * and inverting them only if the state has changed since the last call.
+     */
+    template <int P>
+    const ElectronSystem<P>& system();
+
+    /**
+     * Returns the system of order P with the complex matrices updated for the
+     * current state and B-field.
+     */
+    template <int P>
+    const ElectronSystem<P>& systemB();
+
+    /**
+     * Returns the system of order P with the \f$\beta^{pD_i}\f$ coefficients
+     * updated for the current state.
+     */
+    template <int P>
+    const ElectronSystem<P>& systemBeta();
+
     template <int P>
     Eigen::Matrix<double,P,P> L1inv() {
-        return Lee<P>().inverse()/Leefac();
+        const ElectronSystem<P>& sys = system<P>();
+        return sys.Linv/sys.fac;
     }
 
-//    template <int P>
-//    Eigen::Matrix<std::complex<double>,P,P> L2inv()
-//    {
-//        Eigen::Matrix<std::complex<double>,P,P> L2;
-//        L2.real() = Leefac()*Lee<P>();
-//        L2.imag() = LBee<P>();
-//        return L2.inverse();
-//    }
-
     template <int P>
     Eigen::Vector3d electronThermalConductivityB();
 
@@ -166,16 +242,12 @@ protected:
     template <int P>
     Eigen::Vector3d electronDiffusionCoefficientB()
     {
-        // Linear system matrices
-        Eigen::Matrix<double,P,P> L1 = Leefac() * Lee<P>();
-        Eigen::Matrix<std::complex<double>,P,P> L2;
-        L2.real() = L1;
-        L2.imag() = LBee<P>();
+        const ElectronSystem<P>& sys = systemB<P>();
 
         Eigen::Vector3d De;
-        De(0) = L1.inverse().eval()(0);
+        De(0) = sys.L1inv(0);
 
-        std::complex<double> alpha = L2.inverse().eval()(0);
+        std::complex<double> alpha = sys.L2inv(0);
         De(1) = alpha.real();
         De(2) = alpha.imag();
 
@@ -200,6 +272,10 @@ protected:
     template <int P>
     const Eigen::Matrix<double,-1,3>& electronThermalDiffusionRatios2B();
 
+    template <int P>
+    void electronProperties(
+        ElectronTransportProperties& props, bool anisotropic);
+
 //    template <int P, typename RHS>
 //    Eigen::Matrix<double, P, 1> solveRealSysP0(const RHS& rhs) {
 //        return Lee<XI>().inverse() * rhs<XI>();
@@ -223,6 +299,9 @@ private:
     Eigen::VectorXd m_chi2;
     Eigen::Matrix<double,-1,3> m_chi2_B;
 
+    std::tuple<ElectronSystem<1>, ElectronSystem<2>, ElectronSystem<3> >
+        m_systems;
+
 }; // class ElectronSubSystem
 
 
@@ -279,7 +358,8 @@ Eigen::Matrix<double, SIZE, SIZE> ElectronSubSystem::Lee()
 template <int SIZE>
 Eigen::Matrix<double, SIZE, SIZE> ElectronSubSystem::LBee()
 {
-    Eigen::Matrix<double, SIZE, SIZE> LB;
+    Eigen::Matrix<double, SIZE, SIZE> LB =
+        Eigen::Matrix<double, SIZE, SIZE>::Zero();
     const double fac = m_thermo.getBField()*QE/(KB*m_thermo.Te());
 
     LB(0,0) = fac;
@@ -292,27 +372,6 @@ Eigen::Matrix<double, SIZE, SIZE> ElectronSubSystem::LBee()
     return LB;
 }
 
-template <int P>
-Eigen::Vector3d ElectronSubSystem::electronThermalConductivityB()
-{
-    const double fac = 2.5*m_thermo.numberDensity()*m_thermo.X()[0]*KB;
-
-    Eigen::Matrix<double,P-1,P-1> L1 =
-        Leefac()*Lee<P>().template bottomRightCorner<P-1,P-1>();
-    Eigen::Matrix<std::complex<double>,P-1,P-1> L2;
-    L2.real() = L1;
-    L2.imag() = LBee<P>().template bottomRightCorner<P-1,P-1>();
-
-    Eigen::Vector3d lambda;
-    lambda(0) = L1.inverse().eval()(0);
-
-    std::complex<double> alpha = L2.inverse().eval()(0);
-    lambda(1) = alpha.real();
-    lambda(2) = alpha.imag();
-
-    return 2.5*fac*lambda;
-}
-
 
 /// Small helper class which provides the \f$\beta^{pD_i}\f$.
 template <int P>
@@ -353,42 +412,110 @@ private:
 
 };
 
+template <int P>
+const ElectronSystem<P>& ElectronSubSystem::system()
+{
+    ElectronSystem<P>& sys = std::get<P-1>(m_systems);
+    const unsigned long epoch = m_thermo.stateEpoch();
+    if (sys.epoch == epoch)
+        return sys;
+
+    sys.epoch = epoch;
+    sys.fac   = Leefac();
+    sys.L     = Lee<P>();
+    sys.Linv  = sys.L.inverse();
+    sys.L1    = sys.fac*sys.L;
+    sys.L1inv = sys.L1.inverse();
+
+    if (P > 1) {
+        sys.Lr_inv = sys.L.template bottomRightCorner<
+            ElectronSystem<P>::R, ElectronSystem<P>::R>().inverse();
+        sys.L1r_inv = sys.L1.template bottomRightCorner<
+            ElectronSystem<P>::R, ElectronSystem<P>::R>().inverse();
+    }
+
+    return sys;
+}
+
+template <int P>
+const ElectronSystem<P>& ElectronSubSystem::systemB()
+{
+    system<P>();
+    ElectronSystem<P>& sys = std::get<P-1>(m_systems);
+    const double B = m_thermo.getBField();
+    if (sys.B_epoch == sys.epoch && sys.B == B)
+        return sys;
+
+    sys.B_epoch = sys.epoch;
+    sys.B = B;
+    sys.L2.real() = sys.L1;
+    sys.L2.imag() = LBee<P>();
+    sys.L2inv = sys.L2.inverse();
+
+    if (P > 1)
+        sys.L2r_inv = sys.L2.template bottomRightCorner<
+            ElectronSystem<P>::R, ElectronSystem<P>::R>().inverse();
+
+    return sys;
+}
+
+template <int P>
+const ElectronSystem<P>& ElectronSubSystem::systemBeta()
+{
+    system<P>();
+    ElectronSystem<P>& sys = std::get<P-1>(m_systems);
+    if (sys.beta_epoch == sys.epoch)
+        return sys;
+
+    sys.beta_epoch = sys.epoch;
+    sys.beta = BetaDi<P>(m_thermo, m_collisions)();
+
+    return sys;
+}
+
+template <int P>
+Eigen::Vector3d ElectronSubSystem::electronThermalConductivityB()
+{
+    const double fac = 2.5*m_thermo.numberDensity()*m_thermo.X()[0]*KB;
+    const ElectronSystem<P>& sys = systemB<P>();
+
+    Eigen::Vector3d lambda;
+    lambda(0) = sys.L1r_inv(0);
+
+    std::complex<double> alpha = sys.L2r_inv(0);
+    lambda(1) = alpha.real();
+    lambda(2) = alpha.imag();
+
+    return 2.5*fac*lambda;
+}
+
 template <int P>
 const Eigen::VectorXd& ElectronSubSystem::alpha()
 {
     // Compute the system solution
-    BetaDi<P> beta(m_thermo, m_collisions);
-    Eigen::Matrix<double,P,P> L1inv = Lee<P>().inverse();
+    const ElectronSystem<P>& sys = systemBeta<P>();
 
     for (int i = 0; i < m_thermo.nHeavy(); ++i)
-        m_alpha(i) = (L1inv.col(0)).dot(beta().col(i));
+        m_alpha(i) = (sys.Linv.col(0)).dot(sys.beta.col(i));
 
-    return (m_alpha /= Leefac());
+    return (m_alpha /= sys.fac);
 }
 
 template <int P>
 const Eigen::Matrix<double,-1,3>& ElectronSubSystem::alphaB()
 {
-    // Linear system matrices
-    Eigen::Matrix<double,P,P> L1 = Leefac() * Lee<P>();
-    Eigen::Matrix<std::complex<double>,P,P> L2;
-    L2.real() = L1;
-    L2.imag() = LBee<P>();
-
-    // Inverses
-    Eigen::Matrix<double,P,P> L1inv = L1.inverse();
-    Eigen::Matrix<std::complex<double>,P,P> L2inv = L2.inverse();
+    systemB<P>();
+    const ElectronSystem<P>& sys = systemBeta<P>();
 
     // Compute the system solution
-    BetaDi<P> beta(m_thermo, m_collisions);
     std::complex<double> sol;
     Eigen::Matrix<double,P,1> b;
 
     for (int i = 0; i < m_thermo.nHeavy(); ++i) {
-        b = beta().col(i);
-        m_alpha_B(i,0) = (L1inv.col(0)).dot(b);
+        b = sys.beta.col(i);
+        m_alpha_B(i,0) = (sys.L1inv.col(0)).dot(b);
 
-        sol = (L2inv.col(0)).dot(b);
+        sol = (sys.L2inv.col(0)).dot(b);
         m_alpha_B(i,1) = sol.real();
         m_alpha_B(i,2) = sol.imag();
     }
@@ -399,27 +526,23 @@ const Eigen::Matrix<double,-1,3>& ElectronSubSystem::alphaB()
 template <int P>
 double ElectronSubSystem::electronThermalDiffusionRatio()
 {
-    Eigen::Matrix<double,P,P> L1 = Lee<P>();
+    const ElectronSystem<P>& sys = system<P>();
 
-    return 2.5 * (L1.template topRightCorner<1,P-1>() *
-        L1.template bottomRightCorner<P-1,P-1>().inverse().template leftCols<1>())(0);
+    return 2.5 * (sys.L.template topRightCorner<1,P-1>() *
+        sys.Lr_inv.template leftCols<1>())(0);
 }
 
 template <int P>
 Eigen::Vector3d ElectronSubSystem::electronThermalDiffusionRatioB()
 {
-    // Linear system matrices
-    Eigen::Matrix<double,P,P> L1 = Leefac() * Lee<P>();
-    Eigen::Matrix<std::complex<double>,P,P> L2;
-    L2.real() = L1;
-    L2.imag() = LBee<P>();
+    const ElectronSystem<P>& sys = systemB<P>();
 
     Eigen::Vector3d chi;
-    chi(0) = (L1.template topRightCorner<1,P-1>() *
-        L1.template bottomRightCorner<P-1,P-1>().inverse().template leftCols<1>())(0);
+    chi(0) = (sys.L1.template topRightCorner<1,P-1>() *
+        sys.L1r_inv.template leftCols<1>())(0);
 
-    std::complex<double> sol = (L2.template topRightCorner<1,P-1>() *
-        L2.template bottomRightCorner<P-1,P-1>().inverse().template leftCols<1>())(0);
+    std::complex<double> sol = (sys.L2.template topRightCorner<1,P-1>() *
+        sys.L2r_inv.template leftCols<1>())(0);
     chi(1) = sol.real();
     chi(2) = sol.imag();
 
@@ -429,24 +552,20 @@ Eigen::Vector3d ElectronSubSystem::electronThermalDiffusionRatioB()
 template <int P>
 const Eigen::VectorXd& ElectronSubSystem::electronThermalDiffusionRatios2()
 {
-    BetaDi<P> beta(m_thermo, m_collisions);
-    m_chi2 = -2.5 * (L1inv<P>() * beta()).row(1);
+    const ElectronSystem<P>& sys = systemBeta<P>();
+    m_chi2 = -2.5 * ((sys.Linv/sys.fac) * sys.beta).row(1);
     return m_chi2;
 }
 
 template <int P>
 const Eigen::Matrix<double,-1,3>& ElectronSubSystem::electronThermalDiffusionRatios2B()
 {
-    // Linear system matrices
-    Eigen::Matrix<double,P,P> L1 = Leefac() * Lee<P>();
-    Eigen::Matrix<std::complex<double>,P,P> L2;
-    L2.real() = L1;
-    L2.imag() = LBee<P>();
+    systemB<P>();
+    const ElectronSystem<P>& sys = systemBeta<P>();
 
-    BetaDi<P> beta(m_thermo, m_collisions);
-    m_chi2_B.col(0) = -2.5 * (L1.inverse() * beta()).row(1);
+    m_chi2_B.col(0) = -2.5 * (sys.L1inv * sys.beta).row(1);
 
-    Eigen::VectorXcd sol = (L2.inverse() * beta()).row(1);
+    Eigen::VectorXcd sol = (sys.L2inv * sys.beta).row(1);
     m_chi2_B.col(1) = -2.5 * sol.real();
     m_chi2_B.col(2) = -2.5 * sol.imag();
 
@@ -28,6 +28,7 @@
 #include "AutoRegistration.h"
 #include "CollisionDB.h"
 #include "DiffusionMatrix.h"
+#include "FixedSizeSolvers.h"
 
 #include <Eigen/Dense>
 
@@ -57,8 +58,8 @@ public:
         //Eigen::Map<const Eigen::ArrayXd> X = m_collisions.X();
         //Eigen::Map<const Eigen::ArrayXd> Y = m_collisions.Y();
 
-        static Eigen::ArrayXd X; X = m_collisions.X()+1.0e-16; X /= X.sum();
-        static Eigen::ArrayXd Y; Y.resize(ns);
+        Eigen::ArrayXd X = m_collisions.X()+1.0e-16; X /= X.sum();
+        Eigen::ArrayXd Y(ns);
         m_collisions.thermo().convert<Thermodynamics::X_TO_Y>(X.data(), Y.data());
 
 
@@ -93,11 +94,32 @@ public:
         m_Dij.selfadjointView<Eigen::Lower>().rankUpdate(
             Y.matrix(), nd/nDij.diagonal().mean());
 
-        static Eigen::LDLT<Eigen::MatrixXd, Eigen::Lower> ldlt;
-        ldlt.compute(m_Dij.bottomRightCorner(ns-k,ns-k));
+        // Invert the heavy species block, with a fixed-size factorization for
+        // the common mixture sizes
+        HeavyInverse inverse(*this, Y, k);
+        if (!dispatchFixedSize(ns-k, inverse)) {
+            Eigen::LDLT<Eigen::MatrixXd, Eigen::Lower> ldlt;
+            ldlt.compute(m_Dij.bottomRightCorner(ns-k,ns-k));
+            fillInverse<Eigen::VectorXd>(ldlt, Y, k);
+        }
+
+        return m_Dij;
+    }
+
+private:
+
+    /**
+     * Fills the heavy species block of the diffusion matrix with the solutions
+     * of the factorized system for each unit vector (plus the mass fractions).
+     */
+    template <typename Vector, typename Factorization>
+    void fillInverse(
+        const Factorization& ldlt, const Eigen::ArrayXd& Y, const int k)
+    {
+        const int ns = m_Dij.rows();
 
-        static Eigen::VectorXd alpha; alpha.resize(ns-k);
-        static Eigen::VectorXd b; b.resize(ns-k);
+        Vector alpha(ns-k);
+        Vector b(ns-k);
         b.array() = Y.tail(ns-k);
 
         for (int i = k; i < ns ; ++i ){
@@ -110,10 +132,33 @@ public:
                 m_Dij(j,i) = alpha(j-k);
             }
         }
-
-        return m_Dij;
     }
 
+    /**
+     * Functor given to dispatchFixedSize() which factorizes the heavy species
+     * block as a fixed-size matrix.
+     */
+    class HeavyInverse
+    {
+    public:
+        HeavyInverse(ExcactDiffMat& dm, const Eigen::ArrayXd& Y, int k)
+            : m_dm(dm), m_Y(Y), m_k(k)
+        { }
+
+        template <int N>
+        void apply() {
+            typedef Eigen::Matrix<double, N, N> Matrix;
+            const Matrix A = m_dm.m_Dij.bottomRightCorner(N,N);
+            Eigen::LDLT<Matrix, Eigen::Lower> ldlt(A);
+            m_dm.fillInverse<Eigen::Matrix<double, N, 1> >(ldlt, m_Y, m_k);
+        }
+
+    private:
+        ExcactDiffMat& m_dm;
+        const Eigen::ArrayXd& m_Y;
+        const int m_k;
+    };
+
 }; // ExcactDiffMat
 
 // Register this algorithm
@@ -0,0 +1,115 @@
+/**
+ * @file FixedSizeSolvers.h
+ *
+ * @brief Provides fixed-size kernels for the small linear systems of the
+ * Chapman-Enskog transport algorithms.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRANSPORT_FIXED_SIZE_SOLVERS_H
+#define TRANSPORT_FIXED_SIZE_SOLVERS_H
+
+#include <Eigen/Dense>
+
+namespace Mutation {
+    namespace Transport {
+
+/**
+ * Calls f.template apply<N>() with N = n if a fixed-size kernel is compiled
+ * for n and returns true, otherwise returns false and the caller should use
+ * its dynamically sized path.  The sizes cover the number of heavy species of
+ * the common air, CO2 and Mars mixtures.
+ */
+template <typename Functor>
+bool dispatchFixedSize(int n, Functor& f)
+{
+    switch (n) {
+    case 5:  f.template apply<5>();  return true;
+    case 6:  f.template apply<6>();  return true;
+    case 7:  f.template apply<7>();  return true;
+    case 10: f.template apply<10>(); return true;
+    case 11: f.template apply<11>(); return true;
+    case 12: f.template apply<12>(); return true;
+    case 13: f.template apply<13>(); return true;
+    case 19: f.template apply<19>(); return true;
+    default: return false;
+    }
+}
+
+/**
+ * Solves \f$Ax = b\f$ for a symmetric positive definite matrix \f$A\f$ of which
+ * only the lower triangle is used, with a fixed-size LDLT factorization.
+ */
+class FixedSizeLDLTSolve
+{
+public:
+    FixedSizeLDLTSolve(
+        const Eigen::MatrixXd& A, const Eigen::VectorXd& b, Eigen::VectorXd& x)
+        : m_A(A), m_b(b), m_x(x)
+    { }
+
+    template <int N>
+    void apply() {
+        const Eigen::Matrix<double, N, N> A = m_A;
+        const Eigen::Matrix<double, N, 1> b = m_b;
+        m_x = Eigen::LDLT<Eigen::Matrix<double, N, N>, Eigen::Lower>(A).solve(b);
+    }
+
+private:
+    const Eigen::MatrixXd& m_A;
+    const Eigen::VectorXd& m_b;
+    Eigen::VectorXd& m_x;
+};
+
+/**
+ * Tells whether the Solver template argument of the Chapman-Enskog algorithms
+ * is Eigen::LDLT, in which case the fixed-size kernels can be used instead.
+ */
+template <template <typename, int> class Solver>
+struct IsLDLT { static const bool value = false; };
+
+template <>
+struct IsLDLT<Eigen::LDLT> { static const bool value = true; };
+
+/**
+ * Solves the symmetric system with a fixed-size LDLT kernel if Solver is
+ * Eigen::LDLT and the size has a kernel, otherwise computes and solves the
+ * system with the given dynamically sized solver.
+ */
+template <template <typename, int> class Solver>
+void solveSymmetric(
+    const Eigen::MatrixXd& A, const Eigen::VectorXd& b, Eigen::VectorXd& x,
+    Solver<Eigen::MatrixXd, Eigen::Lower>& solver)
+{
+    FixedSizeLDLTSolve fixed(A, b, x);
+    if (IsLDLT<Solver>::value && dispatchFixedSize(A.rows(), fixed))
+        return;
+
+    solver.compute(A);
+    x = solver.solve(b);
+}
+
+    } // namespace Transport
+} // namespace Mutation
+
+#endif // TRANSPORT_FIXED_SIZE_SOLVERS_H
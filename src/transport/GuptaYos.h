@@ -73,6 +73,70 @@ protected:
         return sum1 / (1.0 - a_av * sum1);
     }
 
+    /**
+     * Evaluates the Gupta-Yos formula as above and computes the derivatives of
+     * the result with respect to the lower triangle of A (dA), to a (da) and
+     * to x (dx), in reverse mode.
+     */
+    template <typename E1, typename E2, typename E3>
+    double guptaYos(
+        const Eigen::ArrayBase<E1>& A, const Eigen::ArrayBase<E2>& a,
+        const Eigen::ArrayBase<E3>& x, Eigen::ArrayXXd& dA,
+        Eigen::ArrayXd& da, Eigen::ArrayXd& dx)
+    {
+        const int ns = x.size();
+
+        // Compute a_av
+        double sum1 = 0.0;
+        double sum2 = 0.0;
+        double temp;
+
+        quotient = 1.0 / a;
+
+        for (int j = 0; j < ns-1; ++j) {
+            for (int i = j+1; i < ns; ++i) {
+                temp = quotient(i) - quotient(j);
+                temp = 2.0 * x(i) * x(j) * temp * temp;
+                sum1 += temp;
+                sum2 += temp * A(i,j);
+            }
+        }
+
+        const double a_av = sum2 / sum1;
+
+        // Value of the Gupta-Yos formula
+        const Eigen::ArrayXd w = 1.0 / (a + a_av);
+        const double S   = (x * w).sum();
+        const double den = 1.0 - a_av * S;
+
+        // Derivatives with respect to S and a_av, then through S
+        const double dS = 1.0 / (den * den);
+        double da_av = S * S / (den * den);
+
+        dx = dS * w;
+        da = -dS * x * w * w;
+        da_av -= dS * (x * w * w).sum();
+
+        // Then through a_av = sum2/sum1
+        double t, dw;
+        dA.setZero(ns, ns);
+        for (int j = 0; j < ns-1; ++j) {
+            for (int i = j+1; i < ns; ++i) {
+                t = quotient(i) - quotient(j);
+                temp = 2.0 * x(i) * x(j) * t * t;
+                dA(i,j) = da_av * temp / sum1;
+
+                dw = da_av * (A(i,j) - a_av) / sum1;
+                dx(i) += dw * 2.0 * x(j) * t * t;
+                dx(j) += dw * 2.0 * x(i) * t * t;
+                da(i) -= dw * 4.0 * x(i) * x(j) * t * quotient(i) * quotient(i);
+                da(j) += dw * 4.0 * x(i) * x(j) * t * quotient(j) * quotient(j);
+            }
+        }
+
+        return S / den;
+    }
+
 private:
 
     Eigen::ArrayXd quotient;
@@ -101,6 +101,8 @@ private:
 
     double compute_(double T) { return m_fac * std::sqrt(m_alpha / T); }
 
+    double dlnT_(double T) { return -0.5; }
+
     /**
      * Returns true if the constant value is the same.
      */
@@ -42,7 +42,9 @@ class RamshawDiffMat : public DiffusionMatrix
 public:
 
     RamshawDiffMat(DiffusionMatrix::ARGS collisions)
-        : DiffusionMatrix(collisions)
+        : DiffusionMatrix(collisions),
+          m_c(collisions.nSpecies()),
+          m_e(collisions.nSpecies())
     { }
 
     /**
@@ -54,29 +56,58 @@ public:
      * where \f$D_{jm}\f$ is average diffusion coefficient.
      * @see Mixture::averageDiffusionCoeffs().
      *
-     * @todo This method currently breaks the symmetry property of the diffusion
-     * matrix.  It should be reformulated to return a symmetric matrix which
-     * would be faster to compute and use.
+     * The matrix is not symmetric, but it is the sum of a diagonal matrix and
+     * a rank one matrix with identical rows, \f$D_{ij} = c_j + \delta_{ij}
+     * e_j\f$, which diffusionVelocities() uses without forming the matrix.
      */
     const Eigen::MatrixXd& diffusionMatrix()
     {
         const int ns = m_collisions.nSpecies();
+        updateFactors();
 
+        // Form the matrix
+        for (int j = 0; j < ns; ++j) {
+            m_Dij.col(j).fill(m_c(j));
+            m_Dij(j,j) += m_e(j);
+        }
+
+        return m_Dij;
+    }
+
+    /**
+     * Computes the diffusion velocities in O(ns) operations as
+     * \f[ V_i = -\sum_j c_j d_j - e_i d_i. \f]
+     */
+    void diffusionVelocities(const double* const p_d, double* const p_V)
+    {
+        const int ns = m_collisions.nSpecies();
+        updateFactors();
+
+        Eigen::Map<const Eigen::ArrayXd> d(p_d, ns);
+        Eigen::Map<Eigen::ArrayXd>(p_V, ns) =
+            -(m_c*d).sum() - m_e*d;
+    }
+
+private:
+
+    /// Computes the vectors c and e of the packed diffusion matrix.
+    void updateFactors()
+    {
         Eigen::Map<const Eigen::ArrayXd> X = m_collisions.X();
         Eigen::Map<const Eigen::ArrayXd> Y = m_collisions.Y();
 
         // Compute average diffusion coefficients without 1-X(j) term
         const Eigen::ArrayXd& Dim = m_collisions.Dim(false);
 
-        // Form the matrix
-        for (int j = 0; j < ns; ++j) {
-            m_Dij.col(j).fill(-Y[j]/X[j]*(1.-Y[j])*Dim(j));
-            m_Dij(j,j) -= m_Dij(j,j)/Y[j];
-        }
-
-        return m_Dij;
+        m_c = -Y/X*(1.-Y)*Dim;
+        m_e = -m_c/Y;
     }
 
+private:
+
+    Eigen::ArrayXd m_c;
+    Eigen::ArrayXd m_e;
+
 }; // RamshawDiffMat
 
 // Register this algorithm
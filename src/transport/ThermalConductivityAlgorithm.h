@@ -29,6 +29,7 @@
 #define TRANSPORT_THERMAL_CONDUCTIVITY_ALGORITHM_H
 
 #include "CollisionDB.h"
+#include "Errors.h"
 
 namespace Mutation {
     namespace Transport {
@@ -65,6 +66,20 @@ public:
      * defined in the derived type.
      */
     virtual double thermalConductivity() = 0;
+
+    /**
+     * Returns the mixture thermal conductivity in W/m-K and computes its
+     * derivatives with respect to temperature in W/m-K^2 and to the heavy
+     * species mole fractions, each with the other variables held fixed.
+     * Algorithms which do not provide analytic derivatives throw a
+     * NotImplementedError.
+     */
+    virtual double thermalConductivityDerivatives(
+        double& dlam_dT, Eigen::ArrayXd& dlam_dx)
+    {
+        throw NotImplementedError(
+            "ThermalConductivityAlgorithm::thermalConductivityDerivatives()");
+    }
     
     
     /**
@@ -76,6 +91,19 @@ public:
         for (int i = 0; i < m_collisions.nSpecies(); ++i)
             p_k[i] = 0.0;
     }
+
+    /**
+     * Returns true if the algorithm solves a linear system which is kept for
+     * the current state.  @see updateSystem()
+     */
+    virtual bool hasSystem() const { return false; }
+
+    /**
+     * Solves the linear system of the algorithm at the current state, unless
+     * it was already solved at this state.  Returns true if the solution was
+     * reused.  Algorithms without a system do nothing.
+     */
+    virtual bool updateSystem() { return false; }
     
 
 protected:
@@ -84,6 +112,14 @@ protected:
 
 }; // class ThermalConductivityAlgorithm
 
+/**
+ * Assembles the lower triangle of the first order Chapman-Enskog heavy particle
+ * thermal conductivity system at the current state.  On return, x holds the
+ * heavy species mole fractions, bounded below by 1e-16, used in the system.
+ */
+void heavyThermalConductivitySystem(
+    CollisionDB& collisions, Eigen::ArrayXd& x, Eigen::MatrixXd& sys);
+
     } // namespace Transport
 } // namespace Mutation
 
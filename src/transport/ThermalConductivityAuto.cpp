@@ -0,0 +1,107 @@
+/**
+ * @file ThermalConductivityAuto.cpp
+ *
+ * @brief Provides ThermalConductivityAuto class.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "AutoRegistration.h"
+#include "AutoSelector.h"
+#include "CollisionDB.h"
+#include "ThermalConductivityAlgorithm.h"
+
+#include <Eigen/Dense>
+
+using namespace Mutation::Utilities;
+
+namespace Mutation {
+    namespace Transport {
+
+/**
+ * Computes the heavy particle translational thermal conductivity with the
+ * Wilke mixture rule where it is estimated to be accurate to within the
+ * tolerance, and with the Chapmann-Enskog LDLT algorithm elsewhere.  The
+ * thermal diffusion ratios, which the mixture rule does not provide, are always
+ * computed with the Chapmann-Enskog algorithm.
+ *
+ * @see AutoSelector
+ */
+class ThermalConductivityAuto
+    : public ThermalConductivityAlgorithm, public AutoSelector
+{
+public:
+
+    ThermalConductivityAuto(ThermalConductivityAlgorithm::ARGS collisions)
+        : ThermalConductivityAlgorithm(collisions),
+          AutoSelector(collisions),
+          mp_cheap(Config::Factory<ThermalConductivityAlgorithm>::create(
+              "Wilke", collisions)),
+          mp_full(Config::Factory<ThermalConductivityAlgorithm>::create(
+              "Chapmann-Enskog_LDLT", collisions))
+    { }
+
+    ~ThermalConductivityAuto()
+    {
+        delete mp_cheap;
+        delete mp_full;
+    }
+
+    double thermalConductivity()
+    {
+        if (useMixtureRule(m_collisions.X().tail(m_collisions.nHeavy())))
+            return mp_cheap->thermalConductivity();
+
+        const double lambda = mp_full->thermalConductivity();
+        calibrate(mp_cheap->thermalConductivity(), lambda);
+        return lambda;
+    }
+
+    double thermalConductivityDerivatives(
+        double& dlam_dT, Eigen::ArrayXd& dlam_dx)
+    {
+        if (useMixtureRule(m_collisions.X().tail(m_collisions.nHeavy())))
+            return mp_cheap->thermalConductivityDerivatives(dlam_dT, dlam_dx);
+
+        const double lambda =
+            mp_full->thermalConductivityDerivatives(dlam_dT, dlam_dx);
+        calibrate(mp_cheap->thermalConductivity(), lambda);
+        return lambda;
+    }
+
+    void thermalDiffusionRatios(double* const p_k)
+    {
+        mp_full->thermalDiffusionRatios(p_k);
+    }
+
+private:
+
+    ThermalConductivityAlgorithm* mp_cheap;
+    ThermalConductivityAlgorithm* mp_full;
+};
+
+// Register the algorithm
+Config::ObjectProvider<
+    ThermalConductivityAuto, ThermalConductivityAlgorithm> lambdaAuto("Auto");
+
+    } // namespace Transport
+} // namespace Mutation
@@ -30,6 +30,7 @@
 #include "ThermalConductivityAlgorithm.h"
 #include "Constants.h"
 #include "CollisionDB.h"
+#include "FixedSizeSolvers.h"
 #include "Utilities.h"
 
 #include <Eigen/Dense>
@@ -53,8 +54,10 @@ class ThermalConductivityChapmannEnskog : public ThermalConductivityAlgorithm
 public:
     ThermalConductivityChapmannEnskog(ThermalConductivityAlgorithm::ARGS args) :
         ThermalConductivityAlgorithm(args),
+        m_epoch(0),
         m_sys(MatrixXd::Zero(args.nHeavy(), args.nHeavy())),
         m_x(args.nHeavy()),
+        m_b(args.nHeavy()),
         m_alpha(args.nHeavy())
     { }
 
@@ -64,6 +67,69 @@ public:
         return m_x.matrix().dot(m_alpha);
     }
 
+    /**
+     * Returns the thermal conductivity and its temperature and mole fraction
+     * derivatives.  As for the viscosity, the system solution is its own
+     * adjoint so that the derivatives are \f$2\alpha^T dx -
+     * \alpha^T dA\,\alpha\f$.
+     */
+    double thermalConductivityDerivatives(double& dlam_dT, ArrayXd& dlam_dx)
+    {
+        updateAlphas();
+
+        const int ns = m_collisions.nSpecies();
+        const int nh = m_collisions.nHeavy();
+        const double T = m_collisions.thermo().T();
+
+        const ArrayXd& mi   = m_collisions.mass();
+        const ArrayXd& Ast  = m_collisions.Astij();
+        const ArrayXd& Bst  = m_collisions.Bstij();
+        const ArrayXd& nDij = m_collisions.nDij();
+        const ArrayXd& etai = m_collisions.etai();
+        const ArrayXd& dlnQ11 = m_collisions.dlnT(CollisionDB::Q11IJ);
+        const ArrayXd& dlnQ22 = m_collisions.dlnT(CollisionDB::Q22II);
+        const ArrayXd& dlnAst = m_collisions.dlnT(CollisionDB::ASTIJ);
+        const ArrayXd& dlnBst = m_collisions.dlnT(CollisionDB::BSTIJ);
+
+        // Diagonal terms, with eta_i proportional to sqrt(T)/Q22_ii
+        const ArrayXd a = m_alpha.array();
+        const ArrayXd q =
+            4.0 / (15.0 * KB) * m_x * m_x * mi.tail(nh) / etai * a * a;
+        dlam_dx = 2.0*a - 2.0*q/m_x;
+        dlam_dT = (q * (0.5 - dlnQ22)).sum() / T;
+
+        // Pair terms, with nDij proportional to sqrt(T)/Q11_ij
+        int k = ns - nh, ik, jk;
+        double miij, mjij, fac, P, dPdA, dPdB;
+        for (int j = 0, index = 1; j < nh; ++j, ++index) {
+            jk = j+k;
+            for (int i = j+1; i < nh; ++i, ++index) {
+                ik = i+k;
+                miij = mi(ik) / (mi(ik) + mi(jk));
+                mjij = mi(jk) / (mi(ik) + mi(jk));
+                fac  = m_x(i) * m_x(j) / (nDij(index) * 25.0 * KB);
+
+                P = 2.0 * a(i) * a(j) * miij * mjij *
+                    (16.0 * Ast(index) + 12.0 * Bst(index) - 55.0) +
+                    a(i) * a(i) * (miij * (30.0 * miij + 16.0 * mjij *
+                    Ast(index)) + mjij * mjij * (25.0 - 12.0 * Bst(index))) +
+                    a(j) * a(j) * (mjij * (30.0 * mjij + 16.0 * miij *
+                    Ast(index)) + miij * miij * (25.0 - 12.0 * Bst(index)));
+                dPdA = 16.0 * miij * mjij * (a(i) + a(j)) * (a(i) + a(j));
+                dPdB = -12.0 * (mjij * a(i) - miij * a(j)) *
+                    (mjij * a(i) - miij * a(j));
+
+                dlam_dx(i) -= fac * P / m_x(i);
+                dlam_dx(j) -= fac * P / m_x(j);
+                dlam_dT -= fac * ((dlnQ11(index) - 0.5) * P +
+                    Ast(index) * dlnAst(index) * dPdA +
+                    Bst(index) * dlnBst(index) * dPdB) / T;
+            }
+        }
+
+        return m_x.matrix().dot(m_alpha);
+    }
+
     void thermalDiffusionRatios(double* const p_k)
     {
         // First solve the linear system for the alphas
@@ -77,76 +143,107 @@ public:
         const ArrayXd& nDij = m_collisions.nDij();
         const ArrayXd& Cst  = m_collisions.Cstij();
 
-        // Compute heavy-particle thermal diffusion ratios
+        // Compute heavy-particle thermal diffusion ratios, keeping the system
+        // matrix intact for the alphas of the current state
         double fac;
-        m_sys.diagonal().setZero();
+        m_L.resize(nh,nh);
+        m_L.diagonal().setZero();
         for (int j = 0, si = 1; j < nh; ++j, ++si) {
             for (int i = j+1; i < nh; ++i, ++si) {
                 fac = m_x(i)*m_x(j)/(mi(i+k)+mi(j+k))*(1.2*Cst(si)-1.)/nDij(si);
-                m_sys(i,j) = fac*mi(i+k);
-                m_sys(j,i) = fac*mi(j+k);
-                m_sys(i,i) -= m_sys(j,i);
-                m_sys(j,j) -= m_sys(i,j);
+                m_L(i,j) = fac*mi(i+k);
+                m_L(j,i) = fac*mi(j+k);
+                m_L(i,i) -= m_L(j,i);
+                m_L(j,j) -= m_L(i,j);
             }
         }
 
         p_k[0] = 0.0;
-        Map<ArrayXd>(p_k+k,nh) = (m_sys*m_alpha)/KB;
+        Map<ArrayXd>(p_k+k,nh) = (m_L*m_alpha)/KB;
     }
 
-private:
+    bool hasSystem() const { return true; }
 
-    void updateAlphas()
-    {
-        const int ns = m_collisions.nSpecies();
-        const int nh = m_collisions.nHeavy();
+    bool updateSystem() { return updateAlphas(); }
 
-        // Collision data
-        const ArrayXd& mi   = m_collisions.mass();
-        const ArrayXd& Ast  = m_collisions.Astij();
-        const ArrayXd& Bst  = m_collisions.Bstij();
-        const ArrayXd& nDij = m_collisions.nDij();
-        const ArrayXd& etai = m_collisions.etai();
+private:
 
-        // Compute the system matrix
-        double fac = 4.0 / (15.0 * KB);
-        int k = ns - nh, ik, jk;
-        m_x = Map<const ArrayXd>(m_collisions.thermo().X()+k,nh).max(1.0e-16);
-        m_sys.diagonal().array() = fac*m_x*m_x*mi.tail(nh)/etai;
+    /**
+     * Solves the system for the alphas, unless this was already done at the
+     * current state.  Returns true if the alphas were reused.
+     */
+    bool updateAlphas()
+    {
+        const unsigned long epoch = m_collisions.thermo().stateEpoch();
+        if (m_epoch == epoch)
+            return true;
 
-        double miij;
-        double mjij;
-        for (int j = 0, index = 1; j < nh; ++j, ++index) {
-            jk = j+k;
-            for (int i = j+1; i < nh; ++i, ++index) {
-                ik = i+k;
-                miij = mi(ik) / (mi(ik) + mi(jk));
-                mjij = mi(jk) / (mi(ik) + mi(jk));
-                fac  = m_x(i) * m_x(j) / (nDij(index) * 25.0 * KB);
-                m_sys(i,j) = fac * miij * mjij *
-                    (16.0 * Ast(index) + 12.0 * Bst(index) - 55.0);
-                m_sys(i,i) += fac * (miij * (30.0 * miij + 16.0 * mjij *
-                    Ast(index)) + mjij * mjij * (25.0 - 12.0 * Bst(index)));
-                m_sys(j,j) += fac * (mjij * (30.0 * mjij + 16.0 * miij *
-                    Ast(index)) + miij * miij * (25.0 - 12.0 * Bst(index)));
-            }
-        }
+        heavyThermalConductivitySystem(m_collisions, m_x, m_sys);
 
         // Solve the linear system using the type of system solution given in
-        // template parameter
-        solver.compute(m_sys);
-        m_alpha = solver.solve(m_x.matrix());
+        // template parameter, or a fixed-size LDLT kernel when available
+        m_b = m_x.matrix();
+        solveSymmetric<Solver>(m_sys, m_b, m_alpha, solver);
+
+        m_epoch = epoch;
+        return false;
     }
 
 private:
 
+    unsigned long m_epoch;
     MatrixXd m_sys;
     ArrayXd m_x;
+    VectorXd m_b;
     VectorXd m_alpha;
+    MatrixXd m_L;
     Solver<MatrixXd, Lower> solver;
 
 }; // class ThermalConductivityChapmannEnskog
 
+//==============================================================================
+
+void heavyThermalConductivitySystem(
+    CollisionDB& collisions, ArrayXd& x, MatrixXd& sys)
+{
+    const int ns = collisions.nSpecies();
+    const int nh = collisions.nHeavy();
+
+    // Collision data
+    const ArrayXd& mi   = collisions.mass();
+    const ArrayXd& Ast  = collisions.Astij();
+    const ArrayXd& Bst  = collisions.Bstij();
+    const ArrayXd& nDij = collisions.nDij();
+    const ArrayXd& etai = collisions.etai();
+
+    // Compute the system matrix
+    double fac = 4.0 / (15.0 * KB);
+    int k = ns - nh, ik, jk;
+    x = Map<const ArrayXd>(collisions.thermo().X()+k,nh).max(1.0e-16);
+    sys.resize(nh,nh);
+    sys.diagonal().array() = fac*x*x*mi.tail(nh)/etai;
+
+    double miij;
+    double mjij;
+    for (int j = 0, index = 1; j < nh; ++j, ++index) {
+        jk = j+k;
+        for (int i = j+1; i < nh; ++i, ++index) {
+            ik = i+k;
+            miij = mi(ik) / (mi(ik) + mi(jk));
+            mjij = mi(jk) / (mi(ik) + mi(jk));
+            fac  = x(i) * x(j) / (nDij(index) * 25.0 * KB);
+            sys(i,j) = fac * miij * mjij *
+                (16.0 * Ast(index) + 12.0 * Bst(index) - 55.0);
+            sys(i,i) += fac * (miij * (30.0 * miij + 16.0 * mjij *
+                Ast(index)) + mjij * mjij * (25.0 - 12.0 * Bst(index)));
+            sys(j,j) += fac * (mjij * (30.0 * mjij + 16.0 * miij *
+                Ast(index)) + miij * miij * (25.0 - 12.0 * Bst(index)));
+        }
+    }
+}
+
+//==============================================================================
+
 // Register the Chapmann-Enskog solution using the LDLT decomposition
 Config::ObjectProvider<
     ThermalConductivityChapmannEnskog<Eigen::LDLT>, ThermalConductivityAlgorithm>
@@ -60,6 +60,22 @@ public:
             (3.75*KB*etai/mass.tail(nh)), mass.tail(nh),
             m_collisions.X().tail(nh));
     }
+
+    double thermalConductivityDerivatives(double& dlam_dT, ArrayXd& dlam_dx)
+    {
+        const int nh = m_collisions.nHeavy();
+        const double T = m_collisions.thermo().T();
+        const ArrayXd& etai = m_collisions.etai();
+        const ArrayXd& mass = m_collisions.mass();
+
+        // lambda_i is proportional to eta_i, itself to sqrt(T)/Q22_ii
+        const ArrayXd dlnlam_dT =
+            (0.5 - m_collisions.dlnT(CollisionDB::Q22II)) / T;
+
+        return wilke(
+            (3.75*KB*etai/mass.tail(nh)), dlnlam_dT, mass.tail(nh),
+            m_collisions.X().tail(nh), dlam_dT, dlam_dx);
+    }
 };
 
 // Register the algorithm
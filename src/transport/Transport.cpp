@@ -26,14 +26,17 @@
  */
 
 
+#include "AutoSelector.h"
 #include "Constants.h"
 #include "DiffusionMatrix.h"
 #include "ThermalConductivityAlgorithm.h"
 #include "Transport.h"
 #include "ViscosityAlgorithm.h"
 
+#include <algorithm>
 #include <iostream>
 #include <Eigen/Dense>
+#include <Eigen/IterativeLinearSolvers>
 
 using namespace Mutation::Thermodynamics;
 using namespace Mutation::Utilities;
@@ -55,6 +58,12 @@ Transport::Transport(
       mp_viscosity(NULL),
       mp_thermal_conductivity(NULL),
       mp_diffusion_matrix(NULL),
+      m_auto_tol(1.0e-2),
+      m_bb_epoch(0),
+      m_bb_lambda(0.0),
+      m_sm_tol(0.0),
+      m_sm_max_iters(100),
+      m_sm_iters(0),
       mp_wrk1(NULL),
       mp_tag(NULL)
 {
@@ -108,6 +117,8 @@ void Transport::setViscosityAlgo(const std::string& algo)
         e << "\nWas trying to set the viscosity algorithm.";
         throw;
     }
+
+    setAutoTransportTolerance(m_auto_tol);
 }
 
 //==============================================================================
@@ -116,6 +127,21 @@ double Transport::viscosity() { return mp_viscosity->viscosity(); }
 
 //==============================================================================
 
+double Transport::viscosityDerivatives(double& dmu_dT, double* const p_dmu_dx)
+{
+    const int ns = m_thermo.nSpecies();
+    const int nh = m_thermo.nHeavy();
+
+    Eigen::ArrayXd dmu_dx(nh);
+    const double mu = mp_viscosity->viscosityDerivatives(dmu_dT, dmu_dx);
+
+    std::fill(p_dmu_dx, p_dmu_dx+ns-nh, 0.0);
+    Eigen::Map<Eigen::ArrayXd>(p_dmu_dx+ns-nh, nh) = dmu_dx;
+    return mu;
+}
+
+//==============================================================================
+
 void Transport::setThermalConductivityAlgo(const std::string& algo)
 {
     if (mp_thermal_conductivity != NULL)
@@ -128,6 +154,8 @@ void Transport::setThermalConductivityAlgo(const std::string& algo)
         e << "\nWas trying to set the thermal conductivity algorithm.";
         throw;
     }
+
+    setAutoTransportTolerance(m_auto_tol);
 }
 
 //==============================================================================
@@ -139,6 +167,24 @@ double Transport::heavyThermalConductivity()
 
 //==============================================================================
 
+double Transport::heavyThermalConductivityDerivatives(
+    double& dlam_dT, double* const p_dlam_dx)
+{
+    const int ns = m_thermo.nSpecies();
+    const int nh = m_thermo.nHeavy();
+
+    Eigen::ArrayXd dlam_dx(nh);
+    const double lambda =
+        mp_thermal_conductivity->thermalConductivityDerivatives(
+            dlam_dT, dlam_dx);
+
+    std::fill(p_dlam_dx, p_dlam_dx+ns-nh, 0.0);
+    Eigen::Map<Eigen::ArrayXd>(p_dlam_dx+ns-nh, nh) = dlam_dx;
+    return lambda;
+}
+
+//==============================================================================
+
 void Transport::setDiffusionMatrixAlgo(const std::string& algo)
 {
     if (mp_diffusion_matrix != NULL)
@@ -155,6 +201,46 @@ void Transport::setDiffusionMatrixAlgo(const std::string& algo)
 
 //==============================================================================
 
+void Transport::setAutoTransportTolerance(double tol)
+{
+    m_auto_tol = tol;
+
+    AutoSelector* p_auto = dynamic_cast<AutoSelector*>(mp_viscosity);
+    if (p_auto != NULL) p_auto->setTolerance(tol);
+
+    p_auto = dynamic_cast<AutoSelector*>(mp_thermal_conductivity);
+    if (p_auto != NULL) p_auto->setTolerance(tol);
+}
+
+//==============================================================================
+
+void Transport::autoTransportCounts(
+    AutoTransportCounts& viscosity, AutoTransportCounts& lambda) const
+{
+    const AutoSelector* p_auto = dynamic_cast<const AutoSelector*>(mp_viscosity);
+    viscosity.n_cheap = (p_auto == NULL ? 0 : p_auto->nCheap());
+    viscosity.n_full  = (p_auto == NULL ? 0 : p_auto->nFull());
+    viscosity.n_audit = (p_auto == NULL ? 0 : p_auto->nAudit());
+
+    p_auto = dynamic_cast<const AutoSelector*>(mp_thermal_conductivity);
+    lambda.n_cheap = (p_auto == NULL ? 0 : p_auto->nCheap());
+    lambda.n_full  = (p_auto == NULL ? 0 : p_auto->nFull());
+    lambda.n_audit = (p_auto == NULL ? 0 : p_auto->nAudit());
+}
+
+//==============================================================================
+
+void Transport::resetAutoTransportCounts()
+{
+    AutoSelector* p_auto = dynamic_cast<AutoSelector*>(mp_viscosity);
+    if (p_auto != NULL) p_auto->resetCounters();
+
+    p_auto = dynamic_cast<AutoSelector*>(mp_thermal_conductivity);
+    if (p_auto != NULL) p_auto->resetCounters();
+}
+
+//==============================================================================
+
 const Eigen::MatrixXd& Transport::diffusionMatrix()
 {
     return mp_diffusion_matrix->diffusionMatrix();
@@ -162,6 +248,16 @@ const Eigen::MatrixXd& Transport::diffusionMatrix()
 
 //==============================================================================
 
+void Transport::diffusionFluxes(const double* const p_d, double* const p_J)
+{
+    const int ns = m_thermo.nGas();
+    mp_diffusion_matrix->diffusionVelocities(p_d, p_J);
+    Map<ArrayXd>(p_J, ns) *=
+        m_thermo.density() * Map<const ArrayXd>(m_thermo.Y(), ns);
+}
+
+//==============================================================================
+
 void Transport::heavyThermalDiffusionRatios(double* const p_k)
 {
     mp_thermal_conductivity->thermalDiffusionRatios(p_k);
@@ -169,6 +265,117 @@ void Transport::heavyThermalDiffusionRatios(double* const p_k)
 
 //==============================================================================
 
+void Transport::computeAll(unsigned int flags, TransportProperties& props)
+{
+    const int ns = m_thermo.nGas();
+
+    props.factorized = 0;
+    props.reused = 0;
+
+    if (flags & VISCOSITY)
+        props.viscosity = viscosity();
+
+    // The Soret conductivity needs the thermal diffusion ratios as well
+    const bool need_k = flags & (THERMAL_DIFFUSION_RATIOS | SORET_THERMAL_CONDUCTIVITY);
+    const bool need_lambda = flags & HEAVY_THERMAL_CONDUCTIVITY;
+
+    if (need_k) props.k_Ti.resize(ns);
+
+    // The heavy thermal conductivity and diffusion ratios share the system
+    // of the selected algorithm, which is solved at most once per state
+    if ((need_k || need_lambda) && mp_thermal_conductivity->hasSystem())
+        (mp_thermal_conductivity->updateSystem() ?
+            props.reused : props.factorized) |= HEAVY_LAMBDA_SYSTEM;
+
+    if (need_lambda)
+        props.lambda_h = heavyThermalConductivity();
+    if (need_k)
+        heavyThermalDiffusionRatios(props.k_Ti.data());
+
+    // Reuses the thermal diffusion ratios computed above
+    if (flags & SORET_THERMAL_CONDUCTIVITY)
+        props.lambda_soret = soretThermalConductivity(props.k_Ti.data());
+
+    if (flags & BUTLER_BROKAW_CONDUCTIVITY) {
+        (updateButlerBrokawSystem() ? props.reused : props.factorized) |=
+            BUTLER_BROKAW_SYSTEM;
+        props.lambda_bb = m_bb_lambda;
+    }
+}
+
+//==============================================================================
+
+void Transport::setStefanMaxwellTolerance(double tol, int max_iters)
+{
+    m_sm_tol = tol;
+    m_sm_max_iters = std::max(max_iters, 1);
+    m_sm_x.resize(0);
+}
+
+//==============================================================================
+
+bool Transport::iterativeStefanMaxwell(
+    const MatrixXd& G, const VectorXd& b, int k, VectorXd& x)
+{
+    const int ns = G.rows() - k;
+
+    if (m_sm_x.size() != ns+k) {
+        m_sm_x = VectorXd::Zero(ns+k);
+        m_sm_z = VectorXd::Zero(ns);
+    }
+
+    // Symmetric Jacobi scaling of the species block makes the residual of
+    // every row relative to its diagonal (otherwise the trace species rows
+    // do not count) and leaves a well conditioned system
+    ArrayXd d = G.diagonal().head(ns).array().abs();
+    for (int i = 0; i < ns; ++i)
+        d(i) = (d(i) > 0.0 ? 1.0 / std::sqrt(d(i)) : 1.0);
+    const MatrixXd Gs = d.matrix().asDiagonal() * G.topLeftCorner(ns,ns) *
+        d.matrix().asDiagonal();
+
+    BiCGSTAB<MatrixXd, IdentityPreconditioner> bicgstab;
+    bicgstab.setTolerance(m_sm_tol);
+    bicgstab.setMaxIterations(m_sm_max_iters);
+    bicgstab.compute(Gs);
+
+    // Velocities due to the driving forces alone, seeded with the previous
+    // ones (before the ambipolar correction)
+    VectorXd guess = m_sm_x.head(ns);
+    if (k == 1) guess += m_sm_x(ns) * m_sm_z;
+    VectorXd y = bicgstab.solveWithGuess(
+        (d * b.head(ns).array()).matrix(), (guess.array() / d).matrix());
+    if (bicgstab.info() != Success) return false;
+    y.array() *= d;
+    int iters = bicgstab.iterations();
+
+    if (k == 1) {
+        // Velocities due to a unit ambipolar field
+        VectorXd z = bicgstab.solveWithGuess(
+            (d * G.col(ns).head(ns).array()).matrix(),
+            (m_sm_z.array() / d).matrix());
+        if (bicgstab.info() != Success) return false;
+        z.array() *= d;
+        iters += bicgstab.iterations();
+
+        // Choose the field such that the conduction current vanishes
+        const double t = (G.row(ns).head(ns).dot(y) - b(ns)) /
+            G.row(ns).head(ns).dot(z);
+        x.head(ns) = y - t*z;
+        x(ns) = t;
+        m_sm_z = z;
+    } else {
+        x = y;
+    }
+
+    if (!x.allFinite()) return false;
+
+    m_sm_x = x;
+    m_sm_iters = std::max(iters, 1);
+    return true;
+}
+
+//==============================================================================
+
 void Transport::frozenThermalConductivityVector(double* const p_lambda)
 {
 	const int neq = m_thermo.nEnergyEqns();
@@ -273,31 +480,46 @@ double Transport::reactiveThermalConductivity()
 
 double Transport::butlerBrokawThermalConductivity()
 {
+    updateButlerBrokawSystem();
+    return m_bb_lambda;
+}
+
+//==============================================================================
+
+bool Transport::updateButlerBrokawSystem()
+{
+    const unsigned long epoch = m_thermo.stateEpoch();
+    if (m_bb_epoch == epoch)
+        return true;
+    m_bb_epoch = epoch;
+
     const int ns = m_thermo.nGas();
     const int ne = m_thermo.nElements();
     const int nr = ns - ne;
     const int nh = m_thermo.nHeavy();
     const int a  = ns - nh;
 
-    const Eigen::MatrixXd& E = m_thermo.elementMatrix();
-
-    // Find the elements
-    Eigen::VectorXi ei(ne);
-    for (int i = 0; i < ne; ++i)
-        ei(i) = m_thermo.speciesIndex(m_thermo.elementName(i));
-
     // Generate formation reactions (assuming elements are always included)
-    Eigen::MatrixXd nu(nr, ns);
-    nu.setConstant(0);
-    for (int i = 0, ir = 0; i < ns; ++i) {
-        if (E.row(i).array().abs().sum() == 1)
-            continue;
-
-        // Add formation reaction for the species
-        for (int j = 0; j < ne; ++j)
-            nu(ir,ei(j)) = -E(i,j);
-        nu(ir++,i) = 1;
+    if (m_bb_nu.rows() != nr || m_bb_nu.cols() != ns) {
+        const Eigen::MatrixXd& E = m_thermo.elementMatrix();
+
+        // Find the elements
+        Eigen::VectorXi ei(ne);
+        for (int i = 0; i < ne; ++i)
+            ei(i) = m_thermo.speciesIndex(m_thermo.elementName(i));
+
+        m_bb_nu.setConstant(nr, ns, 0.0);
+        for (int i = 0, ir = 0; i < ns; ++i) {
+            if (E.row(i).array().abs().sum() == 1)
+                continue;
+
+            // Add formation reaction for the species
+            for (int j = 0; j < ne; ++j)
+                m_bb_nu(ir,ei(j)) = -E(i,j);
+            m_bb_nu(ir++,i) = 1;
+        }
     }
+    const Eigen::MatrixXd& nu = m_bb_nu;
 
     // Compute the Delta H vector
     Eigen::VectorXd H(ns);
@@ -306,7 +528,8 @@ double Transport::butlerBrokawThermalConductivity()
     DH = (nu * H) * KB * m_thermo.T();
 
     // Compute the system matrix
-    Eigen::MatrixXd A(nr,nr); A.setConstant(0.0);
+    m_bb_sys.setConstant(nr, nr, 0.0);
+    Eigen::MatrixXd& A = m_bb_sys;
     Eigen::MatrixXd nDij(ns,ns);
     if (m_thermo.hasElectrons()) {
         for (int i = 0; i < ns; ++i) {
@@ -337,29 +560,36 @@ double Transport::butlerBrokawThermalConductivity()
 
     //A *= RU*m_thermo.T()*m_thermo.numberDensity()/m_thermo.P();
 
-    Eigen::VectorXd W = Eigen::LDLT<Eigen::MatrixXd, Eigen::Lower>(A).solve(DH);
+    m_bb_ldlt.compute(A);
+    Eigen::VectorXd W = m_bb_ldlt.solve(DH);
 
-    return W.dot(DH)/(KB*m_thermo.T()*m_thermo.T());
+    m_bb_lambda = W.dot(DH)/(KB*m_thermo.T()*m_thermo.T());
+    return false;
 }
 
 //==============================================================================
 
 double Transport::soretThermalConductivity()
 {
-	// @todo This is super inefficient, should fix
+    // Compute the thermal diffusion ratios
+    heavyThermalDiffusionRatios(mp_wrk2);
+    return soretThermalConductivity(mp_wrk2);
+}
+
+//==============================================================================
+
+double Transport::soretThermalConductivity(const double* const p_k)
+{
 	Eigen::VectorXd work(m_thermo.nGas());
 
 	// Compute dX_i/dT
     m_thermo.dXidT(mp_wrk1);
 
-    // Compute the thermal diffusion ratios
-    heavyThermalDiffusionRatios(mp_wrk2);
-
     // @todo Add the electron thermal diffusion ratios
 
     // Combine to get the driving forces
     for (int i = 0; i < m_thermo.nGas(); i++)
-        mp_wrk1[i] += mp_wrk2[i] / m_thermo.T();
+        mp_wrk1[i] += p_k[i] / m_thermo.T();
 
     // Compute the diffusion velocities
     double E;
@@ -367,7 +597,7 @@ double Transport::soretThermalConductivity()
 
     double lambda = 0.0;
     for (int i = 0; i < m_thermo.nGas(); i++)
-        lambda -= mp_wrk2[i]*work[i];
+        lambda -= p_k[i]*work[i];
 
     return (m_thermo.P()*lambda);
 }
@@ -379,20 +609,12 @@ void Transport::equilDiffFluxFacs(double* const p_F)
 	// Get some state data
 	const int ns = m_thermo.nGas();
 	const int ne = m_thermo.nElements();
-	const double* const p_Y = m_thermo.Y();
-	const double* const p_X = m_thermo.X();
-	const double rho = m_thermo.density();
-	const double p   = m_thermo.P();
-
-	const MatrixXd& Dij = diffusionMatrix();
 	const Eigen::MatrixXd& nu  = m_thermo.elementMatrix();
 
-	for (int i = 0; i < ns; ++i) {
-		mp_wrk2[i] = 0.0;
-		for (int j = 0; j < ns; ++j)
-			mp_wrk2[i] += Dij(i,j)*mp_wrk1[j];
-		mp_wrk2[i] *= -rho*p_Y[i]/m_thermo.speciesMw(i);
-	}
+	// Species molar diffusion fluxes
+	diffusionFluxes(mp_wrk1, mp_wrk2);
+	for (int i = 0; i < ns; ++i)
+		mp_wrk2[i] /= m_thermo.speciesMw(i);
 
 	for (int k = 0; k < ne; ++k) {
 		p_F[k] = 0.0;
@@ -496,10 +718,47 @@ void Transport::stefanMaxwell(double Th, double Te,
 {
     const int ns = m_thermo.nGas();
     const int k  = ns - m_thermo.nHeavy();
+
+    // Form the SM matrix
+    MatrixXd G;
+    double a;
+    const double s = stefanMaxwellSystem(Th, Te, order, G, a);
+
+    // Form the right hand side
+    VectorXd b = VectorXd::Zero(ns+k);
+    b.head(ns) = -Map<const VectorXd>(p_dp, ns);
+    if (k == 1) b(0) *= Th/Te;
+
+    // Solve the system, iteratively starting from the previous solution if
+    // requested and directly otherwise or if the iterations fail
+    VectorXd x(ns+k);
+    m_sm_iters = 0;
+    if (m_sm_tol > 0.0 && !iterativeStefanMaxwell(G, b, k, x))
+        m_sm_iters = -1;
+
+    // Modified solver because old one failing
+    if (m_sm_iters <= 0)
+        x = G.colPivHouseholderQr().solve(b);
+   // VectorXd x = G.householderQr().solve(b);
+
+    // Retrieve the solution
+    Map<VectorXd>(p_V, ns) = x.head(ns);
+    E = (k == 1 ? x(ns)/s : 0.0);
+
+    // Apply Ramshaw to fix roundoff errors
+    Map<ArrayXd>(p_V, ns) -= (Map<ArrayXd>(p_V, ns)*Map<const ArrayXd>(m_thermo.Y(), ns)).sum();
+}
+
+//==============================================================================
+
+double Transport::stefanMaxwellSystem(
+    double Th, double Te, int order, MatrixXd& G, double& a)
+{
+    const int ns = m_thermo.nGas();
+    const int k  = ns - m_thermo.nHeavy();
     const double nd = m_thermo.numberDensity();
 
-    static ArrayXd X;
-    X = Map<const ArrayXd>(m_thermo.X(), ns) + 1.0e-16;
+    ArrayXd X = Map<const ArrayXd>(m_thermo.X(), ns) + 1.0e-16;
     X /= X.sum();
 
     ArrayXd qi(ns), Mi(ns);
@@ -509,11 +768,11 @@ void Transport::stefanMaxwell(double Th, double Te,
     }
 
     // Form the SM matrix
-    MatrixXd G = MatrixXd::Zero(ns+k,ns+k);
+    G = MatrixXd::Zero(ns+k,ns+k);
 
     // electron subsystem
     double s = 0.0;
-    double a = 0.0;
+    a = 0.0;
     if (k == 1) {
         const ArrayXd& nDei = m_collisions.nDei();
         ArrayXd phi; smCorrectionsElectron(order, phi);
@@ -555,22 +814,114 @@ void Transport::stefanMaxwell(double Th, double Te,
     ArrayXd Y = X * Mi / (Mi*X).sum();
     G.topLeftCorner(ns,ns) += a * Y.matrix() * Y.matrix().transpose();
 
-    // Form the right hand side
-    VectorXd b = VectorXd::Zero(ns+k);
-    b.head(ns) = -Map<const VectorXd>(p_dp, ns);
-    if (k == 1) b(0) *= Th/Te;
+    return s;
+}
 
-    // Solve the system
-    // Modified solver because old one failing
-    VectorXd x = G.colPivHouseholderQr().solve(b);
-   // VectorXd x = G.householderQr().solve(b);
+//==============================================================================
 
-    // Retrieve the solution
-    Map<VectorXd>(p_V, ns) = x.head(ns);
-    E = (k == 1 ? x(ns)/s : 0.0);
+void Transport::stefanMaxwellJacobian(
+    const double* const p_dp, double* const p_dVdd, double* const p_dVdX,
+    int order)
+{
+    const int ns = m_thermo.nGas();
+    const int k  = ns - m_thermo.nHeavy();
+    const double Th = m_thermo.T();
+    const double Te = m_thermo.Te();
+    const double r  = Te/Th;
 
-    // Apply Ramshaw to fix roundoff errors
-    Map<ArrayXd>(p_V, ns) -= (Map<ArrayXd>(p_V, ns)*Map<const ArrayXd>(m_thermo.Y(), ns)).sum();
+    MatrixXd G;
+    double a;
+    const double s = stefanMaxwellSystem(Th, Te, order, G, a);
+    const ColPivHouseholderQR<MatrixXd> qr(G);
+
+    // Right hand sides for unit driving forces, as in stefanMaxwell()
+    MatrixXd B = MatrixXd::Zero(ns+k,ns);
+    B.topRows(ns).diagonal().setConstant(-1.0);
+    if (k == 1) B(0,0) *= Th/Te;
+
+    const Map<const VectorXd> Yt(m_thermo.Y(), ns);
+    Map<MatrixXd> dVdd(p_dVdd, ns, ns);
+    dVdd = qr.solve(B).topRows(ns);
+    dVdd.rowwise() -= Yt.transpose()*dVdd;
+
+    if (p_dVdX == NULL)
+        return;
+
+    // Solution at the given driving forces
+    const VectorXd x = qr.solve(B*Map<const VectorXd>(p_dp, ns));
+
+    ArrayXd X = Map<const ArrayXd>(m_thermo.X(), ns) + 1.0e-16;
+    X /= X.sum();
+
+    ArrayXd qi(ns), Mi(ns);
+    for (int i = 0; i < ns; ++i) {
+        qi(i) = m_thermo.speciesCharge(i);
+        Mi(i) = m_thermo.speciesMw(i);
+    }
+    const double Mbar = (Mi*X).sum();
+    const ArrayXd Y = X*Mi/Mbar;
+    const double nd = m_thermo.numberDensity();
+
+    // D(:,j) is the derivative of G with respect to x_j, times the solution.
+    // Every binary term of G is proportional to x_i*x_j.
+    MatrixXd D = MatrixXd::Zero(ns+k,ns);
+
+    if (k == 1) {
+        const ArrayXd& nDei = m_collisions.nDei();
+        ArrayXd phi; smCorrectionsElectron(order, phi);
+        for (int i = 1; i < ns; ++i) {
+            const double w  = nd*(1.0+phi(i))/nDei(i);
+            const double g0 = w*(x(0) - r*x(i));
+            const double gi = w*r*(r*x(i) - x(0));
+            D(0,0) += g0*X(i);
+            D(0,i) += g0*X(0);
+            D(i,0) += gi*X(i);
+            D(i,i) += gi*X(0);
+        }
+
+        // Ambipolar constraint, the scaling s does not change the velocities
+        const double Q = (qi*X).sum();
+        for (int j = 0; j < ns; ++j) {
+            ArrayXd dkappa = -X*Mi*(qi(j)*Mbar - Q*Mi(j))/(Mbar*Mbar);
+            dkappa(j) += qi(j) - Mi(j)*Q/Mbar;
+            dkappa /= KB*Th*s;
+
+            D(ns,j) += (dkappa*x.head(ns).array()).sum();
+            D.col(j).head(ns) += dkappa.matrix()*x(ns);
+            D(0,j) += dkappa(0)*x(ns)*(Th/Te - 1.0);
+        }
+    }
+
+    const ArrayXd& nDij = m_collisions.nDij();
+    ArrayXd phi; smCorrectionsHeavy(order, phi);
+    for (int i = k, is = 1; i < ns; ++i, ++is) {
+        for (int j = i+1; j < ns; ++j, ++is) {
+            const double g = nd*(1.0+phi(is))/nDij(is)*(x(i) - x(j));
+            D(i,i) += g*X(j);
+            D(i,j) += g*X(i);
+            D(j,i) -= g*X(j);
+            D(j,j) -= g*X(i);
+        }
+    }
+
+    // Mass constraint a*Y*Y^T, with dY/dx_j = M_j*(e_j - Y)/Mbar
+    const double Yx = Y.matrix().dot(x.head(ns));
+    for (int j = 0; j < ns; ++j) {
+        const double f = Mi(j)/Mbar;
+        D.col(j).head(ns) += a*f*(x(j) - Yx)*Y.matrix();
+        D.col(j).head(ns) -= a*f*Yx*Y.matrix();
+        D(j,j) += a*f*Yx;
+    }
+
+    // Differentiate G*x = b and the Ramshaw correction
+    Map<MatrixXd> dVdX(p_dVdX, ns, ns);
+    dVdX = -qr.solve(D).topRows(ns);
+
+    const double Ytx = Yt.dot(x.head(ns));
+    RowVectorXd c = Yt.transpose()*dVdX;
+    for (int j = 0; j < ns; ++j)
+        c(j) += Mi(j)/Mbar*(x(j) - Ytx);
+    dVdX.rowwise() -= c;
 }
 
 void Transport::smCorrectionsElectron(int order, Eigen::ArrayXd& phi)
@@ -608,11 +959,8 @@ void Transport::smCorrectionsHeavy(int order, Eigen::ArrayXd& phi)
     X /= X.sum();
 
     const ArrayXd& mi = m_collisions.mass();
-    const ArrayXd& Ast = m_collisions.Astij();
-    const ArrayXd& Bst = m_collisions.Bstij();
     const ArrayXd& Cst = m_collisions.Cstij();
     const ArrayXd& nDij = m_collisions.nDij();
-    const ArrayXd& etai = m_collisions.etai();
 
     // Compute the Lam01 matrix
     MatrixXd Lam01(nh,nh);
@@ -629,31 +977,11 @@ void Transport::smCorrectionsHeavy(int order, Eigen::ArrayXd& phi)
     }
 
 
-    // Compute the Glamh matrix (only lower part)
-    MatrixXd Glamh(nh,nh);
-    Glamh.diagonal().array() = 4./(15.0*KB)*(X*X*mi).tail(nh)/etai;
-    double miij, mjij;
-    int ik, jk;
-    for (int j = 0, si = 1; j < nh; ++j, ++si) {
-        jk = j+k;
-        for (int i = j+1; i < nh; ++i, ++si) {
-            ik = i+k;
-            miij = mi(ik) / (mi(ik) + mi(jk));
-            mjij = mi(jk) / (mi(ik) + mi(jk));
-            fac  = X(ik)*X(jk) / (nDij(si)*25.*KB);
-            Glamh(i,j) = fac * miij * mjij *
-                (16.0 * Ast(si) + 12.0 * Bst(si) - 55.0);
-            Glamh(i,i) += fac * (miij * (30.0 * miij + 16.0 * mjij *
-                Ast(si)) + mjij * mjij * (25.0 - 12.0 * Bst(si)));
-            Glamh(j,j) += fac * (mjij * (30.0 * mjij + 16.0 * miij *
-                Ast(si)) + miij * miij * (25.0 - 12.0 * Bst(si)));
-        }
-    }
-
-    //std::cout << Glamh << std::endl << std::endl;
-    //std::cout << Lam01 << std::endl << std::endl;
-
-    // Get LDLT factorization of the Glamh matrix
+    // Get the LDLT factorization of the Glamh matrix, which is the heavy
+    // particle thermal conductivity system
+    ArrayXd x;
+    MatrixXd Glamh;
+    heavyThermalConductivitySystem(m_collisions, x, Glamh);
     LDLT<MatrixXd, Lower> ldlt(Glamh);
 
     // Compute second order corrections
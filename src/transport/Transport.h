@@ -42,6 +42,52 @@ class DiffusionMatrix;
 class ThermalConductivityAlgorithm;
 class ViscosityAlgorithm;
 
+/// Flags selecting the properties computed by Transport::computeAll().
+enum TransportProperty {
+    VISCOSITY                  = 1 << 0,
+    HEAVY_THERMAL_CONDUCTIVITY = 1 << 1,
+    THERMAL_DIFFUSION_RATIOS   = 1 << 2,
+    SORET_THERMAL_CONDUCTIVITY = 1 << 3,
+    BUTLER_BROKAW_CONDUCTIVITY = 1 << 4,
+    ALL_TRANSPORT_PROPERTIES   = (1 << 5) - 1
+};
+
+/// Chapman-Enskog systems which are factorized at most once per state.
+enum TransportSystem {
+    HEAVY_LAMBDA_SYSTEM  = 1 << 0, ///< heavy particle thermal conductivity system
+    BUTLER_BROKAW_SYSTEM = 1 << 1  ///< Butler-Brokaw reaction system
+};
+
+/**
+ * Properties computed by Transport::computeAll().  Only the members selected
+ * by the TransportProperty flags of the call are set.
+ */
+struct TransportProperties
+{
+    double viscosity;    ///< mixture viscosity in Pa-s
+    double lambda_h;     ///< heavy particle thermal conductivity in W/m-K
+    double lambda_soret; ///< Soret thermal conductivity in W/m-K
+    double lambda_bb;    ///< Butler-Brokaw thermal conductivity in W/m-K
+    Eigen::ArrayXd k_Ti; ///< heavy thermal diffusion ratios (all species)
+
+    /// TransportSystem flags of the systems factorized during the call
+    unsigned int factorized;
+    /// TransportSystem flags of the systems reused from a factorization of
+    /// the same state
+    unsigned int reused;
+};
+
+/**
+ * Counts of the evaluations made by an "Auto" viscosity or thermal
+ * conductivity algorithm.
+ */
+struct AutoTransportCounts
+{
+    unsigned long n_cheap; ///< evaluations with the Wilke mixture rule
+    unsigned long n_full;  ///< evaluations with the Chapmann-Enskog solution
+    unsigned long n_audit; ///< full evaluations made only to audit the rule
+};
+
 /**
  * Manages the computation of transport properties.
  */
@@ -73,6 +119,25 @@ public:
     /// Sets the diffusion matrix algorithm.
     void setDiffusionMatrixAlgo(const std::string& algo);
 
+    /**
+     * Sets the relative tolerance on the estimated error of the Wilke mixture
+     * rule above which the "Auto" viscosity and thermal conductivity
+     * algorithms use the Chapmann-Enskog solution instead (1e-2 by default).
+     * Other algorithms are not affected.
+     */
+    void setAutoTransportTolerance(double tol);
+
+    /**
+     * Gets the evaluation counts of the "Auto" viscosity and thermal
+     * conductivity algorithms.  The counts of an algorithm which is not "Auto"
+     * are zero.
+     */
+    void autoTransportCounts(
+        AutoTransportCounts& viscosity, AutoTransportCounts& lambda) const;
+
+    /// Resets the evaluation counts of the "Auto" algorithms.
+    void resetAutoTransportCounts();
+
     /// Returns the number of collision pairs accounted for in this mixture.
     int nCollisionPairs() const { return m_collisions.size(); }
     
@@ -81,6 +146,14 @@ public:
     
     /// Returns the mixture viscosity.
     double viscosity();
+
+    /**
+     * Returns the mixture viscosity and computes its analytic derivatives with
+     * respect to temperature (Pa-s/K) and to the species mole fractions
+     * (nSpecies values, zero for electrons), each with the other variables
+     * held fixed.  The Debye length of charged collisions is held fixed too.
+     */
+    double viscosityDerivatives(double& dmu_dT, double* const p_dmu_dx);
     
     /**
      * Returns the mixture thermal conductivity for a frozen mixture.
@@ -115,6 +188,15 @@ public:
      * set algorithm.
      */
     double heavyThermalConductivity();
+
+    /**
+     * Returns the heavy particle translational thermal conductivity and
+     * computes its analytic derivatives with respect to temperature (W/m-K^2)
+     * and to the species mole fractions (nSpecies values, zero for electrons).
+     * @see viscosityDerivatives()
+     */
+    double heavyThermalConductivityDerivatives(
+        double& dlam_dT, double* const p_dlam_dx);
     
     /**
      * Returns the thermal conductivity of an internal energy mode using
@@ -128,7 +210,7 @@ public:
         const int k  = ns-nh;
 
         Eigen::Map<const Eigen::ArrayXd> X(m_thermo.X()+k, nh);
-        static Eigen::ArrayXd avDij; avDij.resize(nh);
+        Eigen::ArrayXd avDij(nh);
         const Eigen::ArrayXd& nDij = m_collisions.nDij();
 
         avDij.setZero();
@@ -185,10 +267,29 @@ public:
     
     /// Returns the heavy thermal diffusion ratios for each species.
     void heavyThermalDiffusionRatios(double* const p_k);
+
+    /**
+     * Computes every property selected by the TransportProperty flags at the
+     * current state.  Each Chapman-Enskog system is assembled and factorized
+     * once per state and every requested property is derived from it.  The
+     * heavy particle system is the one of the selected thermal conductivity
+     * algorithm, solved with its own solver.  The factorized and reused
+     * members of props tell which systems were factorized by this call and
+     * which were reused.
+     */
+    void computeAll(unsigned int flags, TransportProperties& props);
     
     /// Returns the multicomponent diffusion coefficient matrix.
     const Eigen::MatrixXd& diffusionMatrix();
 
+    /**
+     * Computes the species mass diffusion fluxes
+     * \f[ J_i = -\rho_i \sum_j D_{ij} d_j \f]
+     * in kg/m^2-s for the given driving forces, without forming the
+     * diffusion matrix when the diffusion matrix algorithm allows it.
+     */
+    void diffusionFluxes(const double* const p_d, double* const p_J);
+
     /**
      * Returns the average diffusion coefficients.
      * \f[ D_{im} = \frac{(1-x_i)}{\sum_{j\ne i}x_j/\mathscr{D}_{ij}} \f]
@@ -373,6 +474,44 @@ public:
     void stefanMaxwell(double Th, double Te,
         const double* const p_dp, double* const p_V, double& E, int order = 1);
 
+    /**
+     * Computes the derivatives of the diffusion velocities given by
+     * stefanMaxwell() at the current state and for the supplied modified
+     * driving forces.  The velocities are linear in the driving forces, so
+     * \f$\partial V_i / \partial d^{'}_j\f$ is the (Ramshaw corrected)
+     * inverse of the Stefan-Maxwell system.  The derivatives with respect to
+     * the mole fractions are taken at constant driving forces, temperatures
+     * and number density, with the higher order correction factors held
+     * fixed.  The system is factorized once for all columns.
+     *
+     * @param p_dp   - the vector of modified driving forces \f$ d^{'}_i \f$
+     * @param p_dVdd - on return, \f$\partial V_i / \partial d^{'}_j\f$
+     *                 (ns x ns, column-major)
+     * @param p_dVdX - (optional) on return, \f$\partial V_i / \partial x_j\f$
+     *                 (ns x ns, column-major)
+     */
+    void stefanMaxwellJacobian(
+        const double* const p_dp, double* const p_dVdd,
+        double* const p_dVdX = NULL, int order = 1);
+
+    /**
+     * Selects how the Stefan-Maxwell equations are solved.  With a positive
+     * tolerance, the system is solved by a Jacobi preconditioned BiCGSTAB
+     * iteration which is seeded with the previous solution and which falls
+     * back to the direct QR factorization if it does not reach the relative
+     * residual tol within max_iters iterations.  A tolerance <= 0 (the
+     * default) always uses the direct factorization.
+     */
+    void setStefanMaxwellTolerance(double tol, int max_iters = 100);
+
+    /**
+     * Returns the number of iterations used by the last Stefan-Maxwell
+     * solution (at least 1 when solved iteratively), 0 if it was solved
+     * directly or -1 if the iterative solver failed and the direct
+     * factorization was used instead.
+     */
+    int stefanMaxwellIterations() const { return m_sm_iters; }
+
     /// Computes the electron corrections for the Stefan-Maxwell equations.
     void smCorrectionsElectron(int order, Eigen::ArrayXd& phi);
     
@@ -413,6 +552,19 @@ public:
         return mp_esubsyst->electronDiffusionCoefficientB(order);
     }
 
+    /**
+     * Computes the electric conductivity, electron thermal conductivity,
+     * electron diffusion coefficient and electron thermal diffusion ratio
+     * together (and their anisotropic forms if requested) from a single
+     * assembly of the electron subsystem.
+     */
+    void electronProperties(
+        ElectronTransportProperties& props, int order = 3,
+        bool anisotropic = false)
+    {
+        mp_esubsyst->electronProperties(props, order, anisotropic);
+    }
+
     /// Isotropic second-order electron diffusion coefficient.
     double electronDiffusionCoefficient2(int order = 3)
     {
@@ -546,6 +698,34 @@ private:
 	 */
 	void equilDiffFluxFacs(double* const p_F);
 
+    /**
+     * Assembles and factorizes the Butler-Brokaw system and solves for the
+     * reactive conductivity, unless this was already done at the current
+     * state.  Returns true if the factorization was reused.
+     */
+    bool updateButlerBrokawSystem();
+
+    /**
+     * Solves the Stefan-Maxwell system G x = b with the iterative solver.  The
+     * species block is solved by BiCGSTAB and, with electrons, the ambipolar
+     * field is obtained from the zero current constraint (Schur complement).
+     * Returns false if the iterations did not converge.
+     */
+    bool iterativeStefanMaxwell(
+        const Eigen::MatrixXd& G, const Eigen::VectorXd& b, int k,
+        Eigen::VectorXd& x);
+
+    /**
+     * Forms the Stefan-Maxwell system matrix G at the current composition and
+     * returns the scaling of the ambipolar constraint row (zero without
+     * electrons).  On return, a is the weight of the mass constraint.
+     */
+    double stefanMaxwellSystem(
+        double Th, double Te, int order, Eigen::MatrixXd& G, double& a);
+
+    /// Soret thermal conductivity given the heavy thermal diffusion ratios.
+    double soretThermalConductivity(const double* const p_k);
+
 private:
 
     Mutation::Thermodynamics::Thermodynamics& m_thermo;
@@ -555,6 +735,21 @@ private:
     ViscosityAlgorithm* mp_viscosity;
     ThermalConductivityAlgorithm* mp_thermal_conductivity;
     DiffusionMatrix* mp_diffusion_matrix;
+    double m_auto_tol;
+
+    // Butler-Brokaw system (formation reactions do not depend on the state)
+    unsigned long m_bb_epoch;
+    Eigen::MatrixXd m_bb_nu;
+    Eigen::MatrixXd m_bb_sys;
+    Eigen::LDLT<Eigen::MatrixXd, Eigen::Lower> m_bb_ldlt;
+    double m_bb_lambda;
+
+    // Iterative Stefan-Maxwell solver settings and previous solution
+    double m_sm_tol;
+    int m_sm_max_iters;
+    int m_sm_iters;
+    Eigen::VectorXd m_sm_x;
+    Eigen::VectorXd m_sm_z;
     
     double* mp_wrk1;
     double* mp_wrk2;
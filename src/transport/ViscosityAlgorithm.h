@@ -28,6 +28,10 @@
 #ifndef TRANSPORT_VISCOSITY_ALGORITHM_H
 #define TRANSPORT_VISCOSITY_ALGORITHM_H
 
+#include "Errors.h"
+
+#include <Eigen/Dense>
+
 namespace Mutation {
     namespace Transport {
 
@@ -58,6 +62,18 @@ public:
     /// Returns the mixture viscosity in Pa-s.
     virtual double viscosity() = 0;
 
+    /**
+     * Returns the mixture viscosity in Pa-s and computes its derivatives with
+     * respect to temperature in Pa-s/K and to the heavy species mole
+     * fractions, each with the other variables held fixed.  Algorithms which
+     * do not provide analytic derivatives throw a NotImplementedError.
+     */
+    virtual double viscosityDerivatives(
+        double& dmu_dT, Eigen::ArrayXd& dmu_dx)
+    {
+        throw NotImplementedError("ViscosityAlgorithm::viscosityDerivatives()");
+    }
+
 protected:
 
     CollisionDB& m_collisions;
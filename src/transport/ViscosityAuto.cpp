@@ -0,0 +1,98 @@
+/**
+ * @file ViscosityAuto.cpp
+ *
+ * @brief Provides ViscosityAuto class.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "AutoRegistration.h"
+#include "AutoSelector.h"
+#include "CollisionDB.h"
+#include "ViscosityAlgorithm.h"
+
+#include <Eigen/Dense>
+
+using namespace Mutation::Utilities;
+
+namespace Mutation {
+    namespace Transport {
+
+/**
+ * Computes the viscosity with the Wilke mixture rule where it is estimated to
+ * be accurate to within the tolerance, and with the Chapmann-Enskog LDLT
+ * algorithm elsewhere.
+ *
+ * @see AutoSelector
+ */
+class ViscosityAuto : public ViscosityAlgorithm, public AutoSelector
+{
+public:
+
+    ViscosityAuto(ViscosityAlgorithm::ARGS collisions)
+        : ViscosityAlgorithm(collisions),
+          AutoSelector(collisions),
+          mp_cheap(Config::Factory<ViscosityAlgorithm>::create(
+              "Wilke", collisions)),
+          mp_full(Config::Factory<ViscosityAlgorithm>::create(
+              "Chapmann-Enskog_LDLT", collisions))
+    { }
+
+    ~ViscosityAuto()
+    {
+        delete mp_cheap;
+        delete mp_full;
+    }
+
+    /// Returns the viscosity of the mixture in Pa-s.
+    double viscosity()
+    {
+        if (useMixtureRule(m_collisions.X().tail(m_collisions.nHeavy())))
+            return mp_cheap->viscosity();
+
+        const double mu = mp_full->viscosity();
+        calibrate(mp_cheap->viscosity(), mu);
+        return mu;
+    }
+
+    /// Returns the viscosity and its derivatives with the selected algorithm.
+    double viscosityDerivatives(double& dmu_dT, Eigen::ArrayXd& dmu_dx)
+    {
+        if (useMixtureRule(m_collisions.X().tail(m_collisions.nHeavy())))
+            return mp_cheap->viscosityDerivatives(dmu_dT, dmu_dx);
+
+        const double mu = mp_full->viscosityDerivatives(dmu_dT, dmu_dx);
+        calibrate(mp_cheap->viscosity(), mu);
+        return mu;
+    }
+
+private:
+
+    ViscosityAlgorithm* mp_cheap;
+    ViscosityAlgorithm* mp_full;
+};
+
+// Register this algorithm
+Config::ObjectProvider<ViscosityAuto, ViscosityAlgorithm> visc_auto("Auto");
+
+    } // namespace Transport
+} // namespace Mutation
@@ -28,6 +28,7 @@
 
 #include "AutoRegistration.h"
 #include "CollisionDB.h"
+#include "FixedSizeSolvers.h"
 #include "Thermodynamics.h"
 #include "ViscosityAlgorithm.h"
 
@@ -41,7 +42,8 @@ namespace Mutation {
     namespace Transport {
 
 /**
- * Computes the viscosity using the full Chapmann-Enskog formulation.
+ * Computes the viscosity using the full Chapmann-Enskog formulation.  When
+ * Solver is LDLT, common system sizes are solved with fixed-size kernels.
  *
  * @param Solver an Eigen linear system solver
  */
@@ -53,6 +55,7 @@ public:
 		ViscosityAlgorithm(collisions),
 		m_sys(MatrixXd::Zero(collisions.nHeavy(), collisions.nHeavy())),
 		m_x(collisions.nHeavy()),
+		m_b(collisions.nHeavy()),
 		m_alpha(collisions.nHeavy())
 	{ }
 
@@ -84,18 +87,69 @@ public:
 			}
 		}
 
-		// Solve the linear system
-		m_solver.compute(m_sys);
-		m_alpha = m_solver.solve(m_x.matrix());
+		// Solve the linear system, with a fixed-size kernel when available
+		m_b = m_x.matrix();
+		solveSymmetric<Solver>(m_sys, m_b, m_alpha, m_solver);
 
 		// Finally compute the dot product of alpha and X
 		return m_x.matrix().dot(m_alpha);
 	}
 
+	/**
+	 * Returns the viscosity and its temperature and mole fraction derivatives.
+	 * Since the viscosity \f$x^T A^{-1} x\f$ has the symmetric system solution
+	 * \f$\alpha\f$ as its own adjoint, the derivatives are
+	 * \f$2\alpha^T dx - \alpha^T dA\,\alpha\f$ and need no other solution.
+	 */
+	double viscosityDerivatives(double& dmu_dT, ArrayXd& dmu_dx)
+	{
+		const double mu = viscosity();
+
+		const int ns = m_collisions.nSpecies();
+		const int nh = m_collisions.nHeavy();
+		const double T = m_collisions.thermo().T();
+
+		const ArrayXd& mi   = m_collisions.mass();
+		const ArrayXd& Ast  = m_collisions.Astij();
+		const ArrayXd& nDij = m_collisions.nDij();
+		const ArrayXd& etai = m_collisions.etai();
+		const ArrayXd& dlnQ11 = m_collisions.dlnT(CollisionDB::Q11IJ);
+		const ArrayXd& dlnQ22 = m_collisions.dlnT(CollisionDB::Q22II);
+		const ArrayXd& dlnAst = m_collisions.dlnT(CollisionDB::ASTIJ);
+
+		// Diagonal terms x_i^2/eta_i, with eta_i proportional to sqrt(T)/Q22_ii
+		const ArrayXd a = m_alpha.array();
+		const ArrayXd q = m_x * m_x / etai * a * a;
+		dmu_dx = 2.0*a - 2.0*q/m_x;
+		dmu_dT = (q * (0.5 - dlnQ22)).sum() / T;
+
+		// Pair terms, with nDij proportional to sqrt(T)/Q11_ij
+		int k = ns-nh, ik, jk;
+		double fac, P, dPdA;
+		for (int j = 0, index = 1; j < nh; ++j, ++index) {
+			jk = j+k;
+			for (int i = j+1; i < nh; ++i, ++index) {
+				ik = i+k;
+				fac  = m_x(i)*m_x(j) / (nDij(index) * (mi(ik) + mi(jk)));
+				dPdA = 1.2 * (mi(jk) / mi(ik) * a(i)*a(i) +
+					mi(ik) / mi(jk) * a(j)*a(j) + 2.0 * a(i)*a(j));
+				P = Ast(index) * dPdA + 2.0 * (a(i) - a(j)) * (a(i) - a(j));
+
+				dmu_dx(i) -= fac * P / m_x(i);
+				dmu_dx(j) -= fac * P / m_x(j);
+				dmu_dT -= fac * ((dlnQ11(index) - 0.5) * P +
+					Ast(index) * dlnAst(index) * dPdA) / T;
+			}
+		}
+
+		return mu;
+	}
+
 private:
 
 	MatrixXd m_sys;
 	ArrayXd m_x;
+	VectorXd m_b;
 	VectorXd m_alpha;
 	Solver<MatrixXd, Lower> m_solver;
 };
@@ -81,12 +81,67 @@ public:
         // Now compute the viscosity using Gupta-Yos
         return guptaYos(A, a, x);
     }
+
+    /**
+     * Returns the viscosity of the mixture in Pa-s and its temperature and
+     * mole fraction derivatives.
+     */
+    double viscosityDerivatives(double& dmu_dT, ArrayXd& dmu_dx)
+    {
+        const int ns = m_collisions.nSpecies();
+        const int nh = m_collisions.nHeavy();
+        const int k  = ns - nh;
+        const double T = m_collisions.thermo().T();
+
+        const ArrayXd& nDij = m_collisions.nDij();
+        const ArrayXd& Ast  = m_collisions.Astij();
+        const ArrayXd& mi   = m_collisions.mass();
+        const ArrayXd& dlnQ11 = m_collisions.dlnT(CollisionDB::Q11IJ);
+        const ArrayXd& dlnAst = m_collisions.dlnT(CollisionDB::ASTIJ);
+        const Map<const ArrayXd> x(m_collisions.thermo().X()+k, nh);
+
+        // Same as viscosity(), but also keep the temperature derivatives of A
+        // and B, using nDij proportional to sqrt(T)/Q11_ij
+        dAdT.setZero(nh, nh);
+        dBdT.resize(nh, nh);
+        double dlnnD, dlnA;
+        for (int j = 0, index = 0; j < nh; ++j) {
+            for (int i = j; i < nh; ++i, ++index) {
+                dlnnD = (0.5 - dlnQ11(index)) / T;
+                dlnA  = dlnAst(index) / T;
+                A(i,j) = (2.0-1.2*Ast(index))/((mi(i+k)+mi(j+k))*nDij(index));
+                B(i,j) = Ast(index) / nDij(index);
+                dAdT(i,j) = -1.2*Ast(index)*dlnA/((mi(i+k)+mi(j+k))*nDij(index))
+                    - A(i,j)*dlnnD;
+                dBdT(i,j) = B(i,j)*(dlnA - dlnnD);
+            }
+        }
+
+        a.matrix() = B.selfadjointView<Lower>() * x.matrix();
+        a *= 1.2 / mi.tail(nh);
+
+        const double mu = guptaYos(A, a, x, dA, da, dmu_dx);
+
+        // Chain rule through A and a = 1.2/m_i sum_j B_ij x_j
+        da *= 1.2 / mi.tail(nh);
+        dmu_dT = (dA * dAdT).sum() + da.matrix().dot(
+            dBdT.selfadjointView<Lower>() * x.matrix());
+        dmu_dx.matrix() += B.selfadjointView<Lower>() * da.matrix();
+
+        return mu;
+    }
     
 private:
     
     ArrayXXd A;
     MatrixXd B;
     ArrayXd  a;
+
+    // Work arrays for the derivatives
+    ArrayXXd dAdT;
+    MatrixXd dBdT;
+    ArrayXXd dA;
+    ArrayXd  da;
 };
 
 Config::ObjectProvider<ViscosityGuptaYos, ViscosityAlgorithm> 
@@ -61,6 +61,24 @@ public:
             Eigen::Map<const Eigen::ArrayXd>(m_collisions.thermo().X()+k, nh));
     }
 
+    /// Returns the viscosity and its temperature and mole fraction derivatives.
+    double viscosityDerivatives(double& dmu_dT, Eigen::ArrayXd& dmu_dx)
+    {
+        const int nh = m_collisions.nHeavy();
+        const int k  = m_collisions.nSpecies()-nh;
+        const double T = m_collisions.thermo().T();
+
+        // eta_i is proportional to sqrt(T)/Q22_ii
+        const Eigen::ArrayXd& etai = m_collisions.etai();
+        const Eigen::ArrayXd dlneta_dT =
+            (0.5 - m_collisions.dlnT(CollisionDB::Q22II)) / T;
+
+        return wilke(
+            etai, dlneta_dT, m_collisions.mass().tail(nh),
+            Eigen::Map<const Eigen::ArrayXd>(m_collisions.thermo().X()+k, nh),
+            dmu_dT, dmu_dx);
+    }
+
 };
 
 // Register this algorithm
@@ -72,6 +72,60 @@ protected:
         return average;
     }
 
+    /**
+     * Evaluates the Wilke formula as above and computes its derivatives with
+     * respect to temperature and to the mole fractions, given the temperature
+     * derivatives of the logarithms of the species values in dlnvals_dT.
+     */
+    template <typename E1, typename E2, typename E3, typename E4>
+    double wilke(
+        const Eigen::ArrayBase<E1>& vals, const Eigen::ArrayBase<E2>& dlnvals_dT,
+        const Eigen::ArrayBase<E3>& mass, const Eigen::ArrayBase<E4>& x,
+        double& dT, Eigen::ArrayXd& dx)
+    {
+        const int ns = vals.size();
+        double average = 0.0, sum, dsum, ratio, root, temp, den;
+
+        m_phi.resize(ns, ns);
+        dx.setZero(ns);
+        dT = 0.0;
+
+        for (int i = 0; i < ns; ++i) {
+            sum = dsum = 0.0;
+
+            for (int j = 0; j < ns; ++j) {
+                if (i == j) {
+                    sum += x(j);
+                    m_phi(i,j) = 1.0;
+                } else {
+                    ratio = mass(i) / mass(j);
+                    root = std::sqrt(vals(i) / vals(j) / std::sqrt(ratio));
+                    temp = 1.0 + root;
+                    den  = std::sqrt(8.0 * (1.0 + ratio));
+                    m_phi(i,j) = temp * temp / den;
+                    sum  += x(j) * m_phi(i,j);
+                    dsum += x(j) * temp * root *
+                        (dlnvals_dT(i) - dlnvals_dT(j)) / den;
+                }
+            }
+
+            average += x(i) * vals(i) / sum;
+            dT += x(i) * vals(i) / sum * (dlnvals_dT(i) - dsum / sum);
+
+            // d(sum_i)/dx_j = phi_ij
+            dx(i) += vals(i) / sum;
+            temp = x(i) * vals(i) / (sum * sum);
+            for (int j = 0; j < ns; ++j)
+                dx(j) -= temp * m_phi(i,j);
+        }
+
+        return average;
+    }
+
+private:
+
+    Eigen::ArrayXXd m_phi;
+
 }; // class Wilke
 
 
@@ -35,6 +35,7 @@
 #include <iomanip>
 #include <iostream>
 #include <list>
+#include <vector>
 #include <cmath>
 
 #include "Errors.h"
@@ -719,8 +720,290 @@ void LookupTable<IndexType, DataType, FunctionType>::lookup(
     }
 } // lookup()
 
+//==============================================================================
+
+/**
+ * Coordinate in which the rows of a UniformLookupTable are evenly spaced.
+ */
+enum TableCoordinate {
+    LINEAR_COORDINATE,  ///< rows uniform in x
+    LOG_COORDINATE,     ///< rows uniform in ln(x)
+    INVERSE_COORDINATE  ///< rows uniform in 1/x
+};
+
+/**
+ * A lookup table whose rows are evenly spaced in a transformed coordinate
+ * \f$u(x)\f$, such as \f$\ln x\f$ or \f$1/x\f$, and which interpolates the
+ * functions with cubic Hermite polynomials in \f$u\f$.
+ *
+ * The bracketing row is computed directly from \f$u(x)\f$ in O(1), without
+ * any search.  The slopes at the rows are obtained from fourth order finite
+ * differences of the tabulated values and are stored, premultiplied by the
+ * row spacing, next to the values so that a lookup is a single loop of four
+ * fused multiply-adds over the contiguous function columns of two rows.
+ *
+ * Functions such as Boltzmann factors \f$\exp(-\theta/T)\f$ are much
+ * smoother in \f$1/T\f$ or \f$\ln T\f$ than in \f$T\f$, so that far fewer
+ * rows are needed than with the linear interpolation of LookupTable for the
+ * same error.  Lookups outside of the table range return the values at the
+ * nearest end of the table.
+ *
+ * @see LookupTable
+ */
+template<typename DataType, typename FunctionType>
+class UniformLookupTable
+{
+public:
+
+    /**
+     * Constructs the table with about the smallest number of rows for which
+     * the maximum error
+     * \f[ error = \max_i |\frac{interp_i}{exact_i} - 1| \f]
+     * at the midpoints of all intervals is below max_error.  As for
+     * LookupTable, the absolute error is used for exact values below 1e-10.
+     * Starting from nrows, the number of rows is grown from the observed
+     * fourth order convergence of the error until the tolerance is met.
+     */
+    UniformLookupTable(
+        double low, double high, int nfuncs,
+        const typename FunctionType::DataProvider& provider,
+        double max_error = 0.01, TableCoordinate coord = LOG_COORDINATE,
+        int nrows = 9)
+        : m_coord(coord), m_num_functions(nfuncs), m_low(low), m_high(high)
+    {
+        FunctionType function;
+        fill(nrows, function, provider);
+
+        while (m_error > max_error && m_num_indices < (1 << 20)) {
+            const double ratio = std::pow(m_error / max_error, 0.25);
+            fill(static_cast<int>(
+                std::min(1.1*ratio, 4.0)*(m_num_indices-1)) + 2,
+                function, provider);
+        }
+    }
+
+    /**
+     * Constructs the table with a given number of rows.
+     */
+    UniformLookupTable(
+        double low, double high, int nrows, int nfuncs,
+        const typename FunctionType::DataProvider& provider,
+        TableCoordinate coord = LOG_COORDINATE)
+        : m_coord(coord), m_num_functions(nfuncs), m_low(low), m_high(high)
+    {
+        fill(nrows, FunctionType(), provider);
+    }
+
+    /**
+     * Interpolates all of the functions at x.
+     */
+    void lookup(const double x, DataType* const p_values) const {
+        lookup(x, 0, m_num_functions, p_values,
+            Mutation::Numerics::Equals<DataType>());
+    }
+
+    /**
+     * Interpolates the functions [start, end) at x and applies op(p_values[i],
+     * value) to each of them.
+     */
+    template <typename OP>
+    void lookup(
+        const double x, const int start, const int end,
+        DataType* const p_values, const OP& op) const
+    {
+        lookup(bracket(x), start, end, p_values, op);
+    }
+
+    /**
+     * Bracketing row and Hermite basis weights at a given x, which can be
+     * reused to interpolate different sets of functions at the same x.
+     */
+    struct Bracket {
+        int row;
+        double h0, h1, g0, g1;
+    };
+
+    /**
+     * Returns the bracketing row and the Hermite basis weights at x.
+     */
+    Bracket bracket(const double x) const
+    {
+        // Bracketing row and position in the row interval
+        double u = (transform(x) - m_u0) * m_inv_du;
+        u = std::min(std::max(u, 0.0), static_cast<double>(m_num_indices-1));
+
+        Bracket b;
+        b.row = std::min(static_cast<int>(u), m_num_indices-2);
+        const double t = u - b.row;
+
+        // Cubic Hermite basis
+        const double t2 = t*t, s = 1.0-t, s2 = s*s;
+        b.h0 = (1.0+2.0*t)*s2; b.h1 = t2*(3.0-2.0*t);
+        b.g0 = t*s2;           b.g1 = -t2*s;
+        return b;
+    }
+
+    /**
+     * Interpolates the functions [start, end) with the bracket b and applies
+     * op(p_values[i], value) to each of them.
+     */
+    template <typename OP>
+    void lookup(
+        const Bracket& b, const int start, const int end,
+        DataType* const p_values, const OP& op) const
+    {
+        const DataType* const p_f0 = &m_data[b.row*m_num_functions];
+        const DataType* const p_f1 = p_f0 + m_num_functions;
+        const DataType* const p_d0 = &m_slopes[b.row*m_num_functions];
+        const DataType* const p_d1 = p_d0 + m_num_functions;
+
+        for (int k = start; k < end; ++k)
+            op(p_values[k],
+                b.h0*p_f0[k] + b.g0*p_d0[k] + b.h1*p_f1[k] + b.g1*p_d1[k]);
+    }
+
+    /// Returns number of indices (rows) in the table.
+    int nIndices() const { return m_num_indices; }
+
+    /// Returns number of functions (columns) in the table.
+    int nFunctions() const { return m_num_functions; }
+
+    /// Returns the first (minimum) index value in the table.
+    double minIndex() const { return m_low; }
+
+    /// Returns the last (maximum) index value in the table.
+    double maxIndex() const { return m_high; }
+
+    /// Returns the maximum error found at the interval midpoints.
+    double maxError() const { return m_error; }
+
+private:
+
+    /// Returns the transformed coordinate u(x).
+    double transform(const double x) const {
+        switch (m_coord) {
+            case LOG_COORDINATE:     return std::log(x);
+            case INVERSE_COORDINATE: return 1.0 / x;
+            default:                 return x;
+        }
+    }
+
+    /// Returns x(u).
+    double inverse(const double u) const {
+        switch (m_coord) {
+            case LOG_COORDINATE:     return std::exp(u);
+            case INVERSE_COORDINATE: return 1.0 / u;
+            default:                 return u;
+        }
+    }
+
+    /// Returns the index of row i, which may be fractional.
+    double index(const double i) const {
+        if (i <= 0.0) return m_low;
+        if (i >= m_num_indices-1) return m_high;
+        return inverse(m_u0 + i*m_du);
+    }
+
+    /// Sets up the grid and storage for nrows rows.
+    void initialize(int nrows) {
+        m_num_indices = std::max(nrows, 2);
+        m_u0 = transform(m_low);
+        m_du = (transform(m_high) - m_u0) / (m_num_indices-1);
+        m_inv_du = 1.0 / m_du;
+        m_data.assign(m_num_indices*m_num_functions, DataType(0));
+        m_slopes.assign(m_num_indices*m_num_functions, DataType(0));
+    }
+
+    /**
+     * Fills the table with nrows rows of the function, computes the slopes and
+     * the error at the interval midpoints.
+     */
+    void fill(
+        int nrows, const FunctionType& function,
+        const typename FunctionType::DataProvider& provider)
+    {
+        initialize(nrows);
+        for (int i = 0; i < m_num_indices; ++i)
+            function(index(i), &m_data[i*m_num_functions], provider);
+        computeSlopes();
+        m_error = checkError(function, provider);
+    }
+
+    /**
+     * Computes the slopes dF/du times the row spacing, with fourth order
+     * central differences inside, second order central differences next to
+     * the ends and one-sided second order differences at the ends.
+     */
+    void computeSlopes() {
+        const int n = m_num_indices, m = m_num_functions;
+        const DataType* const f = &m_data[0];
+        DataType* const d = &m_slopes[0];
+
+        if (n == 2) {
+            for (int k = 0; k < m; ++k)
+                d[k] = d[m+k] = f[m+k] - f[k];
+            return;
+        }
+
+        for (int k = 0; k < m; ++k) {
+            d[k] = 0.5*(-3.0*f[k] + 4.0*f[m+k] - f[2*m+k]);
+            d[(n-1)*m+k] =
+                0.5*(3.0*f[(n-1)*m+k] - 4.0*f[(n-2)*m+k] + f[(n-3)*m+k]);
+            d[m+k] = 0.5*(f[2*m+k] - f[k]);
+            d[(n-2)*m+k] = 0.5*(f[(n-1)*m+k] - f[(n-3)*m+k]);
+        }
+
+        for (int i = 2; i < n-2; ++i)
+            for (int k = 0; k < m; ++k)
+                d[i*m+k] = (8.0*(f[(i+1)*m+k] - f[(i-1)*m+k]) -
+                    (f[(i+2)*m+k] - f[(i-2)*m+k])) / 12.0;
+    }
+
+    /// Returns the maximum error at the midpoints of the row intervals.
+    double checkError(
+        const FunctionType& function,
+        const typename FunctionType::DataProvider& provider) const
+    {
+        std::vector<DataType> exact(m_num_functions), interp(m_num_functions);
+        double error, max_error = 0.0;
+
+        for (int i = 0; i < m_num_indices-1; ++i) {
+            const double x = index(i+0.5);
+            function(x, &exact[0], provider);
+            lookup(x, &interp[0]);
+
+            for (int k = 0; k < m_num_functions; ++k) {
+                if (std::abs(exact[k]) < static_cast<DataType>(1.0e-10))
+                    error = std::abs(interp[k]);
+                else
+                    error = std::abs(
+                        static_cast<double>(interp[k]/exact[k]) - 1.0);
+                max_error = std::max(max_error, error);
+            }
+        }
+
+        return max_error;
+    }
+
+private:
+
+    TableCoordinate m_coord;
+    int m_num_indices;
+    int m_num_functions;
+
+    double m_low;
+    double m_high;
+    double m_u0;
+    double m_du;
+    double m_inv_du;
+    double m_error;
+
+    std::vector<DataType> m_data;
+    std::vector<DataType> m_slopes;
+
+}; // class UniformLookupTable
+
     } // namespace Utilities
 } // namespace Mutation
 
 #endif // LOOKUPTABLE_H
-
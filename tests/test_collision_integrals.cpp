@@ -20,6 +20,10 @@
  */
 
 #include "mutation++.h"
+#include "Configuration.h"
+#include "TestMacros.h"
+#include "CoulombIntegrals.h"
+#include "Interpolators.h"
 #include <catch.hpp>
 #include <Eigen/Dense>
 
@@ -494,3 +498,181 @@ TEST_CASE("Test warning collision integrals", "[transport]")
     // Check that indeed the value is given
     CHECK(Q11->compute(1000.0) == 10.0);
 }
+
+/**
+ * Tests the adaptive log-T tabulation of collision groups.
+ */
+TEST_CASE("Test adaptive collision integral tables", "[transport]")
+{
+    // Generate a fake collision integral database
+    TemporaryFile file;
+    file << "<collisions>"
+         << "    <pair s1=\"N2\" s2=\"N2\">"
+         << "        <Q11 type=\"Bruno-Eq(19)\">"
+         << "            1.035291134e+1 -1.583011620e+0 1.245844036e+1"
+         << "           -2.328519000e-1  5.366285730e-2 -5.343729290e+0"
+         << "            9.355617520e+0 -2.154634270e+0 </Q11>"
+         << "    </pair>"
+         << "    <pair s1=\"N2\" s2=\"O2\">"
+         << "        <Q11 type=\"Bruno-Eq(19)\">"
+         << "            1.009959930e+1 -1.500683520e+0 1.254524872e+1"
+         << "           -7.295298680e-2  4.373012680e-2 -5.731668470e+0"
+         << "            9.097981790e+0 -2.132651270e+0 </Q11>"
+         << "    </pair>"
+         << "</collisions>";
+    file.close();
+
+    // Load the temporary collision database
+    XmlDocument doc(file.filename());
+
+    // Create the collision pairs
+    Species N2("N2");
+    Species O2("O2");
+    std::vector<CollisionPair> pairs;
+    pairs.push_back(CollisionPair(N2, N2, &(doc.root())));
+    pairs.push_back(CollisionPair(N2, O2, &(doc.root())));
+
+    // The thermodynamics is only needed to update the groups
+    Thermodynamics::Thermodynamics thermo("N2 O2", "RRHO", "ChemNonEq1T");
+
+    const double max_error = 1.0e-5;
+    const std::string kind = "Q11";
+
+    CollisionGroup adaptive(true, 300.0, 20000.0, 100.0, max_error);
+    adaptive.manage(pairs.begin(), pairs.end(), &CollisionPair::get, kind);
+
+    CollisionGroup uniform(true, 300.0, 20000.0, 100.0);
+    uniform.manage(pairs.begin(), pairs.end(), &CollisionPair::get, kind);
+
+    CHECK(adaptive.tableError() <= max_error);
+    CHECK(adaptive.tableSize() < uniform.tableSize());
+    CHECK(adaptive.tableBytes() > 0);
+    CHECK(uniform.tableError() > adaptive.tableError());
+
+    SharedPtr<CollisionIntegral> Q11a = pairs[0].get(kind);
+    SharedPtr<CollisionIntegral> Q11b = pairs[1].get(kind);
+
+    for (double T = 300.0; T <= 20000.0; T += 137.0) {
+        INFO("T = " << T);
+        adaptive.update(T, thermo);
+        CHECK(adaptive[0] == Approx(Q11a->compute(T)).epsilon(10.0*max_error));
+        CHECK(adaptive[1] == Approx(Q11b->compute(T)).epsilon(10.0*max_error));
+    }
+}
+
+/**
+ * Tests that the batched evaluation of the collision groups gives the same
+ * values as evaluating each integral on its own.
+ */
+TEST_CASE("Test batched collision integral evaluation", "[transport]")
+{
+    MIXTURE_LOOP
+    (
+        CollisionDB& db = mix.collisionDB();
+        const int k = (mix.hasElectrons() ? mix.nGas() : 0);
+
+        for (int it = 0; it < 5; ++it) {
+            double T = 500.0 + 3000.0*it;
+            double P = ONEATM;
+            mix.equilibrate(T, P);
+
+            const ArrayXd& Q11 = db.Q11ij();
+            const ArrayXd& Q22 = db.Q22ij();
+
+            for (int i = 0; i < Q11.size(); ++i) {
+                CollisionPair pair = db[k+i];
+                SharedPtr<CollisionIntegral> q11 = pair.get("Q11");
+                SharedPtr<CollisionIntegral> q22 = pair.get("Q22");
+                q11->getOtherParams(mix);
+                q22->getOtherParams(mix);
+                INFO(pair.name() << " at T = " << T);
+                CHECK(Q11(i) == Approx(q11->compute(mix.T())).epsilon(1.0e-12));
+                CHECK(Q22(i) == Approx(q22->compute(mix.T())).epsilon(1.0e-12));
+            }
+        }
+    );
+}
+
+/**
+ * Checks that the refined, cubic interpolated Debye-Huckel table reproduces a
+ * direct monotone cubic interpolation of the tabulated data, at and between
+ * the table points, and that both tables are clipped the same way beyond the
+ * ends of the table.
+ */
+TEST_CASE("Test cubic Debye-Huckel collision integrals", "[transport]")
+{
+    // Reduced temperatures of the table
+    const double tst[] = {
+        0.1, 0.2, 0.3, 0.4, 0.6, 0.8, 1.0, 2.0, 3.0, 4.0, 6.0, 8.0, 10.0, 20.0,
+        30.0, 40.0, 60.0, 80.0, 100.0, 200.0, 300.0, 400.0, 600.0, 800.0,
+        1.0e3, 1.0e4 };
+    const int n = sizeof(tst) / sizeof(double);
+
+    const CoulombType types[] = {
+        Q11_ATT, Q11_REP, Q22_ATT, Q22_REP, Q14_ATT, Q14_REP, Q15_ATT, Q15_REP,
+        Q24_ATT, Q24_REP, BST_ATT, BST_REP, CST_ATT, CST_REP, EST_ATT, EST_REP,
+        Q12_ATT, Q12_REP, Q13_ATT, Q13_REP, Q23_ATT, Q23_REP, AST_ATT, AST_REP };
+    const int nt = sizeof(types) / sizeof(CoulombType);
+
+    DebyeHuckleEvaluator linear(false);
+    DebyeHuckleEvaluator cubic(true);
+    linear.setDebyeLength(10000.0, 1.0e20);
+    cubic.setDebyeLength(10000.0, 1.0e20);
+
+    // Debye length and the temperature giving a reduced temperature T*
+    const double lambda = std::sqrt(0.5*EPS0*KB*10000.0/(1.0e20*QE*QE));
+    const double fac = QE*QE/(4.0*PI*EPS0*KB*lambda);
+
+    // Factor converting the tabulated (T*)^2*Q values to collision integrals
+    #define SCALE(t, j) ((j) < BST_ATT ? PI*lambda*lambda/((t)*(t)) : 1.0)
+
+    // Recover the table from the linear interpolation at the table points
+    // and interpolate it directly in ln(T*)
+    VectorXd x(n);
+    MatrixXd y(n, N_TABLE_TYPES);
+    for (int i = 0; i < n; ++i) {
+        x(i) = std::log(tst[i]);
+        for (int j = 0; j < N_TABLE_TYPES; ++j)
+            y(i,j) = linear(fac*tst[i], types[j]) / SCALE(tst[i], j);
+    }
+
+    std::vector<Numerics::MCHInterpolator<double> > mch;
+    for (int j = 0; j < N_TABLE_TYPES; ++j)
+        mch.push_back(Numerics::MCHInterpolator<double>(
+            Numerics::Interpolator<double>::ARGS(x.data(), &y(0,j), n)));
+
+    // The tolerance is the error of the linear interpolation of the refined
+    // table between its points
+    for (int i = 0; i < n; ++i) {
+        // At the table point, then half way in ln(T*) to the next one
+        for (int m = 0; m < 2; ++m) {
+            if (m == 1 && i == n-1) continue;
+            const double t = (m == 0 ? tst[i] : std::sqrt(tst[i]*tst[i+1]));
+            for (int j = 0; j < N_TABLE_TYPES; ++j) {
+                INFO("T* = " << t << ", type = " << types[j]);
+                CHECK(cubic(fac*t, types[j]) ==
+                    Approx(mch[j](std::log(t))*SCALE(t, j)).epsilon(1.0e-4));
+            }
+        }
+
+        // Derived integrals at the table points
+        for (int j = N_TABLE_TYPES; j < nt; ++j) {
+            INFO("T* = " << tst[i] << ", type = " << types[j]);
+            CHECK(cubic(fac*tst[i], types[j]) ==
+                Approx(linear(fac*tst[i], types[j])).epsilon(1.0e-3));
+        }
+    }
+
+    // Beyond the ends, both tables are clipped to the end values
+    const double ends[] = { 0.09, 0.1, 1.0e4, 1.1e4 };
+    for (int i = 0; i < 4; ++i) {
+        const double T = fac*ends[i];
+        for (int j = 0; j < nt; ++j) {
+            INFO("T* = " << ends[i] << ", type = " << types[j]);
+            CHECK(cubic(T, types[j]) ==
+                Approx(linear(T, types[j])).epsilon(1.0e-10));
+        }
+    }
+
+    #undef SCALE
+}
@@ -41,6 +41,12 @@ public:
      * diffusion matrix times species densities, sum to zero.
      */
     static void fluxesSumToZero(Mixture& mix);
+
+    /**
+     * Checks that diffusionFluxes() gives the same fluxes as the product of
+     * the diffusion matrix with the driving forces.
+     */
+    static void fusedFluxesMatchMatrix(Mixture& mix);
 };
 
 //==============================================================================
@@ -78,6 +84,25 @@ TEST_CASE("DiffusionMatrix yields diffusion fluxes which sum to zero",
 
 //==============================================================================
 
+TEST_CASE("diffusionFluxes matches the diffusion matrix product",
+    "[transport][DiffusionMatrix]"
+)
+{
+    MIXTURE_LOOP(
+        SECTION("Exact diffusion matrix") {
+            mix.setDiffusionMatrixAlgo("Exact");
+            DiffusionMatrixTests::fusedFluxesMatchMatrix(mix);
+        }
+
+        SECTION("Ramshaw diffusion matrix") {
+            mix.setDiffusionMatrixAlgo("Ramshaw");
+            DiffusionMatrixTests::fusedFluxesMatchMatrix(mix);
+        }
+    )
+}
+
+//==============================================================================
+
 void DiffusionMatrixTests::fluxesSumToZero(Mixture& mix)
 {
     const int ns = mix.nSpecies();
@@ -108,3 +133,27 @@ void DiffusionMatrixTests::fluxesSumToZero(Mixture& mix)
 
 //==============================================================================
 
+void DiffusionMatrixTests::fusedFluxesMatchMatrix(Mixture& mix)
+{
+    const int ns = mix.nSpecies();
+    VectorXd dx(ns);
+    VectorXd J1(ns);
+    VectorXd J2(ns);
+
+    EQUILIBRATE_LOOP(
+        mix.dXidT(dx.data());
+        dx *= 1.0 / dx.array().abs().maxCoeff();
+        dx[0] -= dx.sum();
+
+        J1 = -mix.diffusionMatrix() * dx;
+        J1.array() *= mix.density() * Map<const ArrayXd>(mix.Y(),ns);
+        mix.diffusionFluxes(dx.data(), J2.data());
+
+        INFO("J1 = " << J1.transpose() << "\nJ2 = " << J2.transpose());
+        const double scale = J1.cwiseAbs().maxCoeff();
+        for (int i = 0; i < ns; ++i)
+            CHECK(J2[i] == Approx(J1[i]).margin(1.0e-12*scale));
+    )
+}
+
+//==============================================================================
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "mutation++.h"
+#include "Configuration.h"
+#include "TestMacros.h"
+#include <catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace Mutation;
+using namespace Catch;
+
+/*
+ * Checks that a generated equilibrium transport table reproduces the nodes
+ * exactly, stays close to the exact properties between the nodes, and is
+ * unchanged by a save and load cycle.
+ */
+TEST_CASE("Equilibrium transport tables", "[transport]")
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    Mixture mix("air5_RRHO_ChemNonEq1T");
+    const int ne = mix.nElements();
+
+    const double tol = 1.0e-2;
+    EquilTransportTable table(
+        mix, 1000.0, 8000.0, 1000.0, 100000.0, tol, 8, 3, 8);
+
+    CHECK(table.nElements() == ne);
+    CHECK(table.nProperties() == 3 + (ne+1)*(ne+2));
+    CHECK(table.maxError() <= tol);
+    CHECK(table.temperatures().size() > 8);
+
+    std::vector<double> F(ne*(ne+1)), Fx(ne*(ne+1));
+
+    SECTION("Nodes are reproduced") {
+        const std::vector<double>& T = table.temperatures();
+        const std::vector<double>& lnP = table.logPressures();
+        for (size_t i = 0; i < T.size(); i += 3) {
+            const double P = std::exp(lnP[1]);
+            mix.equilibrate(T[i], P);
+            CHECK(table.viscosity(T[i], P) == Approx(mix.viscosity()));
+            CHECK(table.thermalConductivity(T[i], P) ==
+                Approx(mix.equilibriumThermalConductivity()));
+            table.diffFluxFacsT(T[i], P, F.data());
+            mix.equilDiffFluxFacsT(Fx.data());
+            for (int k = 0; k < ne+1; ++k)
+                CHECK(F[k] == Approx(Fx[k]));
+        }
+    }
+
+    SECTION("Properties between the nodes") {
+        for (double T = 1150.0; T < 8000.0; T += 700.0) {
+            for (double P = 2000.0; P < 100000.0; P *= 3.0) {
+                INFO("T = " << T << ", P = " << P);
+                mix.equilibrate(T, P);
+                CHECK(table.viscosity(T, P) ==
+                    Approx(mix.viscosity()).epsilon(tol));
+                CHECK(table.thermalConductivity(T, P) ==
+                    Approx(mix.equilibriumThermalConductivity()).epsilon(tol));
+
+                // Elemental flux factors are compared on the scale of the
+                // largest one
+                table.diffFluxFacsP(T, P, F.data());
+                mix.equilDiffFluxFacsP(Fx.data());
+                double scale = 0.0;
+                for (int k = 0; k < ne; ++k)
+                    scale = std::max(scale, std::abs(Fx[k]));
+                for (int k = 0; k < ne; ++k)
+                    CHECK(F[k] == Approx(Fx[k]).margin(tol*scale));
+            }
+        }
+    }
+
+    SECTION("Cell centres are within the tolerance") {
+        const std::vector<double>& T = table.temperatures();
+        const std::vector<double>& lnP = table.logPressures();
+        for (size_t i = 0; i+1 < T.size(); i += 2) {
+            for (size_t j = 0; j+1 < lnP.size(); ++j) {
+                const double Tm = 0.5*(T[i] + T[i+1]);
+                const double Pm = std::exp(0.5*(lnP[j] + lnP[j+1]));
+                INFO("T = " << Tm << ", P = " << Pm);
+                mix.equilibrate(Tm, Pm);
+                CHECK(table.viscosity(Tm, Pm) ==
+                    Approx(mix.viscosity()).epsilon(tol));
+                CHECK(table.thermalConductivity(Tm, Pm) ==
+                    Approx(mix.equilibriumThermalConductivity()).epsilon(tol));
+            }
+        }
+    }
+
+    SECTION("Save and load") {
+        // Keep the test file out of the working directory
+        const char* const dir = std::getenv("TMPDIR");
+        const std::string path =
+            std::string(dir ? dir : "/tmp") + "/equil_transport_table.tmp";
+        table.save(path);
+        EquilTransportTable loaded(path);
+        std::remove(path.c_str());
+
+        CHECK(loaded.nProperties() == table.nProperties());
+        CHECK(loaded.maxError() == table.maxError());
+        CHECK(loaded.temperatures() == table.temperatures());
+        CHECK(loaded.elementComposition() == table.elementComposition());
+
+        std::vector<double> a(table.nProperties()), b(table.nProperties());
+        for (double T = 900.0; T < 9000.0; T += 1234.5) {
+            table.interpolate(T, 5.0e4, 0, table.nProperties(), a.data());
+            loaded.interpolate(T, 5.0e4, 0, loaded.nProperties(), b.data());
+            CHECK(a == b);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * @file test_equilibrium_batch.cpp
+ *
+ * @brief Tests the BatchEquilSolver class.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "mutation++.h"
+#include "Configuration.h"
+#include "TestMacros.h"
+#include <catch.hpp>
+#include <Eigen/Dense>
+
+using namespace Mutation;
+using namespace Catch;
+using namespace Eigen;
+
+/*
+ * Equilibrating a batch of (T,P) states on several threads should give the
+ * same compositions as equilibrating each state in turn.
+ */
+TEST_CASE("Batch equilibrium matches serial equilibrium",
+    "[equilibrium][thermodynamics]"
+)
+{
+    const double tol = 1.0e-10;
+
+    MIXTURE_LOOP
+    (
+        const int ns = mix.nSpecies();
+        const int npts = 100;
+
+        MixtureOptions opts(_names_[i]);
+        Thermodynamics::BatchEquilSolver batch(
+            opts.getSpeciesDescriptor(), opts.getThermodynamicDatabase(), 3);
+        batch.setDefaultComposition(mix.getDefaultComposition());
+
+        // Store the states in reverse so that the batch has to reorder them
+        VectorXd T(npts);
+        VectorXd P(npts);
+        int k = npts;
+        for (int ip = 0; ip < 10; ++ip)
+            for (int it = 0; it < 10; ++it) {
+                P(--k) = std::exp(ip/9.0*std::log(100000.0)+std::log(10.0));
+                T(k)   = 1000.0*it + 1000.0;
+            }
+
+        MatrixXd X(ns, npts);
+        Thermodynamics::BatchEquilStats stats =
+            batch.equilibrate(npts, T.data(), P.data(), X.data());
+        CHECK(stats.n_points == npts);
+        CHECK(stats.n_failed == 0);
+
+        VectorXd Xs(ns);
+        int n_steps = 0;
+        for (k = 0; k < npts; ++k) {
+            INFO("T = " << T(k) << ", P = " << P(k));
+            n_steps += mix.equilibriumComposition(
+                T(k), P(k), Xs.data()).first;
+            CHECK(X.col(k).isApprox(Xs, tol));
+        }
+
+        // Warm starts from the neighbouring states never cost continuation
+        // steps (argon already needs about one step per state)
+        if (mix.equilSolver()->nPhases() == 1)
+            CHECK(stats.n_steps <= n_steps);
+    );
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_equilibrium_constrained.cpp
+ *
+ * @brief Tests the (h,P), (s,P) and (u,v) constrained equilibrium solutions.
+ */
+
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "mutation++.h"
+#include "Configuration.h"
+#include "TestMacros.h"
+#include <catch.hpp>
+#include <Eigen/Dense>
+
+using namespace Mutation;
+using namespace Catch;
+using namespace Eigen;
+
+/*
+ * Equilibrating the mixture with fixed (h,P), (s,P), or (u,v) taken from a
+ * fixed (T,P) equilibrium solution should recover the same temperature,
+ * pressure and composition.
+ */
+TEST_CASE("Constrained equilibrium recovers the fixed T-P solution",
+    "[equilibrium][thermodynamics]"
+)
+{
+    const double tol = 1.0e-6;
+
+    MIXTURE_LOOP
+    (
+        const int ns = mix.nSpecies();
+        VectorXd Xe(mix.nElements());
+        VectorXd X(ns);
+
+        EQUILIBRATE_LOOP
+        (
+            const double h = mix.mixtureHMass();
+            const double s = mix.mixtureSMass();
+            const double u = mix.mixtureEnergyMass();
+            const double v = 1.0 / mix.density();
+            const VectorXd Xeq = Map<const VectorXd>(mix.X(), ns);
+            mix.elementFractions(mix.X(), Xe.data());
+
+            double Tx = 0.8*T;
+            double Px = P;
+            mix.equilibriumCompositionHP(h, P, Xe.data(), X.data(), Tx);
+            CHECK(Tx == Approx(T).epsilon(tol));
+            CHECK((X - Xeq).lpNorm<Infinity>() == Approx(0.0).margin(tol));
+
+            Tx = 0.85*T;
+            mix.equilibriumCompositionSP(s, P, Xe.data(), X.data(), Tx);
+            CHECK(Tx == Approx(T).epsilon(tol));
+            CHECK((X - Xeq).lpNorm<Infinity>() == Approx(0.0).margin(tol));
+
+            Tx = 0.9*T;
+            Px = 1.5*P;
+            mix.equilibriumCompositionUV(u, v, Xe.data(), X.data(), Tx, Px);
+            CHECK(Tx == Approx(T).epsilon(tol));
+            CHECK(Px == Approx(P).epsilon(tol));
+            CHECK((X - Xeq).lpNorm<Infinity>() == Approx(0.0).margin(tol));
+        )
+    )
+}
+
+/*
+ * Setting the state of an equilibrium mixture from (P,h), (P,s) or
+ * (rho, rho e) taken from a (P,T) state should recover the same temperature,
+ * pressure and composition.
+ */
+TEST_CASE("Equilibrium state model constrained variable sets",
+    "[equilibrium][thermodynamics]"
+)
+{
+    const double tol = 1.0e-6;
+    const char* names[] = {
+        "air5_RRHO_ChemNonEq1T", "air11_NASA-9_ChemNonEq1T" };
+
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+
+    for (int m = 0; m < 2; ++m) {
+        MixtureOptions opts(names[m]);
+        opts.setStateModel("Equil");
+        Mixture mix(opts);
+        const int ns = mix.nSpecies();
+
+        for (int ip = 0; ip < 4; ++ip) {
+            for (int it = 0; it < 5; ++it) {
+                double P = 100.0*std::pow(10.0, ip);
+                double T = 2000.0*it + 1000.0;
+                INFO(names[m] << ", T = " << T << ", P = " << P);
+
+                mix.setState(&P, &T, 1);
+                double h = mix.mixtureHMass();
+                double s = mix.mixtureSMass();
+                double rho = mix.density();
+                double rhoe = rho*mix.mixtureEnergyMass();
+                const VectorXd X = Map<const VectorXd>(mix.X(), ns);
+
+                // Start each solution from a different state
+                double Tg = 0.8*T;
+                for (int vars = 3; vars <= 5; ++vars) {
+                    INFO("variable set " << vars);
+                    mix.setState(&P, &Tg, 1);
+
+                    if (vars == 3)
+                        mix.setState(&P, &h, 3);
+                    else if (vars == 4)
+                        mix.setState(&P, &s, 4);
+                    else
+                        mix.setState(&rho, &rhoe, 5);
+
+                    CHECK(mix.T() == Approx(T).epsilon(tol));
+                    CHECK(mix.P() == Approx(P).epsilon(tol));
+                    const VectorXd dX = Map<const VectorXd>(mix.X(), ns) - X;
+                    CHECK(dX.lpNorm<Infinity>() == Approx(0.0).margin(tol));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "mutation++.h"
+#include "Configuration.h"
+#include "TestMacros.h"
+#include <catch.hpp>
+#include <Eigen/Dense>
+#include <cmath>
+
+using namespace Mutation;
+using namespace Catch;
+using namespace Eigen;
+
+/*
+ * Solves the surface balances of a row of wall faces on several threads and
+ * checks that they match the solutions of each face in turn.  The edge
+ * conditions and the given wall temperatures vary smoothly along the wall.
+ * Returns the mass blowing rates of the faces in mdot.
+ */
+static void checkBatchSurfaceBalance(
+    const char* name, double Tw_min, double Tw_max, VectorXd& mdot)
+{
+    const double tol = 1.0e-8;
+    const int set_state_with_rhoi_T = 1;
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+
+    MixtureOptions opts(name);
+    Mixture mix(opts);
+    BatchSurfaceBalanceSolver batch(opts, 3);
+    CHECK(batch.nThreads() == 3);
+
+    const int ns = mix.nSpecies();
+    const int nT = mix.nEnergyEqns();
+    const bool energy = mix.solvesSurfaceEnergyBalance();
+    const int nfaces = 40;
+    const int iter = 100;
+    mix.setIterationsSurfaceBalance(iter);
+    batch.setIterationsSurfaceBalance(iter);
+
+    // Edge conditions and initial wall states varying smoothly along the wall,
+    // within the range where each face converges both from its own initial
+    // state and from the solution of its neighbour
+    MatrixXd xi_e(ns, nfaces), T_e(nT, nfaces), rhoi_w(ns, nfaces);
+    MatrixXd T_w(nT, nfaces);
+    VectorXd dx(nfaces);
+    for (int k = 0; k < nfaces; ++k) {
+        const double s = double(k)/(nfaces-1);
+        mix.equilibrate(3000.0 + 500.0*s, 100.0 + 400.0*s);
+        xi_e.col(k) = Map<const VectorXd>(mix.X(), ns);
+        T_e.col(k).setConstant(mix.T());
+        mix.densities(rhoi_w.col(k).data());
+        T_w.col(k).setConstant(Tw_min + (Tw_max - Tw_min)*s);
+        dx(k) = 1.0e-3;
+    }
+
+    // Serial solutions of each face from its own initial state
+    MatrixXd rhoi_s = rhoi_w, T_s = T_w;
+    VectorXd mdot_s(nfaces);
+    for (int k = 0; k < nfaces; ++k) {
+        mix.setDiffusionModel(xi_e.col(k).data(), dx(k));
+        if (energy)
+            mix.setGasFourierHeatFluxModel(T_e.col(k).data(), dx(k));
+        mix.setSurfaceState(
+            rhoi_s.col(k).data(), T_s.col(k).data(), set_state_with_rhoi_T);
+        mix.solveSurfaceBalance();
+        CHECK(mix.surfaceBalanceConverged());
+        mix.getSurfaceState(
+            rhoi_s.col(k).data(), T_s.col(k).data(), set_state_with_rhoi_T);
+        mix.getMassBlowingRate(mdot_s(k));
+    }
+
+    for (int seed = 0; seed < 2; ++seed) {
+        INFO("seed = " << seed);
+        MatrixXd rhoi_b = rhoi_w, T_b = T_w;
+        VectorXd mdot_b(nfaces);
+
+        BatchSurfaceBalanceStats stats = batch.solveSurfaceBalance(
+            nfaces, xi_e.data(), T_e.data(), dx.data(), rhoi_b.data(),
+            T_b.data(), mdot_b.data(), seed == 1);
+        CHECK(stats.n_faces == nfaces);
+        CHECK(stats.n_failed == 0);
+        CHECK(stats.failed.empty());
+
+        // Only the first face of each chunk is not seeded
+        CHECK(stats.n_seeded == (seed == 1 ? nfaces - 4*batch.nThreads() : 0));
+
+        // Imposed wall temperatures are never taken from the neighbours
+        if (!energy)
+            CHECK(T_b == T_w);
+
+        for (int k = 0; k < nfaces; ++k) {
+            INFO("face " << k);
+            CHECK(rhoi_b.col(k).isApprox(rhoi_s.col(k), tol));
+            CHECK(T_b.col(k).isApprox(T_s.col(k), tol));
+            CHECK(mdot_b(k) == Approx(mdot_s(k)).margin(1.0e-14));
+        }
+    }
+
+    mdot = mdot_s;
+}
+
+/*
+ * Solving the surface balances of a row of wall faces on several threads
+ * should give the same states as solving each face in turn.
+ */
+TEST_CASE("Batch surface balance matches serial surface balance", "[gsi]")
+{
+    VectorXd mdot;
+
+    SECTION("Catalysis") {
+        checkBatchSurfaceBalance(
+            "seb_catalysis_NASA9_ChemNonEq1T", 1800.0, 1800.0, mdot);
+    }
+
+    SECTION("Ablation") {
+        checkBatchSurfaceBalance(
+            "seb_aircarbon11_ablation_NASA9_ChemNonEqTTv", 1800.0, 1800.0,
+            mdot);
+        CHECK((mdot.array() < 0.0).all());
+    }
+
+    SECTION("Mass balance only") {
+        checkBatchSurfaceBalance(
+            "smb_oxidation_NASA9_ChemNonEq1T", 1000.0, 1500.0, mdot);
+        CHECK((mdot.array() < 0.0).all());
+    }
+}
+
+/*
+ * Faces which do not converge within the allowed iterations are reported as
+ * failed and keep their given wall states.
+ */
+TEST_CASE("Batch surface balance reports unconverged faces", "[gsi]")
+{
+    const int set_state_with_rhoi_T = 1;
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+
+    MixtureOptions opts("seb_aircarbon11_ablation_NASA9_ChemNonEqTTv");
+    Mixture mix(opts);
+    BatchSurfaceBalanceSolver batch(opts, 2);
+
+    const int ns = mix.nSpecies();
+    const int nT = mix.nEnergyEqns();
+    const int nfaces = 8;
+    mix.setIterationsSurfaceBalance(1);
+    batch.setIterationsSurfaceBalance(1);
+
+    mix.equilibrate(3000.0, 100.0);
+    MatrixXd xi_e(ns, nfaces), T_e(nT, nfaces), rhoi_w(ns, nfaces);
+    MatrixXd T_w(nT, nfaces);
+    VectorXd dx = VectorXd::Constant(nfaces, 1.0e-3), mdot(nfaces);
+    for (int k = 0; k < nfaces; ++k) {
+        xi_e.col(k) = Map<const VectorXd>(mix.X(), ns);
+        T_e.col(k).setConstant(mix.T());
+        mix.densities(rhoi_w.col(k).data());
+        T_w.col(k).setConstant(1800.0);
+    }
+
+    // A single iteration does not solve the balance from the edge state
+    mix.setDiffusionModel(xi_e.col(0).data(), dx(0));
+    mix.setGasFourierHeatFluxModel(T_e.col(0).data(), dx(0));
+    mix.setSurfaceState(
+        rhoi_w.col(0).data(), T_w.col(0).data(), set_state_with_rhoi_T);
+    mix.solveSurfaceBalance();
+    REQUIRE(!mix.surfaceBalanceConverged());
+
+    MatrixXd rhoi_b = rhoi_w, T_b = T_w;
+    BatchSurfaceBalanceStats stats = batch.solveSurfaceBalance(
+        nfaces, xi_e.data(), T_e.data(), dx.data(), rhoi_b.data(),
+        T_b.data(), mdot.data());
+    CHECK(stats.n_faces == nfaces);
+    CHECK(stats.n_failed == nfaces);
+    CHECK(stats.n_seeded == 0);
+    REQUIRE(int(stats.failed.size()) == nfaces);
+    for (int k = 0; k < nfaces; ++k) {
+        CHECK(stats.failed[k] == k);
+        CHECK(std::isnan(mdot(k)));
+    }
+    CHECK(rhoi_b == rhoi_w);
+    CHECK(T_b == T_w);
+}
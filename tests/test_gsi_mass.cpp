@@ -100,3 +100,124 @@ TEST_CASE("Solution of the MassBalanceSolver is converged.",
         CHECK(err == Approx(0.0).epsilon(tol));
     )
 }
+
+TEST_CASE("MassBalanceSolver converges within the default iterations",
+    "[gsi]"
+)
+{
+    MIXTURE_GSI_MASS_LOOP
+    (
+        const size_t set_state_with_rhoi_T = 1;
+        size_t ns = mix.nSpecies();
+        size_t nT = mix.nEnergyEqns();
+
+        mix.equilibrate(3000., 100.);
+        VectorXd rhoi_s(ns);
+        mix.densities(rhoi_s.data());
+        VectorXd xi_e = Map<const VectorXd>(mix.X(), ns);
+        double dx = 1.;
+
+        for (double Tw = 500.; Tw < 2001.; Tw += 500.) {
+            // Solve from the edge state with the default number of iterations
+            VectorXd rhoi = rhoi_s;
+            VectorXd T_s = VectorXd::Constant(nT, Tw);
+            mix.setSurfaceState(rhoi.data(), T_s.data(), set_state_with_rhoi_T);
+            mix.setDiffusionModel(xi_e.data(), dx);
+            mix.solveSurfaceBalance();
+            mix.getSurfaceState(rhoi.data(), T_s.data(), set_state_with_rhoi_T);
+
+            // Residual of the balance relative to the largest flux
+            mix.setState(rhoi.data(), T_s.data(), set_state_with_rhoi_T);
+            VectorXd dxidx = (Map<const VectorXd>(mix.X(), ns) - xi_e) / dx;
+            VectorXd vdi(ns);
+            double E = 0.;
+            mix.stefanMaxwell(dxidx.data(), vdi.data(), E);
+
+            VectorXd wdot(ns);
+            mix.setSurfaceState(rhoi.data(), T_s.data(), set_state_with_rhoi_T);
+            mix.surfaceReactionRates(wdot.data());
+            double mblow;
+            mix.getMassBlowingRate(mblow);
+
+            VectorXd J = rhoi.cwiseProduct(vdi);
+            VectorXd F = (rhoi/rhoi.sum())*mblow + J - wdot;
+            double scale =
+                J.lpNorm<Infinity>() + wdot.lpNorm<Infinity>() + 1.e-300;
+
+            CHECK(F.lpNorm<Infinity>() / scale < 1.e-8);
+        }
+    )
+}
+
+/**
+ * Returns the residuals of the surface mass balance at the wall mole fractions
+ * X, computed through the mixture at the wall temperature and pressure.
+ */
+VectorXd surfaceMassBalance(
+    Mixture& mix, const VectorXd& xi_e, const double dx, const VectorXd& X,
+    VectorXd& T, const double P)
+{
+    const int ns = mix.nSpecies();
+    VectorXd rhoi = X.cwiseProduct(mix.speciesMw().matrix())*P/(RU*T(0));
+
+    mix.setState(rhoi.data(), T.data(), 1);
+    VectorXd dxidx = (X - xi_e)/dx;
+    VectorXd vdi(ns);
+    double E = 0.;
+    mix.stefanMaxwell(dxidx.data(), vdi.data(), E);
+
+    VectorXd wdot(ns);
+    mix.setSurfaceState(rhoi.data(), T.data(), 1);
+    mix.surfaceReactionRates(wdot.data());
+    double mblow;
+    mix.getMassBlowingRate(mblow);
+
+    return (rhoi/rhoi.sum())*mblow + rhoi.cwiseProduct(vdi) - wdot;
+}
+
+/**
+ * Checks the Jacobian of the surface mass balance, which combines the
+ * Stefan-Maxwell, surface rate and blowing flux Jacobians, against central
+ * differences at wall states away from the solution of the balance.
+ */
+TEST_CASE("MassBalanceSolver Jacobian matches finite differences",
+    "[gsi]"
+)
+{
+    MIXTURE_GSI_MASS_LOOP
+    (
+        const int ns = mix.nSpecies();
+        const int nT = mix.nEnergyEqns();
+        const double P = 1000.;
+        const double dx = 1.e-3;
+
+        mix.equilibrate(3000., P);
+        VectorXd xi_e = Map<const VectorXd>(mix.X(), ns);
+        mix.setDiffusionModel(xi_e.data(), dx);
+
+        // Wall composition away from the edge and from the solution
+        VectorXd X = 0.7*xi_e + 0.2*VectorXd::LinSpaced(ns, 1., 2.)/(1.5*ns) +
+            VectorXd::Constant(ns, 0.1/ns);
+        VectorXd rhoi(ns);
+        MatrixXd jac(ns, ns);
+
+        for (double Tw = 1000.; Tw < 2001.; Tw += 1000.) {
+            INFO("Tw = " << Tw);
+            VectorXd T_s = VectorXd::Constant(nT, Tw);
+            rhoi = X.cwiseProduct(mix.speciesMw().matrix())*P/(RU*Tw);
+            mix.setSurfaceState(rhoi.data(), T_s.data(), 1);
+            mix.surfaceBalanceJacobian(jac.data());
+
+            // Perturb the mole fractions at constant temperature and pressure,
+            // keeping their sum equal to one
+            VectorXd u = (X.array()*ArrayXd::LinSpaced(ns, 1., 2.)).matrix();
+            u -= u.sum()*X;
+            const double h = 1.e-6;
+
+            const VectorXd fd = (
+                surfaceMassBalance(mix, xi_e, dx, X + h*u, T_s, P) -
+                surfaceMassBalance(mix, xi_e, dx, X - h*u, T_s, P))/(2.*h);
+            CHECK((jac*u - fd).norm() <= 1.e-6*fd.norm());
+        }
+    )
+}
@@ -406,3 +406,102 @@ TEST_CASE("Solution of the MassEnergyBalanceSolver is converged.", "[gsi]")
         CHECK(err == Approx(0.0).margin(tol));
     }
 }
+
+/**
+ * Returns the residuals of the surface mass and energy balances at the wall
+ * mole fractions X, computed through the mixture at the wall temperature and
+ * pressure.  The radiative heat flux does not depend on the composition, and
+ * is left out.
+ */
+VectorXd surfaceMassEnergyBalance(
+    Mixture& mix, const VectorXd& xi_e, const VectorXd& T_e, const double dx,
+    const VectorXd& X, VectorXd& T, const double P)
+{
+    const int ns = mix.nSpecies();
+    const int nT = mix.nEnergyEqns();
+    VectorXd rhoi = X.cwiseProduct(mix.speciesMw().matrix())*P/(RU*T(0));
+
+    mix.setState(rhoi.data(), T.data(), 1);
+    VectorXd dxidx = (X - xi_e)/dx;
+    VectorXd vdi(ns);
+    double E = 0.;
+    mix.stefanMaxwell(dxidx.data(), vdi.data(), E);
+
+    VectorXd lambda(nT);
+    mix.frozenThermalConductivityVector(lambda.data());
+    VectorXd v_hi(ns*nT);
+    mix.getEnthalpiesMass(v_hi.data());
+    const double hmix = mix.mixtureHMass();
+
+    VectorXd wdot(ns);
+    mix.setSurfaceState(rhoi.data(), T.data(), 1);
+    mix.surfaceReactionRates(wdot.data());
+    double mblow;
+    mix.getMassBlowingRate(mblow);
+
+    VectorXd F(ns+1);
+    F.head(ns) = (rhoi/rhoi.sum())*mblow + rhoi.cwiseProduct(vdi) - wdot;
+    F(ns) = v_hi.head(ns).dot(rhoi.cwiseProduct(vdi)) -
+        lambda.dot(T - T_e)/dx + hmix*mblow;
+    return F;
+}
+
+/**
+ * Checks the composition columns of the Jacobian of the surface mass and
+ * energy balances against central differences at wall states away from the
+ * solution of the balances.  The temperature column is itself a forward
+ * difference.
+ */
+TEST_CASE("MassEnergyBalanceSolver Jacobian matches finite differences",
+    "[gsi]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    const char* names[] = {
+        "seb_catalysis_NASA9_ChemNonEq1T",
+        "seb_oxidation_NASA9_ChemNonEq1T",
+        "seb_aircarbon11_ablation_NASA9_ChemNonEqTTv" };
+
+    for (int m = 0; m < 3; ++m) {
+        Mixture mix(names[m]);
+        const int ns = mix.nSpecies();
+        const int nT = mix.nEnergyEqns();
+        const double P = 1000.;
+        const double dx = 1.e-3;
+
+        mix.equilibrate(3000., P);
+        VectorXd xi_e = Map<const VectorXd>(mix.X(), ns);
+        VectorXd T_e = VectorXd::Constant(nT, 3000.);
+        mix.setDiffusionModel(xi_e.data(), dx);
+        mix.setGasFourierHeatFluxModel(T_e.data(), dx);
+
+        // Wall composition away from the edge and from the solution
+        VectorXd X = 0.7*xi_e + 0.2*VectorXd::LinSpaced(ns, 1., 2.)/(1.5*ns) +
+            VectorXd::Constant(ns, 0.1/ns);
+        VectorXd rhoi(ns);
+        MatrixXd jac(ns+1, ns+1);
+
+        for (double Tw = 1500.; Tw < 2501.; Tw += 1000.) {
+            INFO(names[m] << ", Tw = " << Tw);
+            VectorXd T_s = VectorXd::Constant(nT, Tw);
+            rhoi = X.cwiseProduct(mix.speciesMw().matrix())*P/(RU*Tw);
+            mix.setSurfaceState(rhoi.data(), T_s.data(), 1);
+            mix.surfaceBalanceJacobian(jac.data());
+
+            // Perturb the mole fractions at constant temperature and pressure,
+            // keeping their sum equal to one
+            VectorXd u = (X.array()*ArrayXd::LinSpaced(ns, 1., 2.)).matrix();
+            u -= u.sum()*X;
+            const double h = 1.e-6;
+
+            const VectorXd fd = (
+                surfaceMassEnergyBalance(mix, xi_e, T_e, dx, X + h*u, T_s, P) -
+                surfaceMassEnergyBalance(mix, xi_e, T_e, dx, X - h*u, T_s, P))/
+                (2.*h);
+            const VectorXd ju = jac.leftCols(ns)*u;
+            CHECK((ju.head(ns) - fd.head(ns)).norm() <=
+                1.e-6*fd.head(ns).norm());
+            CHECK(std::abs(ju(ns) - fd(ns)) <= 1.e-5*std::abs(fd(ns)));
+        }
+    }
+}
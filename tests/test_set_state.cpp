@@ -95,3 +95,113 @@ TEST_CASE("setState converts rho*Em to Tm and vice a versa",
     )
 }
 
+
+/*
+ * Checks that the energy equation is solved from explicit temperature guesses,
+ * one cell at a time and in batches.
+ */
+TEST_CASE("Temperatures from energy densities with explicit guesses",
+        "[thermodynamics]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    Mixture mix("air11_RRHO_ChemNonEq1T");
+    const int ns = mix.nSpecies();
+    const int n = 20;
+
+    ArrayXXd rhoi(ns, n);
+    ArrayXd rhoe(n), T(n), guess(n);
+
+    for (int c = 0; c < n; ++c) {
+        T(c) = 300.0 + 750.0*c;
+        mix.equilibrate(T(c), 0.1*ONEATM);
+        rhoi.col(c) = mix.density() * Map<const ArrayXd>(mix.Y(), ns);
+        mix.mixtureEnergies(&rhoe(c));
+        rhoe(c) *= mix.density();
+    }
+
+    // One cell at a time, starting from guesses far from the solution
+    double Tc;
+    for (int c = 0; c < n; ++c) {
+        const double T0 = (c % 2 == 0 ? 0.3 : 3.0)*T(c);
+        mix.setState(&rhoi(0,c), &rhoe(c), 0, &T0);
+        mix.getTemperatures(&Tc);
+        CHECK(Tc == Approx(T(c)).epsilon(1.0e-10));
+    }
+
+    // All cells together
+    guess.setConstant(1000.0);
+    CHECK(mix.getTFromRhoE(n, rhoi.data(), rhoe.data(), guess.data()) == 0);
+    for (int c = 0; c < n; ++c)
+        CHECK(guess(c) == Approx(T(c)).epsilon(1.0e-10));
+}
+
+/*
+ * Temperature guesses are only hints, so a state model which does not use them
+ * should accept and ignore them.
+ */
+TEST_CASE("Temperature guesses are ignored by models that do not use them",
+        "[thermodynamics]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    MixtureOptions opts("air5_RRHO_ChemNonEq1T");
+    opts.setStateModel("Equil");
+    Mixture mix(opts);
+
+    const double P = ONEATM, T = 3000.0, guess = 1000.0;
+    mix.setState(&P, &T, 1, &guess);
+    CHECK(mix.T() == Approx(T));
+    CHECK(mix.P() == Approx(P));
+}
+
+/*
+ * Checks the two-temperature energy inversion from explicit guesses, its
+ * convergence information, and the batched variant.
+ */
+TEST_CASE("Two-temperature energy inversion with explicit guesses",
+        "[thermodynamics]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    Mixture mix("air11_RRHO_ChemNonEqTTv");
+    const int ns = mix.nSpecies();
+    const int n = 12;
+
+    ArrayXXd rhoi(ns, n), rhoe(2, n), T(2, n), guess(2, n), Tc(2, 1);
+
+    for (int c = 0; c < n; ++c) {
+        mix.equilibrate(1000.0*c + 500.0, ONEATM);
+        rhoi.col(c) = mix.density() * Map<const ArrayXd>(mix.Y(), ns);
+
+        T(0,c) = 1200.0*c + 300.0;
+        T(1,c) = 900.0*(n-c) + 300.0;
+        mix.setState(&rhoi(0,c), &T(0,c), 1);
+        mix.mixtureEnergies(&rhoe(0,c));
+        rhoe.col(c) *= mix.density();
+    }
+
+    // One cell at a time, from guesses away from the solution
+    for (int c = 0; c < n; ++c) {
+        guess.col(c) = 0.5*T.col(c) + 2000.0;
+        mix.setState(&rhoi(0,c), &rhoe(0,c), 0, &guess(0,c));
+        CHECK(mix.energySolveStats().converged);
+        CHECK(mix.energySolveStats().iterations < 20);
+
+        mix.getTemperatures(Tc.data());
+        CHECK(Tc(0) == Approx(T(0,c)).epsilon(1.0e-10));
+        CHECK(Tc(1) == Approx(T(1,c)).epsilon(1.0e-10));
+    }
+
+    // All cells together.  The residual norm is dominated by the total
+    // energy, so that Tv is less accurate than T.
+    std::vector<Thermodynamics::EnergySolveStats> stats(n);
+    guess.setConstant(5000.0);
+    CHECK(mix.batchSolveEnergies(
+        n, rhoi.data(), rhoe.data(), guess.data(), &stats[0]) == 0);
+    for (int c = 0; c < n; ++c) {
+        CHECK(stats[c].converged);
+        CHECK(guess(0,c) == Approx(T(0,c)).epsilon(1.0e-10));
+        CHECK(guess(1,c) == Approx(T(1,c)).epsilon(1.0e-8));
+    }
+}
@@ -91,3 +91,100 @@ TEST_CASE("stefanMaxwell yields zero net conduction current",
     )
 }
 
+
+TEST_CASE("Iterative stefanMaxwell solver matches the direct solver",
+    "[transport]"
+)
+{
+    MIXTURE_LOOP
+    (
+        VectorXd dp(mix.nSpecies());
+        VectorXd V1(mix.nSpecies());
+        VectorXd V2(mix.nSpecies());
+
+        EQUILIBRATE_LOOP
+        (
+            mix.dXidT(dp.data());
+            dp *= 1.0 / dp.array().abs().maxCoeff();
+            dp[0] -= dp.sum();
+
+            // Direct solution
+            mix.setStefanMaxwellTolerance(0.0);
+            double E1; mix.stefanMaxwell(dp.data(), V1.data(), E1);
+            CHECK(mix.stefanMaxwellIterations() == 0);
+
+            // Iterative solution, cold and then warm started
+            mix.setStefanMaxwellTolerance(1.0e-12, 200);
+            double E2; mix.stefanMaxwell(dp.data(), V2.data(), E2);
+            int cold = mix.stefanMaxwellIterations();
+            CHECK(cold > 0);
+
+            // Compare the mass fluxes since the velocities of trace species
+            // are not resolved by the direct solution of the unscaled system,
+            // which also breaks down when the electrons are only traces
+            Map<const ArrayXd> Y(mix.Y(), mix.nSpecies());
+            VectorXd J1 = (Y*V1.array()).matrix();
+            VectorXd J2 = (Y*V2.array()).matrix();
+            if (!mix.hasElectrons() || mix.X()[0] > 1.0e-10) {
+                CHECK((J2-J1).norm() <= 1.0e-6*J1.norm() + 1.0e-12);
+                CHECK(E2 == Approx(E1).epsilon(1.0e-4).margin(1.0e-10));
+            }
+
+            mix.stefanMaxwell(dp.data(), V2.data(), E2);
+            CHECK(mix.stefanMaxwellIterations() > 0);
+            CHECK(mix.stefanMaxwellIterations() <= cold);
+        )
+    )
+}
+
+TEST_CASE("stefanMaxwellJacobian matches finite differences",
+    "[transport]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    const char* names[] = {"air5_RRHO_ChemNonEq1T", "air11_RRHO_ChemNonEq1T"};
+
+    for (int m = 0; m < 2; ++m) {
+        Mixture mix(names[m]);
+        const int ns = mix.nSpecies();
+        const Map<const ArrayXd> Mw(mix.speciesMw().data(), ns);
+
+        VectorXd dp(ns), V(ns), Vp(ns), Vm(ns), rhoi(ns);
+        MatrixXd dVdd(ns,ns), dVdX(ns,ns);
+
+        for (double T = 4000.0; T < 12001.0; T += 4000.0) {
+            mix.equilibrate(T, ONEATM);
+            mix.dXidT(dp.data());
+            dp *= 1.0 / dp.array().abs().maxCoeff();
+            dp[0] -= dp.sum();
+
+            const VectorXd X = Map<const VectorXd>(mix.X(), ns);
+            mix.stefanMaxwellJacobian(dp.data(), dVdd.data(), dVdX.data());
+
+            // The velocities are linear in the driving forces
+            double E; mix.stefanMaxwell(dp.data(), V.data(), E);
+            const Map<const ArrayXd> Y(mix.Y(), ns);
+            const double scale = (Y*V.array()).matrix().norm();
+            CHECK(((Y*(dVdd*dp - V).array()).matrix().norm()) <=
+                1.0e-8*scale);
+
+            // Perturb the mole fractions at constant temperature and pressure,
+            // keeping their sum equal to one
+            VectorXd u = (X.array()*(ArrayXd::LinSpaced(ns, 1.0, 2.0))).matrix();
+            u -= u.sum()*X;
+            const double h = 1.0e-5;
+
+            rhoi = ((X + h*u).array()*Mw*ONEATM/(RU*T)).matrix();
+            mix.setState(rhoi.data(), &T, 1);
+            mix.stefanMaxwell(dp.data(), Vp.data(), E);
+
+            rhoi = ((X - h*u).array()*Mw*ONEATM/(RU*T)).matrix();
+            mix.setState(rhoi.data(), &T, 1);
+            mix.stefanMaxwell(dp.data(), Vm.data(), E);
+
+            const VectorXd fd = (Vp - Vm)/(2.0*h);
+            CHECK(((Y*(dVdX*u - fd).array()).matrix().norm()) <=
+                1.0e-7*(Y*fd.array()).matrix().norm() + 1.0e-12*scale);
+        }
+    }
+}
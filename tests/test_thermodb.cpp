@@ -246,4 +246,136 @@ TEST_CASE("Loading RRHO thermodynamic database", "[thermodynamics][loading]")
     checkThermoDBLoad(db, DEFAULTS | AIR5);
 }
 
+/**
+ * Checks that the tabulated internal energy contributions of the RRHO database
+ * match the exact ones, in thermal equilibrium and nonequilibrium.
+ */
+TEST_CASE("Tabulated RRHO internal energy contributions",
+    "[thermodynamics]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    Mixture mix("air11_RRHO_ChemNonEq1T");
+    ThermoDB* db = mix.thermoDB();
+    const int ns = mix.nSpecies();
+    const double P = ONEATM;
+
+    ArrayXd cp(ns), h(ns), s(ns), cpv(ns), hv(ns), sv(ns), cpel(ns), hel(ns),
+        sel(ns), cp_tab(ns), h_tab(ns), s_tab(ns), cpv_tab(ns), hv_tab(ns),
+        sv_tab(ns), cpel_tab(ns), hel_tab(ns), sel_tab(ns);
+
+    // Switching the internal energy tables off restores the default
+    // properties, which interpolate the electronic Boltzmann factors
+    db->cp(5000.0, 5000.0, 5000.0, 4000.0, 4000.0, cp.data());
+    db->useInternalEnergyTables(true, 1.0e-6);
+    db->useInternalEnergyTables(false);
+    db->cp(5000.0, 5000.0, 5000.0, 4000.0, 4000.0, cp_tab.data());
+    CHECK((cp_tab == cp).all());
+
+    // Exact Boltzmann factors, so that the tables are checked against the
+    // exact properties
+    db->useBoltzmannTable(false);
+
+    for (int i = 0; i < 20; ++i) {
+        const double T = 300.0 + 1500.0*i;
+        const double Tv = (i % 2 == 0 ? T : 0.5*T + 100.0);
+
+        db->useInternalEnergyTables(false);
+        db->cp(T, T, T, Tv, Tv, cp.data(), NULL, NULL, cpv.data(),
+            cpel.data());
+        db->enthalpy(T, T, T, Tv, Tv, h.data(), NULL, NULL, hv.data(),
+            hel.data(), NULL);
+        db->entropy(T, T, T, Tv, Tv, P, s.data(), NULL, NULL, sv.data(),
+            sel.data());
+
+        db->useInternalEnergyTables(true, 1.0e-6);
+        db->cp(T, T, T, Tv, Tv, cp_tab.data(), NULL, NULL, cpv_tab.data(),
+            cpel_tab.data());
+        db->enthalpy(T, T, T, Tv, Tv, h_tab.data(), NULL, NULL, hv_tab.data(),
+            hel_tab.data(), NULL);
+        db->entropy(T, T, T, Tv, Tv, P, s_tab.data(), NULL, NULL,
+            sv_tab.data(), sel_tab.data());
+
+        for (int k = 0; k < ns; ++k) {
+            CHECK(cp_tab(k) == Approx(cp(k)).epsilon(1.0e-6));
+            CHECK(h_tab(k) == Approx(h(k)).epsilon(1.0e-6));
+            CHECK(s_tab(k) == Approx(s(k)).epsilon(1.0e-6));
+            CHECK(cpv_tab(k) == Approx(cpv(k)).epsilon(1.0e-6).margin(1.0e-9));
+            CHECK(hv_tab(k) == Approx(hv(k)).epsilon(1.0e-6).margin(1.0e-9));
+            CHECK(sv_tab(k) == Approx(sv(k)).epsilon(1.0e-6).margin(1.0e-9));
+            CHECK(cpel_tab(k) ==
+                Approx(cpel(k)).epsilon(1.0e-6).margin(1.0e-9));
+            CHECK(hel_tab(k) == Approx(hel(k)).epsilon(1.0e-6).margin(1.0e-9));
+            CHECK(sel_tab(k) == Approx(sel(k)).epsilon(1.0e-6).margin(1.0e-9));
+        }
+
+        // The total properties only go through the shared lookups
+        db->cp(T, T, T, Tv, Tv, cp_tab.data());
+        db->enthalpy(T, T, T, Tv, Tv, h_tab.data(), NULL, NULL, NULL, NULL,
+            NULL);
+        for (int k = 0; k < ns; ++k) {
+            CHECK(cp_tab(k) == Approx(cp(k)).epsilon(1.0e-6));
+            CHECK(h_tab(k) == Approx(h(k)).epsilon(1.0e-6));
+        }
+    }
+
+    db->useInternalEnergyTables(false);
+    db->useBoltzmannTable(true);
+}
+
+/**
+ * Checks that the combined and batched evaluations of the species specific
+ * heats and enthalpies match the separate ones for every database.
+ */
+TEST_CASE("Combined species cp and enthalpy evaluations",
+    "[thermodynamics]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    const char* mixtures[] = {
+        "air11_RRHO_ChemNonEq1T", "air11_NASA-7_ChemNonEq1T",
+        "air11_NASA-9_ChemNonEq1T" };
+    const int n = 20;
+
+    for (int m = 0; m < 3; ++m) {
+        Mixture mix(mixtures[m]);
+        ThermoDB* db = mix.thermoDB();
+        const int ns = mix.nSpecies();
+
+        ArrayXd T(n);
+        for (int k = 0; k < n; ++k)
+            T(k) = 200.0 + 1500.0*k;
 
+        ArrayXXd cp(ns, n), h(ns, n), cp_b(ns, n), h_b(ns, n);
+        ArrayXd cp_c(ns), h_c(ns);
+
+        // Only the RRHO database tabulates its internal energy contributions
+        const bool rrho = (m == 0);
+        for (int tables = 0; tables < (rrho ? 2 : 1); ++tables) {
+            INFO(mixtures[m] << ", tables = " << tables);
+            if (rrho) db->useInternalEnergyTables(tables == 1, 1.0e-6);
+
+            for (int k = 0; k < n; ++k) {
+                db->cp(T(k), T(k), T(k), T(k), T(k), &cp(0,k));
+                db->enthalpy(T(k), T(k), T(k), T(k), T(k), &h(0,k), NULL,
+                    NULL, NULL, NULL, NULL);
+
+                db->cpAndEnthalpy(T(k), cp_c.data(), h_c.data());
+                for (int i = 0; i < ns; ++i) {
+                    CHECK(cp_c(i) == Approx(cp(i,k)).epsilon(1.0e-10));
+                    CHECK(h_c(i) == Approx(h(i,k)).epsilon(1.0e-10));
+                }
+            }
+
+            db->batchCpAndEnthalpy(n, T.data(), cp_b.data(), h_b.data());
+            for (int k = 0; k < n; ++k) {
+                for (int i = 0; i < ns; ++i) {
+                    CHECK(cp_b(i,k) == Approx(cp(i,k)).epsilon(1.0e-10));
+                    CHECK(h_b(i,k) == Approx(h(i,k)).epsilon(1.0e-10));
+                }
+            }
+        }
+
+        if (rrho) db->useInternalEnergyTables(false);
+    }
+}
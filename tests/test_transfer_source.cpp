@@ -22,6 +22,7 @@
 #include "mutation++.h"
 #include "Configuration.h"
 #include "TestMacros.h"
+#include "MillikanWhite.h"
 #include <catch.hpp>
 #include <Eigen/Dense>
 
@@ -74,3 +75,243 @@ TEST_CASE("Energy transfer source terms are zero in equilibrium",
     )
 }
 
+
+/*
+ * Checks the vectorized VT source term against a direct evaluation of the
+ * Millikan-White relaxation times with Park's correction, pair by pair.
+ */
+TEST_CASE("VT source term matches the pairwise Millikan-White model",
+    "[transfer]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    Mixture mix("air11_RRHO_ChemNonEqTTv");
+
+    const int ns = mix.nSpecies();
+    const int offset = mix.hasElectrons() ? 1 : 0;
+    MillikanWhite mw(mix);
+    TransferModel* p_omega =
+        Utilities::Config::Factory<TransferModel>::create("OmegaVT", mix);
+
+    VectorXd rhoi(ns), hv(ns), hveq(ns);
+    for (int i = 0; i < ns; ++i)
+        rhoi(i) = 0.01*(i+1);
+
+    const double temps [][2] = {
+        {1000.0, 3000.0}, {8000.0, 2000.0}, {15000.0, 6000.0}, {30000.0, 9000.0}
+    };
+
+    for (int k = 0; k < 4; ++k) {
+        mix.setState(rhoi.data(), temps[k], 1);
+        const double T = mix.T(), P = mix.P(), rho = mix.density();
+        const double* p_Y = mix.Y();
+
+        mix.speciesHOverRT(T, T, T, T, T, NULL, NULL, NULL, hveq.data(), NULL, NULL);
+        mix.speciesHOverRT(T, mix.Tv(), T, mix.Tv(), mix.Tv(), NULL, NULL, NULL, hv.data(), NULL, NULL);
+
+        const double sigma_T = (T > 20000.0 ? 6.25 : 2.5e9/(T*T));
+        double src = 0.0;
+        for (int v = 0; v < mw.nVibrators(); ++v) {
+            double sum1 = 0.0, sum2 = 0.0;
+            for (int j = offset; j < ns; ++j) {
+                const MillikanWhitePartner& p = mw[v][j-offset];
+                const double tau =
+                    std::exp(p.a()*(std::pow(T, -1.0/3.0) - p.b()) - 18.421)*ONEATM/P +
+                    std::sqrt(PI*KB/(8.0*NA))*std::sqrt(p.mu()*T)/(mw[v].omega()*sigma_T*P);
+                sum1 += p_Y[j]/mix.speciesMw(j);
+                sum2 += p_Y[j]/(mix.speciesMw(j)*tau);
+            }
+            const int i = mw[v].index();
+            src += p_Y[i]*rho*RU*T/mix.speciesMw(i)*(hveq(i)-hv(i))*sum2/sum1;
+        }
+
+        CHECK(p_omega->source() == Approx(src).epsilon(1.0e-12));
+    }
+
+    delete p_omega;
+}
+
+/*
+ * Checks the analytic Jacobians of the energy transfer source terms against
+ * central finite differences of the source terms in a two-temperature state.
+ */
+TEST_CASE("Energy transfer Jacobians match finite differences",
+    "[transfer]"
+)
+{
+    const std::string transfer_terms [] = {
+        "OmegaCE", "OmegaCElec", "OmegaCV", "OmegaET", "OmegaI", "OmegaVT"
+    };
+
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    Mixture mix("air11_RRHO_ChemNonEqTTv");
+
+    // Exact Boltzmann factors, so that the specific heats are the exact
+    // derivatives of the enthalpies
+    mix.thermoDB()->useBoltzmannTable(false);
+
+    const int ns = mix.nSpecies();
+    VectorXd rhoi(ns), rhop(ns), jac(ns+2), total(ns+2), scale(ns+2);
+    const double temps [][2] = {{8000.0, 4000.0}, {12000.0, 15000.0}};
+
+    for (int k = 0; k < 2; ++k) {
+        for (int i = 0; i < ns; ++i)
+            rhoi(i) = 1.0e-3*(i+1);
+        rhoi(0) = 1.0e-8;
+        total.setZero();
+        scale.setZero();
+
+        for (int m = 0; m < 6; ++m) {
+            INFO(transfer_terms[m] << " at T = " << temps[k][0]);
+            TransferModel* p_omega =
+                Utilities::Config::Factory<TransferModel>::create(
+                    transfer_terms[m], mix);
+
+            mix.setState(rhoi.data(), temps[k], 1);
+            p_omega->jacobian(jac.data());
+            total += jac;
+            scale += jac.cwiseAbs();
+
+            // Species densities (the electron density of OmegaET is checked
+            // below)
+            for (int i = 0; i < ns; ++i) {
+                if (transfer_terms[m] == "OmegaET" && i == 0)
+                    continue;
+                const double h = 1.0e-6*rhoi(i);
+                rhop = rhoi; rhop(i) += h;
+                mix.setState(rhop.data(), temps[k], 1);
+                const double fp = p_omega->source();
+                rhop(i) -= 2.0*h;
+                mix.setState(rhop.data(), temps[k], 1);
+                const double fm = p_omega->source();
+                CHECK(jac(i)*rhoi(i) ==
+                    Approx((fp-fm)/(2.0*h)*rhoi(i)).epsilon(1.0e-5).margin(
+                        1.0e-6*jac.head(ns).cwiseProduct(rhoi).cwiseAbs().maxCoeff()));
+            }
+
+            // Temperatures
+            for (int t = 0; t < 2; ++t) {
+                double tp [2] = {temps[k][0], temps[k][1]};
+                const double h = 1.0e-6*tp[t];
+                tp[t] += h;
+                mix.setState(rhoi.data(), tp, 1);
+                const double fp = p_omega->source();
+                tp[t] -= 2.0*h;
+                mix.setState(rhoi.data(), tp, 1);
+                const double fm = p_omega->source();
+                CHECK(jac(ns+t) == Approx((fp-fm)/(2.0*h)).epsilon(1.0e-5));
+            }
+
+            delete p_omega;
+        }
+
+        // The state model sums the terms into the vibrational energy equation
+        VectorXd omega_jac(ns+2);
+        mix.setState(rhoi.data(), temps[k], 1);
+        mix.energyTransferJacobian(omega_jac.data());
+        for (int i = 0; i < ns+2; ++i)
+            CHECK(omega_jac(i) == Approx(total(i)).margin(1.0e-12*scale(i)));
+    }
+
+    // The electron density also enters OmegaET through the Debye length of
+    // the electron-ion collision integrals.  These are only updated when the
+    // Debye length changes by more than 1e-10 m, so the steps are larger than
+    // above and the central differences are extrapolated.
+    TransferModel* p_omega =
+        Utilities::Config::Factory<TransferModel>::create("OmegaET", mix);
+    for (int i = 0; i < ns; ++i)
+        rhoi(i) = 1.0e-3*(i+1);
+    rhoi(0) = 1.0e-8;
+
+    for (int k = 0; k < 2; ++k) {
+        mix.setState(rhoi.data(), temps[k], 1);
+        p_omega->jacobian(jac.data());
+
+        double fd [2];
+        for (int j = 0; j < 2; ++j) {
+            const double h = 1.0e-2*(j+1)*rhoi(0);
+            rhop = rhoi; rhop(0) += h;
+            mix.setState(rhop.data(), temps[k], 1);
+            const double fp = p_omega->source();
+            rhop(0) -= 2.0*h;
+            mix.setState(rhop.data(), temps[k], 1);
+            const double fm = p_omega->source();
+            fd[j] = (fp-fm)/(2.0*h);
+        }
+        CHECK(jac(0) == Approx((4.0*fd[0] - fd[1])/3.0).epsilon(1.0e-5));
+    }
+
+    // Without ions, the electron-heavy collision integrals do not depend on
+    // the Debye length
+    for (int i = 1; i < ns; ++i)
+        rhoi(i) = (mix.species(i).charge() == 0 ? 1.0e-3*(i+1) : 0.0);
+    rhoi(0) = 1.0e-8;
+
+    double tp [2] = {8000.0, 4000.0};
+    mix.setState(rhoi.data(), tp, 1);
+    p_omega->jacobian(jac.data());
+
+    const double h = 1.0e-6*tp[1];
+    tp[1] += h;
+    mix.setState(rhoi.data(), tp, 1);
+    const double fp = p_omega->source();
+    tp[1] -= 2.0*h;
+    mix.setState(rhoi.data(), tp, 1);
+    const double fm = p_omega->source();
+    // The derivatives of tabulated collision integrals are differences
+    CHECK(jac(ns+1) == Approx((fp-fm)/(2.0*h)).epsilon(1.0e-4));
+
+    delete p_omega;
+}
+
+/*
+ * Checks that the fused evaluation of the source terms with a shared context,
+ * with and without given production rates, matches the individual terms.
+ */
+TEST_CASE("Energy transfer source terms share one context per state",
+    "[transfer]"
+)
+{
+    const std::string transfer_terms [] = {
+        "OmegaVT", "OmegaCV", "OmegaCElec", "OmegaET", "OmegaCE", "OmegaI"
+    };
+
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    Mixture mix("air11_RRHO_ChemNonEqTTv");
+
+    const int ns = mix.nSpecies();
+    VectorXd rhoi(ns), wdot(ns);
+    for (int i = 0; i < ns; ++i)
+        rhoi(i) = 1.0e-3*(i+1);
+
+    std::vector<TransferModel*> models;
+    for (int m = 0; m < 6; ++m)
+        models.push_back(Utilities::Config::Factory<TransferModel>::create(
+            transfer_terms[m], mix));
+
+    const double temps [][2] = {
+        {8000.0, 4000.0}, {12000.0, 15000.0}, {3000.0, 3000.0}
+    };
+
+    for (int k = 0; k < 3; ++k) {
+        mix.setState(rhoi.data(), temps[k], 1);
+
+        double sum = 0.0, scale = 0.0;
+        for (int m = 0; m < 6; ++m) {
+            const double src = models[m]->source();
+            sum += src;
+            scale += std::abs(src);
+        }
+
+        double omega, omega_wdot;
+        mix.energyTransferSource(&omega);
+        CHECK(omega == Approx(sum).margin(1.0e-12*scale));
+
+        mix.netProductionRates(wdot.data());
+        mix.energyTransferSource(&omega_wdot, wdot.data());
+        CHECK(omega_wdot == Approx(omega).margin(1.0e-12*scale));
+    }
+
+    for (int m = 0; m < 6; ++m)
+        delete models[m];
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "mutation++.h"
+#include "Configuration.h"
+#include "TestMacros.h"
+#include <catch.hpp>
+
+using namespace Mutation;
+using namespace Mutation::Transport;
+using namespace Catch;
+
+/*
+ * Checks that the "Auto" viscosity and thermal conductivity stay within their
+ * tolerance of the Chapmann-Enskog values over a range of equilibrium air
+ * states, and that every evaluation is counted on exactly one path.
+ */
+TEST_CASE("Auto transport algorithms respect their tolerance",
+    "[transport]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+
+    MixtureOptions opts("air11_RRHO_ChemNonEq1T");
+    Mixture ce(opts);
+    opts.setViscosityAlgorithm("Auto");
+    opts.setThermalConductivityAlgorithm("Auto");
+    Mixture mix(opts);
+
+    const double tol = 0.1;
+    mix.setAutoTransportTolerance(tol);
+
+    AutoTransportCounts visc, lambda;
+    int n = 0;
+
+    for (double P = 0.01*ONEATM; P <= ONEATM; P *= 10.0) {
+        for (double T = 300.0; T <= 15000.0; T += 100.0, ++n) {
+            ce.equilibrate(T, P);
+            mix.equilibrate(T, P);
+
+            INFO("T = " << T << ", P = " << P);
+            CHECK(mix.viscosity() == Approx(ce.viscosity()).epsilon(tol));
+            CHECK(mix.heavyThermalConductivity() ==
+                Approx(ce.heavyThermalConductivity()).epsilon(tol));
+        }
+    }
+
+    mix.autoTransportCounts(visc, lambda);
+    CHECK(visc.n_cheap + visc.n_full == n);
+    CHECK(lambda.n_cheap + lambda.n_full == n);
+    CHECK(visc.n_audit <= visc.n_full);
+    CHECK(lambda.n_audit <= lambda.n_full);
+
+    // The neutral states are within 10% with the mixture rule
+    CHECK(visc.n_cheap > 0);
+    CHECK(lambda.n_cheap > 0);
+
+    // A zero tolerance always escalates
+    mix.setAutoTransportTolerance(0.0);
+    mix.resetAutoTransportCounts();
+    for (double T = 1000.0; T <= 10000.0; T += 1000.0) {
+        ce.equilibrate(T, ONEATM);
+        mix.equilibrate(T, ONEATM);
+        CHECK(mix.viscosity() == Approx(ce.viscosity()).epsilon(1.0e-12));
+        CHECK(mix.heavyThermalConductivity() ==
+            Approx(ce.heavyThermalConductivity()).epsilon(1.0e-12));
+    }
+
+    mix.autoTransportCounts(visc, lambda);
+    CHECK(visc.n_cheap == 0);
+    CHECK(visc.n_full == 10);
+    CHECK(lambda.n_cheap == 0);
+    CHECK(lambda.n_full == 10);
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "mutation++.h"
+#include "Configuration.h"
+#include "TestMacros.h"
+#include <catch.hpp>
+#include <Eigen/Dense>
+
+using namespace Mutation;
+using namespace Mutation::Transport;
+using namespace Catch;
+using namespace Eigen;
+
+/*
+ * Checks that the properties computed by computeAll() with shared
+ * factorizations match the ones computed individually, and that a second
+ * call at the same state reuses every factorization.
+ */
+TEST_CASE("computeAll matches the individual transport properties",
+    "[transport]"
+)
+{
+    const unsigned int flags =
+        VISCOSITY | HEAVY_THERMAL_CONDUCTIVITY | THERMAL_DIFFUSION_RATIOS |
+        SORET_THERMAL_CONDUCTIVITY;
+
+    MIXTURE_LOOP
+    (
+        VectorXd rhoi(mix.nSpecies());
+        VectorXd tmps(mix.nEnergyEqns());
+        VectorXd k_Ti(mix.nSpecies());
+        TransportProperties props;
+
+        rhoi.setConstant(0.1);
+
+        for (int i = 0; i < 10; ++i) {
+            tmps.setConstant(1000.0*i + 500.0);
+            mix.setState(rhoi.data(), tmps.data(), 1);
+
+            mix.computeAll(flags, props);
+            CHECK(props.factorized == HEAVY_LAMBDA_SYSTEM);
+            CHECK(props.reused == 0);
+
+            CHECK(props.viscosity == Approx(mix.viscosity()));
+            CHECK(props.lambda_h ==
+                Approx(mix.heavyThermalConductivity()).epsilon(1.0e-10));
+            CHECK(props.lambda_soret ==
+                Approx(mix.soretThermalConductivity()).epsilon(1.0e-8));
+
+            mix.heavyThermalDiffusionRatios(k_Ti.data());
+            for (int j = 0; j < mix.nSpecies(); ++j)
+                CHECK(props.k_Ti(j) ==
+                    Approx(k_Ti(j)).epsilon(1.0e-8).margin(1.0e-14));
+
+            // Nothing is factorized again at the same state
+            mix.computeAll(flags, props);
+            CHECK(props.factorized == 0);
+            CHECK(props.reused == HEAVY_LAMBDA_SYSTEM);
+        }
+    )
+}
+
+/*
+ * Checks that computeAll() uses the system of the selected thermal
+ * conductivity algorithm, and that algorithms without one report no system.
+ */
+TEST_CASE("computeAll uses the selected thermal conductivity algorithm",
+    "[transport]"
+)
+{
+    const unsigned int flags =
+        HEAVY_THERMAL_CONDUCTIVITY | THERMAL_DIFFUSION_RATIOS;
+
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    Mixture mix("air11_RRHO_ChemNonEq1T");
+    TransportProperties props;
+    VectorXd k_Ti(mix.nSpecies());
+
+    const char* algos[] = { "Chapmann-Enskog_CG", "Wilke" };
+    for (int a = 0; a < 2; ++a) {
+        INFO(algos[a]);
+        mix.setThermalConductivityAlgo(algos[a]);
+
+        for (int i = 0; i < 3; ++i) {
+            mix.equilibrate(3000.0*i + 2000.0, ONEATM);
+
+            mix.computeAll(flags, props);
+            CHECK(props.factorized == (a == 0 ? HEAVY_LAMBDA_SYSTEM : 0));
+            CHECK(props.reused == 0);
+            CHECK(props.lambda_h == mix.heavyThermalConductivity());
+
+            mix.heavyThermalDiffusionRatios(k_Ti.data());
+            CHECK(props.k_Ti.matrix().isApprox(k_Ti));
+        }
+    }
+}
+
+/*
+ * Checks that the Butler-Brokaw system is factorized once per state.
+ */
+TEST_CASE("computeAll reuses the Butler-Brokaw factorization",
+    "[transport]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    Mixture mix("air5_RRHO_ChemNonEq1T");
+    TransportProperties props;
+
+    for (int i = 0; i < 5; ++i) {
+        mix.equilibrate(2000.0*i + 1000.0, ONEATM);
+
+        mix.computeAll(BUTLER_BROKAW_CONDUCTIVITY, props);
+        CHECK(props.factorized == BUTLER_BROKAW_SYSTEM);
+        CHECK(props.reused == 0);
+        CHECK(props.lambda_bb == Approx(mix.butlerBrokawThermalConductivity()));
+
+        mix.computeAll(BUTLER_BROKAW_CONDUCTIVITY, props);
+        CHECK(props.factorized == 0);
+        CHECK(props.reused == BUTLER_BROKAW_SYSTEM);
+    }
+}
+
+/*
+ * Checks the electron properties computed together against the individual
+ * functions and against the uncached electron systems of the collision
+ * database, while the state and the magnetic field change.
+ */
+TEST_CASE("electronProperties matches the individual electron properties",
+    "[transport]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+    Mixture mix("air11_RRHO_ChemNonEq1T");
+    ElectronTransportProperties props;
+
+    for (int i = 0; i < 5; ++i) {
+        mix.equilibrate(2000.0*i + 6000.0, ONEATM);
+        mix.setBField(0.5*i);
+
+        for (int order = 2; order <= 3; ++order) {
+            mix.electronProperties(props, order, true);
+
+            CHECK(props.sigma == Approx(mix.electricConductivity(order)));
+            CHECK(props.lambda_e ==
+                Approx(mix.electronThermalConductivity(order)));
+            CHECK(props.D_e == Approx(mix.electronDiffusionCoefficient(order)));
+            CHECK(props.k_Te ==
+                Approx(mix.electronThermalDiffusionRatio(order)));
+
+            const Vector3d sigma_B = mix.electricConductivityB(order);
+            const Vector3d lambda_B = mix.electronThermalConductivityB(order);
+            const Vector3d k_Te_B = mix.electronThermalDiffusionRatioB(order);
+            for (int j = 0; j < 3; ++j) {
+                CHECK(props.sigma_B(j) == Approx(sigma_B(j)));
+                CHECK(props.lambda_e_B(j) == Approx(lambda_B(j)));
+                CHECK(props.k_Te_B(j) == Approx(k_Te_B(j)));
+            }
+        }
+
+        CollisionDB& collisions = mix.collisionDB();
+        const std::complex<double> De = collisions.L2inv<3>()(0,0);
+        CHECK(props.D_e == Approx(collisions.L1inv<3>()(0,0)));
+        CHECK(props.D_e_B(0) == Approx(props.D_e));
+        CHECK(props.D_e_B(1) == Approx(De.real()));
+        CHECK(props.D_e_B(2) == Approx(De.imag()).margin(1.0e-20));
+    }
+}
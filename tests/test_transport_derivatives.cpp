@@ -0,0 +1,118 @@
+/*
+ * Copyright 2014-2020 von Karman Institute for Fluid Dynamics (VKI)
+ *
+ * This file is part of MUlticomponent Thermodynamic And Transport
+ * properties for IONized gases in C++ (Mutation++) software package.
+ *
+ * Mutation++ is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * Mutation++ is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with Mutation++.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "mutation++.h"
+#include "Configuration.h"
+#include "TestMacros.h"
+#include <catch.hpp>
+#include <Eigen/Dense>
+
+using namespace Mutation;
+using namespace Catch;
+using namespace Eigen;
+
+/*
+ * Checks the analytic temperature and mole fraction derivatives of the
+ * viscosity and heavy thermal conductivity against central differences, for
+ * every algorithm which provides them.  The mole fraction derivatives are
+ * checked along directions which keep the mole fractions normalized.
+ */
+TEST_CASE("Analytic transport derivatives match finite differences",
+    "[transport]"
+)
+{
+    Mutation::GlobalOptions::workingDirectory(TEST_DATA_FOLDER);
+
+    const char* mixtures[] = {
+        "air5_RRHO_ChemNonEq1T", "air5_RRHO_ChemNonEq1T_CG",
+        "air5_RRHO_ChemNonEq1T_Wilke", "air5_RRHO_ChemNonEq1T_Gupta-Yos"
+    };
+
+    // Temperatures away from the breakpoints of tabulated integrals
+    const double temperatures[] = { 1234.5, 3456.7, 6789.1, 9876.5 };
+
+    // Species pairs along which the composition is perturbed (N2-O2, NO-N2)
+    const int pairs[][2] = { {3, 4}, {2, 3} };
+
+    for (int m = 0; m < 4; ++m) {
+        INFO("mixture = " << mixtures[m]);
+        Mixture mix(mixtures[m]);
+        const int ns = mix.nSpecies();
+
+        VectorXd Y(ns), Yp(ns), Ym(ns), Xp(ns), Xm(ns);
+        VectorXd dmu_dx(ns), dlam_dx(ns);
+        double PT[2], dmu_dT, dlam_dT;
+
+        for (int t = 0; t < 4; ++t) {
+            const double T = temperatures[t];
+            INFO("T = " << T);
+
+            mix.equilibrate(T, ONEATM);
+            Y = Map<const VectorXd>(mix.Y(), ns);
+            PT[0] = ONEATM; PT[1] = T;
+            mix.setState(Y.data(), PT, 2);
+
+            const double mu = mix.viscosityDerivatives(dmu_dT, dmu_dx.data());
+            const double lam =
+                mix.heavyThermalConductivityDerivatives(dlam_dT, dlam_dx.data());
+            CHECK(mu == Approx(mix.viscosity()));
+            CHECK(lam == Approx(mix.heavyThermalConductivity()));
+
+            // Temperature derivatives
+            const double h = 1.0e-6*T;
+            PT[1] = T + h;
+            mix.setState(Y.data(), PT, 2);
+            double mu_p  = mix.viscosity();
+            double lam_p = mix.heavyThermalConductivity();
+            PT[1] = T - h;
+            mix.setState(Y.data(), PT, 2);
+            double mu_m  = mix.viscosity();
+            double lam_m = mix.heavyThermalConductivity();
+            PT[1] = T;
+
+            CHECK(dmu_dT == Approx((mu_p-mu_m)/(2.0*h)).epsilon(1.0e-5));
+            CHECK(dlam_dT == Approx((lam_p-lam_m)/(2.0*h)).epsilon(1.0e-5));
+
+            // Mole fraction derivatives
+            for (int p = 0; p < 2; ++p) {
+                const int i = pairs[p][0], j = pairs[p][1];
+                const double d = 1.0e-4*std::min(Y(i), Y(j));
+
+                Yp = Y; Yp(i) += d; Yp(j) -= d;
+                mix.setState(Yp.data(), PT, 2);
+                Xp = Map<const VectorXd>(mix.X(), ns);
+                mu_p  = mix.viscosity();
+                lam_p = mix.heavyThermalConductivity();
+
+                Ym = Y; Ym(i) -= d; Ym(j) += d;
+                mix.setState(Ym.data(), PT, 2);
+                Xm = Map<const VectorXd>(mix.X(), ns);
+                mu_m  = mix.viscosity();
+                lam_m = mix.heavyThermalConductivity();
+
+                CHECK(dmu_dx.dot(Xp-Xm) ==
+                    Approx(mu_p-mu_m).epsilon(1.0e-5).margin(1.0e-16*mu));
+                CHECK(dlam_dx.dot(Xp-Xm) ==
+                    Approx(lam_p-lam_m).epsilon(1.0e-5).margin(1.0e-16*lam));
+            }
+        }
+    }
+}
@@ -230,3 +230,66 @@ TEST_CASE("XML classes", "[utilities]")
 
 }
 
+
+/**
+ * Electronic Boltzmann factor sums of the oxygen atom, as tabulated by RrhoDB.
+ */
+struct OxygenLevels { };
+
+class BoltzmannFactors
+{
+public:
+    typedef OxygenLevels DataProvider;
+
+    void operator () (double T, double* p_f, const DataProvider&) const {
+        const double g[] = { 5.0, 3.0, 1.0, 5.0, 1.0 };
+        const double theta[] = { 0.0, 227.7, 326.6, 22830.0, 48619.0 };
+        p_f[0] = p_f[1] = p_f[2] = 0.0;
+        for (int i = 0; i < 5; ++i) {
+            const double fac = g[i]*std::exp(-theta[i]/T);
+            p_f[0] += fac;
+            p_f[1] += fac*theta[i];
+            p_f[2] += fac*theta[i]*theta[i];
+        }
+    }
+};
+
+/**
+ * Tests that the uniform lookup tables hold their error between the rows, and
+ * that in ln(T) they reach the error of the linear LookupTable with far fewer
+ * rows.
+ */
+TEST_CASE("Uniform lookup tables", "[utilities]")
+{
+    OxygenLevels levels;
+    const double tol = 1.0e-4;
+
+    LookupTable<double, double, BoltzmannFactors> linear(
+        50.0, 50000.0, 3, levels, tol);
+
+    TableCoordinate coords[] = { LOG_COORDINATE, INVERSE_COORDINATE };
+    for (int c = 0; c < 2; ++c) {
+        UniformLookupTable<double, BoltzmannFactors> table(
+            50.0, 50000.0, 3, levels, tol, coords[c]);
+
+        INFO("coordinate = " << coords[c]);
+        CHECK(table.maxError() <= tol);
+        if (coords[c] == LOG_COORDINATE)
+            CHECK(2*table.nIndices() < linear.nIndices());
+
+        double exact[3], interp[3];
+        for (double T = 50.0; T <= 50000.0; T *= 1.01) {
+            BoltzmannFactors()(T, exact, levels);
+            table.lookup(T, interp);
+            for (int k = 0; k < 3; ++k)
+                CHECK(interp[k] == Approx(exact[k]).epsilon(2.0*tol));
+        }
+
+        // Exact at the ends, clipped beyond them
+        BoltzmannFactors()(50.0, exact, levels);
+        table.lookup(10.0, interp);
+        CHECK(interp[0] == Approx(exact[0]));
+        table.lookup(50.0, interp);
+        CHECK(interp[2] == Approx(exact[2]));
+    }
+}